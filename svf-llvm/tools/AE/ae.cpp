@@ -51,6 +51,71 @@ static Option<bool> AETEST(
     false
 );
 
+static Option<bool> AEPROGTEST(
+    "aeprogtest",
+    "abstract execution test on a built-in program (also to be run with -use-sparse and with -ae-summary-limit)",
+    false
+);
+
+/// Checked by its svf_assert calls. The second call to inc has the same entry values as
+/// the first, so it applies the summary of the first one (if summaries are enabled). The
+/// loop carries t through a phi after its head, so t is defined in the body and left out
+/// of sparse head states: the loop must not reach its fixpoint before t does, or t == 10
+/// becomes unreachable. Nor may widening s at the head overwrite the definition of s2 in
+/// the body, or narrowing cannot bound s to 100.
+static const char* aeTestProgram = R"(
+declare void @svf_assert(i1 zeroext)
+
+define i32 @inc(i32 %x) {
+entry:
+  %r = add nsw i32 %x, 1
+  ret i32 %r
+}
+
+define i32 @main() {
+entry:
+  %a = call i32 @inc(i32 1)
+  %b = call i32 @inc(i32 1)
+  %ab = add nsw i32 %a, %b
+  %four = icmp eq i32 %ab, 4
+  call void @svf_assert(i1 zeroext %four)
+  br label %head
+
+head:
+  %s = phi i32 [ 0, %entry ], [ %s2, %latch ]
+  %t = phi i32 [ 0, %entry ], [ %t3, %latch ]
+  %c = icmp slt i32 %s, 100
+  br i1 %c, label %body, label %exit
+
+body:
+  %s2 = add nsw i32 %s, 1
+  %lt = icmp slt i32 %t, 10
+  br i1 %lt, label %inc, label %latch
+
+inc:
+  %t2 = add nsw i32 %t, 2
+  br label %latch
+
+latch:
+  %t3 = phi i32 [ %t2, %inc ], [ %t, %body ]
+  br label %head
+
+exit:
+  %hundred = icmp eq i32 %s, 100
+  call void @svf_assert(i1 zeroext %hundred)
+  %ten = icmp eq i32 %t, 10
+  br i1 %ten, label %reached, label %done
+
+reached:
+  %e = icmp eq i32 %t, 10
+  call void @svf_assert(i1 zeroext %e)
+  br label %done
+
+done:
+  ret i32 0
+}
+)";
+
 class SymblicAbstractionTest
 {
 public:
@@ -875,7 +940,18 @@ int main(int argc, char** argv)
         return 0;
     }
 
-    LLVMModuleSet::getLLVMModuleSet()->buildSVFModule(moduleNameVec);
+    std::unique_ptr<llvm::LLVMContext> testContext;
+    std::unique_ptr<llvm::Module> testModule;
+    if (AEPROGTEST())
+    {
+        testContext = std::make_unique<llvm::LLVMContext>();
+        llvm::SMDiagnostic err;
+        testModule = llvm::parseIR(llvm::MemoryBufferRef(aeTestProgram, "aeprogtest"), err, *testContext);
+        assert(testModule && "cannot parse the test program?");
+        LLVMModuleSet::buildSVFModule(*testModule);
+    }
+    else
+        LLVMModuleSet::getLLVMModuleSet()->buildSVFModule(moduleNameVec);
     SVFIRBuilder builder;
     SVFIR* pag = builder.build();
     AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
@@ -888,9 +964,14 @@ int main(int argc, char** argv)
     if (Options::NullDerefCheck())
         ae.addDetector(std::make_unique<NullptrDerefDetector>());
     ae.runOnModule(pag->getICFG());
+    // checked in release builds too, as the svf_assert calls of the program are
+    bool summaryMissed = AEPROGTEST() && Options::AESummaryLimit() != 0 && !Options::UseSparseState() &&
+                         ae.getCalleeSummaryHits() != 1;
+    if (summaryMissed)
+        SVFUtil::errs() << SVFUtil::errMsg("The second call to inc did not apply the summary of the first!") << "\n";
 
     AndersenWaveDiff::releaseAndersenWaveDiff();
     LLVMModuleSet::releaseLLVMModuleSet();
 
-    return 0;
+    return summaryMissed ? 1 : 0;
 }
\ No newline at end of file
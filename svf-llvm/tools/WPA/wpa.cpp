@@ -29,14 +29,133 @@
 #include "SVF-LLVM/LLVMUtil.h"
 #include "SVF-LLVM/SVFIRBuilder.h"
 #include "WPA/WPAPass.h"
+#include "WPA/Andersen.h"
 #include "Util/CommandLine.h"
 #include "Util/Options.h"
+#include "Util/ThreadPool.h"
 
 
 using namespace llvm;
 using namespace std;
 using namespace SVF;
 
+static Option<bool> ALIASCACHETEST(
+    "alias-cache-test",
+    "check that batched alias results follow incremental constraint changes",
+    false
+);
+
+/// Batch-query pointers which do not alias, add and then remove copy constraints
+/// between them, and check every re-query against the uncached alias results.
+/// Returns false on a stale result, or a NoAlias despite the copy constraints.
+static bool testAliasCache(SVFIR* pag)
+{
+    AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
+
+    std::vector<NodeID> ptrs;
+    for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        if (pag->isValidTopLevelPtr(it->second) && !ander->getPts(it->first).empty())
+            ptrs.push_back(it->first);
+    }
+    std::vector<NodePair> queries;
+    for (u32_t i = 0; i < ptrs.size() && queries.size() < 64; ++i)
+    {
+        for (u32_t j = i + 1; j < ptrs.size() && queries.size() < 64; ++j)
+        {
+            if (ander->alias(ptrs[i], ptrs[j]) == AliasResult::NoAlias)
+                queries.push_back(NodePair(ptrs[i], ptrs[j]));
+        }
+    }
+
+    u32_t numOfStale = 0;
+    auto check = [&]()
+    {
+        std::vector<AliasResult> results = ander->batchAlias(queries);
+        for (u32_t i = 0; i < queries.size(); ++i)
+        {
+            if (results[i] != ander->alias(queries[i].first, queries[i].second))
+                numOfStale++;
+        }
+        return results;
+    };
+
+    check();
+    Andersen::ConstraintList constraints;
+    for (const NodePair& q : queries)
+        constraints.push_back(Andersen::Constraint(ConstraintEdge::Copy, q.first, q.second));
+    ander->addConstraints(constraints);
+    u32_t numOfNoAlias = 0;
+    for (AliasResult res : check())
+    {
+        if (res == AliasResult::NoAlias)
+            numOfNoAlias++;
+    }
+    ander->removeConstraints(constraints);
+    check();
+
+    SVFUtil::outs() << "alias cache test: " << queries.size() << " queries, "
+                    << numOfStale << " stale results, " << numOfNoAlias
+                    << " no-alias results despite copy constraints\n";
+    AndersenWaveDiff::releaseAndersenWaveDiff();
+    return numOfStale == 0 && numOfNoAlias == 0;
+}
+
+static Option<u32_t> SNAPSHOTTEST(
+    "snapshot-test",
+    "check that a points-to snapshot, queried on the given number of threads, answers as the analysis does (0 to disable)",
+    0
+);
+
+/// Snapshot the solved Andersen's analysis and check the points-to sets and the
+/// alias results of all pairs of pointers, the latter queried on numThreads threads.
+/// Returns false on any difference.
+static bool testSnapshot(SVFIR* pag, u32_t numThreads)
+{
+    AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
+    std::unique_ptr<const PTASnapshot> snapshot = ander->snapshot();
+
+    std::vector<NodeID> ptrs;
+    u32_t numOfPtsDiffs = 0;
+    for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        if (!pag->isValidTopLevelPtr(it->second))
+            continue;
+        ptrs.push_back(it->first);
+        const PointsTo& pts = ander->getPts(it->first);
+        PTASnapshot::PtsRange range = snapshot->getPts(it->first);
+        bool same = pts.count() == range.size();
+        for (NodeID o : pts)
+            same = same && range.test(o);
+        if (!same)
+            numOfPtsDiffs++;
+    }
+
+    // The analysis is queried serially, the snapshot concurrently, one row per task.
+    std::vector<std::vector<AliasResult>> expected(ptrs.size());
+    for (u32_t i = 0; i < ptrs.size(); ++i)
+    {
+        for (u32_t j = i + 1; j < ptrs.size(); ++j)
+            expected[i].push_back(ander->alias(ptrs[i], ptrs[j]));
+    }
+    std::atomic<u64_t> numOfAliasDiffs{0};
+    ThreadPool pool(numThreads);
+    pool.parallelFor(ptrs.size(), [&](u32_t i, u32_t)
+    {
+        for (u32_t j = i + 1; j < ptrs.size(); ++j)
+        {
+            if (snapshot->alias(ptrs[i], ptrs[j]) != expected[i][j - i - 1])
+                numOfAliasDiffs++;
+        }
+    });
+
+    SVFUtil::outs() << "snapshot test: " << ptrs.size() << " pointers, "
+                    << numOfPtsDiffs << " with different points-to sets, "
+                    << numOfAliasDiffs << " pairs with different alias results\n";
+    AndersenWaveDiff::releaseAndersenWaveDiff();
+    return numOfPtsDiffs == 0 && numOfAliasDiffs == 0;
+}
+
 int main(int argc, char** argv)
 {
     auto moduleNameVec =
@@ -52,6 +171,24 @@ int main(int argc, char** argv)
     SVFIRBuilder builder;
     pag = builder.build();
 
+    if (ALIASCACHETEST())
+    {
+        bool passed = testAliasCache(pag);
+        if (!passed)
+            SVFUtil::errs() << SVFUtil::errMsg("alias cache test failed!") << "\n";
+        LLVMModuleSet::releaseLLVMModuleSet();
+        return passed ? 0 : 1;
+    }
+
+    if (SNAPSHOTTEST() > 0)
+    {
+        bool passed = testSnapshot(pag, SNAPSHOTTEST());
+        if (!passed)
+            SVFUtil::errs() << SVFUtil::errMsg("snapshot test failed!") << "\n";
+        LLVMModuleSet::releaseLLVMModuleSet();
+        return passed ? 0 : 1;
+    }
+
     WPAPass wpa;
     wpa.runOnModule(pag);
 
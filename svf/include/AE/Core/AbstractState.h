@@ -50,6 +50,7 @@
 #include "AE/Core/IntervalValue.h"
 #include "SVFIR/SVFVariables.h"
 #include "Util/Z3Expr.h"
+#include "Util/PersistentIDMap.h"
 
 #include <iomanip>
 
@@ -60,7 +61,9 @@ class AbstractState
     friend class SVFIR2AbsState;
     friend class RelationSolver;
 public:
-    typedef Map<u32_t, AbstractValue> VarToAbsValMap;
+    /// Copies of a state share their unchanged values, so that the per-node states of
+    /// the abstract trace cost what they change rather than a full copy each.
+    typedef PersistentIDMap<AbstractValue> VarToAbsValMap;
     typedef VarToAbsValMap AddrToAbsValMap;
     Set<NodeID> _freedAddrs;
 
@@ -112,14 +115,14 @@ public:
     }
 
     /// Return the internal index if addr is an address otherwise return the value of idx
-    inline u32_t getIDFromAddr(u32_t addr)
+    inline u32_t getIDFromAddr(u32_t addr) const
     {
         return _freedAddrs.count(addr) ?  AddressValue::getInternalID(InvalidMemAddr) : AddressValue::getInternalID(addr);
     }
 
     AbstractState&operator=(const AbstractState&rhs)
     {
-        if (rhs != *this)
+        if (&rhs != this)
         {
             _varToAbsVal = rhs._varToAbsVal;
             _addrToAbsVal = rhs._addrToAbsVal;
@@ -129,7 +132,7 @@ public:
     }
 
     /// move constructor
-    AbstractState(AbstractState&&rhs) : _varToAbsVal(std::move(rhs._varToAbsVal)),
+    AbstractState(AbstractState&&rhs) : _freedAddrs(std::move(rhs._freedAddrs)), _varToAbsVal(std::move(rhs._varToAbsVal)),
         _addrToAbsVal(std::move(rhs._addrToAbsVal))
     {
 
@@ -151,10 +154,10 @@ public:
     AbstractState bottom() const
     {
         AbstractState inv = *this;
-        for (auto &item: inv._varToAbsVal)
+        for (const auto &item: _varToAbsVal)
         {
             if (item.second.isInterval())
-                item.second.getInterval().set_to_bottom();
+                inv._varToAbsVal[item.first].getInterval().set_to_bottom();
         }
         return inv;
     }
@@ -163,10 +166,10 @@ public:
     AbstractState top() const
     {
         AbstractState inv = *this;
-        for (auto &item: inv._varToAbsVal)
+        for (const auto &item: _varToAbsVal)
         {
             if (item.second.isInterval())
-                item.second.getInterval().set_to_top();
+                inv._varToAbsVal[item.first].getInterval().set_to_top();
         }
         return inv;
     }
@@ -182,6 +185,12 @@ public:
         return inv;
     }
 
+    static inline const AbstractValue& bottomValue()
+    {
+        static const AbstractValue bottom;
+        return bottom;
+    }
+
     static inline bool isNullMem(u32_t addr)
     {
         return addr == NullMemAddr;
@@ -213,56 +222,48 @@ public:
         return _varToAbsVal.at(varId);
     }
 
+    /// Read-only lookups, which neither copy the structure shared with other states
+    /// (as operator[] and load do) nor add values. Absent ones read as bottom.
+    //@{
+    inline const AbstractValue& at(u32_t varId) const
+    {
+        const AbstractValue* val = _varToAbsVal.lookup(varId);
+        return val ? *val : bottomValue();
+    }
+    inline const AbstractValue& loadAt(u32_t addr) const
+    {
+        assert(isVirtualMemAddress(addr) && "not virtual address?");
+        const AbstractValue* val = _addrToAbsVal.lookup(getIDFromAddr(addr));
+        return val ? *val : bottomValue();
+    }
+    //@}
+
     /// whether the variable is in varToAddrs table
     inline bool inVarToAddrsTable(u32_t id) const
     {
-        if (_varToAbsVal.find(id)!= _varToAbsVal.end())
-        {
-            if (_varToAbsVal.at(id).isAddr())
-            {
-                return true;
-            }
-        }
-        return false;
+        const AbstractValue* val = _varToAbsVal.lookup(id);
+        return val && val->isAddr();
     }
 
     /// whether the variable is in varToVal table
     inline virtual bool inVarToValTable(u32_t id) const
     {
-        if (_varToAbsVal.find(id) != _varToAbsVal.end())
-        {
-            if (_varToAbsVal.at(id).isInterval())
-            {
-                return true;
-            }
-        }
-        return false;
+        const AbstractValue* val = _varToAbsVal.lookup(id);
+        return val && val->isInterval();
     }
 
     /// whether the memory address stores memory addresses
     inline bool inAddrToAddrsTable(u32_t id) const
     {
-        if (_addrToAbsVal.find(id)!= _addrToAbsVal.end())
-        {
-            if (_addrToAbsVal.at(id).isAddr())
-            {
-                return true;
-            }
-        }
-        return false;
+        const AbstractValue* val = _addrToAbsVal.lookup(id);
+        return val && val->isAddr();
     }
 
     /// whether the memory address stores abstract value
     inline virtual bool inAddrToValTable(u32_t id) const
     {
-        if (_addrToAbsVal.find(id) != _addrToAbsVal.end())
-        {
-            if (_addrToAbsVal.at(id).isInterval())
-            {
-                return true;
-            }
-        }
-        return false;
+        const AbstractValue* val = _addrToAbsVal.lookup(id);
+        return val && val->isInterval();
     }
 
     /// get var2val map
@@ -291,6 +292,38 @@ public:
     /// domain meet with other, important! other widen this.
     void meetWith(const AbstractState&other);
 
+    /// Sparse states (-use-sparse) leave out the variable values equal to those in a map
+    /// of definitions shared by all states
+    //@{
+    /// Fill in the values left out from defs
+    void overlayOn(const VarToAbsValMap& defs)
+    {
+        VarToAbsValMap vars = defs;
+        vars.mergeWith(_varToAbsVal, [](AbstractValue& lhs, const AbstractValue& rhs)
+        {
+            lhs = rhs;
+        }, true);
+        _varToAbsVal = std::move(vars);
+    }
+    /// Leave out the values equal to those in defs
+    void leaveOut(const VarToAbsValMap& defs)
+    {
+        _varToAbsVal = _varToAbsVal.difference(defs);
+    }
+    //@}
+
+    /// Overwrite the values of the variables and addresses in vars and locs (adding the
+    /// missing ones) with theirs
+    void updateWith(const VarToAbsValMap& vars, const AddrToAbsValMap& locs)
+    {
+        auto assign = [](AbstractValue& lhs, const AbstractValue& rhs)
+        {
+            lhs = rhs;
+        };
+        _varToAbsVal.mergeWith(vars, assign, true);
+        _addrToAbsVal.mergeWith(locs, assign, true);
+    }
+
     void addToFreedAddrs(NodeID addr)
     {
         _freedAddrs.insert(addr);
@@ -343,19 +376,7 @@ public:
 
     static bool eqVarToValMap(const VarToAbsValMap&lhs, const VarToAbsValMap&rhs)
     {
-        if (lhs.size() != rhs.size()) return false;
-        for (const auto &item: lhs)
-        {
-            auto it = rhs.find(item.first);
-            if (it == rhs.end())
-                return false;
-            if (!item.second.equals(it->second))
-                return false;
-            else
-            {
-            }
-        }
-        return true;
+        return lhs.equals(rhs);
     }
 
     static bool lessThanVarToValMap(const VarToAbsValMap&lhs, const VarToAbsValMap&rhs)
@@ -363,10 +384,10 @@ public:
         if (lhs.empty()) return !rhs.empty();
         for (const auto &item: lhs)
         {
-            auto it = rhs.find(item.first);
-            if (it == rhs.end()) return false;
+            const AbstractValue* val = rhs.lookup(item.first);
+            if (!val) return false;
             // judge from expr id
-            if (item.second.getInterval().contain(it->second.getInterval())) return false;
+            if (item.second.getInterval().contain(val->getInterval())) return false;
         }
         return true;
     }
@@ -377,10 +398,10 @@ public:
         if (rhs.empty()) return true;
         for (const auto &item: rhs)
         {
-            auto it = lhs.find(item.first);
-            if (it == lhs.end()) return false;
+            const AbstractValue* val = lhs.lookup(item.first);
+            if (!val) return false;
             // judge from expr id
-            if (!it->second.getInterval().contain(
+            if (!val->getInterval().contain(
                         item.second.getInterval()))
                 return false;
 
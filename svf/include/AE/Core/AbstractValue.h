@@ -113,7 +113,7 @@ public:
         return addrs;
     }
 
-    const AddressValue getAddrs() const
+    const AddressValue& getAddrs() const
     {
         return addrs;
     }
@@ -40,18 +40,27 @@
 
 
 #include "Util/GeneralType.h"
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 namespace SVF
 {
+/// A set of addresses, kept sorted. Most sets hold one or a few addresses,
+/// which are stored inline so that copying a state does not allocate for them;
+/// larger sets move to a sorted vector. Joins and meets merge the sorted sets.
 class AddressValue
 {
     friend class AbstractState;
     friend class RelExeState;
 public:
     typedef Set<u32_t> AddrSet;
+    typedef const u32_t* const_iterator;
+    static constexpr u32_t InlineAddrs = 4;
 private:
-    AddrSet _addrs;
+    u32_t _size{0};                 ///< number of addresses
+    u32_t _small[InlineAddrs];      ///< the addresses while there are no more than InlineAddrs
+    std::vector<u32_t> _large;      ///< the addresses once there are more
 
     /// Return the internal index if idx is an address otherwise return the value of idx
     static inline u32_t getInternalID(u32_t idx)
@@ -59,30 +68,67 @@ private:
         return (idx & FlippedAddressMask);
     }
 
+    /// Replace the addresses with the sorted (unique) addresses in vals
+    void assign(std::vector<u32_t>&& vals)
+    {
+        _size = vals.size();
+        if (_size <= InlineAddrs)
+        {
+            std::copy(vals.begin(), vals.end(), _small);
+            std::vector<u32_t>().swap(_large);
+        }
+        else
+            _large = std::move(vals);
+    }
+
 public:
     /// Default constructor
     AddressValue() {}
 
     /// Constructor
-    AddressValue(const Set<u32_t> &addrs) :  _addrs(addrs) {}
+    AddressValue(const Set<u32_t> &addrs)
+    {
+        std::vector<u32_t> vals(addrs.begin(), addrs.end());
+        std::sort(vals.begin(), vals.end());
+        assign(std::move(vals));
+    }
 
-    AddressValue(u32_t addr) :  _addrs({addr}) {}
+    AddressValue(u32_t addr) : _size(1)
+    {
+        _small[0] = addr;
+    }
 
     /// Default destructor
     ~AddressValue() = default;
 
     /// Copy constructor
-    AddressValue(const AddressValue &other) : _addrs(other._addrs) {}
+    AddressValue(const AddressValue &other) : _size(other._size), _large(other._large)
+    {
+        if (_size <= InlineAddrs)
+            std::copy(other._small, other._small + _size, _small);
+    }
 
     /// Move constructor
-    AddressValue(AddressValue &&other) noexcept: _addrs(std::move(other._addrs)) {}
+    AddressValue(AddressValue &&other) noexcept: _size(other._size), _large(std::move(other._large))
+    {
+        if (_size <= InlineAddrs)
+            std::copy(other._small, other._small + _size, _small);
+        other._size = 0;
+    }
 
     /// Copy operator=
     AddressValue &operator=(const AddressValue &other)
     {
-        if (!this->equals(other))
+        if (this != &other)
         {
-            _addrs = other._addrs;
+            _size = other._size;
+            if (_size <= InlineAddrs)
+            {
+                std::copy(other._small, other._small + _size, _small);
+                _large.clear();
+            }
+            else
+                _large = other._large;
         }
         return *this;
     }
@@ -92,93 +138,106 @@ public:
     {
         if (this != &other)
         {
-            _addrs = std::move(other._addrs);
+            _size = other._size;
+            if (_size <= InlineAddrs)
+                std::copy(other._small, other._small + _size, _small);
+            _large = std::move(other._large);
+            other._size = 0;
         }
         return *this;
     }
 
     bool equals(const AddressValue &rhs) const
     {
-        return _addrs == rhs._addrs;
+        return _size == rhs._size && std::equal(begin(), end(), rhs.begin());
     }
 
-    AddrSet::const_iterator begin() const
+    const_iterator begin() const
     {
-        return _addrs.cbegin();
+        return _size <= InlineAddrs ? _small : _large.data();
     }
 
-    AddrSet::const_iterator end() const
+    const_iterator end() const
     {
-        return _addrs.cend();
+        return begin() + _size;
     }
 
     bool empty() const
     {
-        return _addrs.empty();
+        return _size == 0;
     }
 
     u32_t size() const
     {
-        return _addrs.size();
-    }
-
-    std::pair<AddressValue::AddrSet::iterator, bool> insert(u32_t id)
-    {
-        return _addrs.insert(id);
+        return _size;
     }
 
-    const AddrSet &getVals() const
+    /// Insert id, returning whether it was not in the set
+    bool insert(u32_t id)
     {
-        return _addrs;
-    }
-
-    void setVals(const AddrSet &vals)
-    {
-        _addrs = vals;
+        const_iterator pos = std::lower_bound(begin(), end(), id);
+        if (pos != end() && *pos == id)
+            return false;
+        u32_t idx = pos - begin();
+        if (_size < InlineAddrs)
+        {
+            std::copy_backward(_small + idx, _small + _size, _small + _size + 1);
+            _small[idx] = id;
+        }
+        else
+        {
+            if (_size == InlineAddrs)
+                _large.assign(_small, _small + _size);
+            _large.insert(_large.begin() + idx, id);
+        }
+        ++_size;
+        return true;
     }
 
     /// Current AddressValue joins with another AddressValue
     bool join_with(const AddressValue &other)
     {
-        bool changed = false;
-        for (const auto &addr: other)
-        {
-            if (!_addrs.count(addr))
-            {
-                if (insert(addr).second)
-                    changed = true;
-            }
-        }
-        return changed;
+        if (std::includes(begin(), end(), other.begin(), other.end()))
+            return false;
+        if (other._size == 1)
+            return insert(*other.begin());
+        std::vector<u32_t> vals;
+        vals.reserve(_size + other._size);
+        std::set_union(begin(), end(), other.begin(), other.end(), std::back_inserter(vals));
+        assign(std::move(vals));
+        return true;
     }
 
     /// Return a intersected AddressValue
     bool meet_with(const AddressValue &other)
     {
-        AddrSet s;
-        for (const auto &id: other._addrs)
-        {
-            if (_addrs.find(id) != _addrs.end())
-            {
-                s.insert(id);
-            }
-        }
-        bool changed = (_addrs != s);
-        _addrs = std::move(s);
-        return changed;
+        if (std::includes(other.begin(), other.end(), begin(), end()))
+            return false;
+        std::vector<u32_t> vals;
+        vals.reserve(std::min(_size, other._size));
+        std::set_intersection(begin(), end(), other.begin(), other.end(), std::back_inserter(vals));
+        assign(std::move(vals));
+        return true;
     }
 
     /// Return true if the AddressValue contains n
     bool contains(u32_t id) const
     {
-        return _addrs.count(id);
+        return std::binary_search(begin(), end(), id);
     }
 
-    bool hasIntersect(const AddressValue &other)
+    bool hasIntersect(const AddressValue &other) const
     {
-        AddressValue v = *this;
-        v.meet_with(other);
-        return !v.empty();
+        for (const_iterator it = begin(), oit = other.begin(); it != end() && oit != other.end();)
+        {
+            if (*it < *oit)
+                ++it;
+            else if (*oit < *it)
+                ++oit;
+            else
+                return true;
+        }
+        return false;
     }
 
     inline bool isBottom() const
@@ -197,9 +256,9 @@ public:
         else
         {
             rawStr << "[";
-            for (auto it = _addrs.begin(), eit = _addrs.end(); it!= eit; ++it)
+            for (u32_t addr : *this)
             {
-                rawStr << *it << ", ";
+                rawStr << addr << ", ";
             }
             rawStr << "]";
         }
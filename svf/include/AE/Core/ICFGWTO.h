@@ -67,13 +67,23 @@ public:
     }
 
     inline virtual std::vector<const ICFGNode*> getSuccessors(const ICFGNode* node) override
+    {
+        if (node->isFrozen())
+            return collectSuccessors(node, node->getFrozenOutEdges());
+        return collectSuccessors(node, node->getOutEdges());
+    }
+
+private:
+    /// Successors of node through its out edges (either the edge set or the compact edges of a frozen ICFG)
+    template <class EdgeRangeTy>
+    inline std::vector<const ICFGNode*> collectSuccessors(const ICFGNode* node, const EdgeRangeTy& outEdges)
     {
         std::vector<const ICFGNode*> successors;
 
         if (const auto* callNode = SVFUtil::dyn_cast<CallICFGNode>(node))
         {
 
-            for (const auto &e : callNode->getOutEdges())
+            for (const auto &e : outEdges)
             {
                 ICFGNode *calleeEntryICFGNode = e->getDstNode();
                 const ICFGNode *succ = nullptr;
@@ -88,7 +98,7 @@ public:
         }
         else
         {
-            for (const auto& e : node->getOutEdges())
+            for (const auto& e : outEdges)
             {
                 ICFGNode *succ = e->getDstNode();
                 if (scc.find(succ->getFun()) == scc.end()) // if not in the same SCC, skip
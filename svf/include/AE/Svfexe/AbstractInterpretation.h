@@ -52,7 +52,7 @@ template<typename T> class FILOWorkList;
 class AEStat : public SVFStat
 {
 public:
-    void countStateSize();
+    void countStateSize(const AbstractState& as);
     AEStat(AbstractInterpretation* ae) : _ae(ae)
     {
         startTime = getClk(true);
@@ -100,6 +100,30 @@ public:
         }
         return generalNumMap["ICFG_Node_Trace"];
     }
+    u32_t& getCalleeSummaryHits()
+    {
+        if (generalNumMap.count("Callee_Summary_Hits") == 0)
+        {
+            generalNumMap["Callee_Summary_Hits"] = 0;
+        }
+        return generalNumMap["Callee_Summary_Hits"];
+    }
+    u32_t& getCalleeSummaryMisses()
+    {
+        if (generalNumMap.count("Callee_Summary_Misses") == 0)
+        {
+            generalNumMap["Callee_Summary_Misses"] = 0;
+        }
+        return generalNumMap["Callee_Summary_Misses"];
+    }
+    u32_t& getEvictedStates()
+    {
+        if (generalNumMap.count("Evicted_States") == 0)
+        {
+            generalNumMap["Evicted_States"] = 0;
+        }
+        return generalNumMap["Evicted_States"];
+    }
 };
 
 /// AbstractInterpretation is same as Abstract Execution
@@ -146,6 +170,12 @@ public:
     /// Program entry
     void analyse();
 
+    /// Number of callee analyses replaced by their summaries
+    u32_t getCalleeSummaryHits() const
+    {
+        return stat->getCalleeSummaryHits();
+    }
+
     static AbstractInterpretation& getAEInstance()
     {
         static AbstractInterpretation instance;
@@ -194,8 +224,13 @@ public:
         }
         else
         {
-            //TODO: support sparse abstract state
-            return abstractTrace[node][varId];
+            AbstractState& as = abstractTrace[node];
+            if (Options::UseSparseState() && !as.getVarToVal().count(varId))
+            {
+                if (const AbstractValue* val = defValues.lookup(varId))
+                    return *val;
+            }
+            return as.at(varId);
         }
     }
 
@@ -247,6 +282,71 @@ private:
 
     void handleWTOComponent(const ICFGWTOComp* wtoComp);
 
+    /**
+     * Callee summaries (enabled by -ae-summary-limit). A summary is keyed on what the callee
+     * reads from its entry state: the values of its arguments and of the memory reachable
+     * from them and from the global objects. Analysing the callee again from an entry state
+     * agreeing on those gives the same changes to the values of its own variables and
+     * objects and of that memory, so they are applied to the new entry state instead while
+     * the detectors are replayed on the final state of each node the callee visited.
+     */
+    //@{
+    /// Apply the summary of callee if its entry values still hold. Returns false otherwise,
+    /// and then records the analysis of callee which follows, up to endCalleeSummary.
+    bool applyCalleeSummary(const FunObjVar* callee);
+    void endCalleeSummary(const FunObjVar* callee);
+    /// Join the states of the call sites of callee into entry, as its FunEntry node does,
+    /// and collect the arguments and reachable objects a summary is keyed on. Returns false
+    /// if there are more than -ae-summary-limit of them.
+    bool collectCalleeEntry(const FunObjVar* callee, AbstractState& entry,
+                            std::vector<NodeID>& args, std::vector<NodeID>& objs);
+    /// Whether var (or object) id belongs to one of funs
+    bool isOwnedBy(NodeID id, const Set<const FunObjVar*>& funs) const;
+    inline void recordNodeVisit(const ICFGNode* node)
+    {
+        if (!summaryRecords.empty() && !summaryRecords.back().overflow)
+            summaryRecords.back().lastVisit[node] = summaryRecords.back().numVisits++;
+    }
+    /// Run the detectors on the current state of node as handleSingletonWTO does
+    void replayDetectors(const ICFGNode* node);
+    //@}
+
+    /**
+     * Sparse abstract states (enabled by -use-sparse). The value of a top-level variable
+     * defined by a single statement is kept in defValues at its definition, rather than
+     * in every state of the trace after it. A state of the trace only keeps the values
+     * which differ from defValues (e.g. refined on a branch), and is filled in from
+     * defValues before its node is handled.
+     */
+    //@{
+    /// Whether the value of the variable can be kept at its definition
+    bool isSparseVar(NodeID id) const;
+    /// Store the state as after handling a node, given the sparse state it was filled
+    /// in from and the definitions it was filled in with
+    void storeSparseState(AbstractState& as, const AbstractState& sparseIn,
+                          const AbstractState::VarToAbsValMap& defs);
+    //@}
+
+    /**
+     * State eviction (enabled by -ae-evict-states). The state of a node is read by its
+     * successors and by the phis taking an operand from it, and is dead once each of them
+     * has been handled for the last time before the node is handled again: a reader nested
+     * in a cycle the node is not in is handled for the last time when the cycle is done.
+     * Call sites (read by the callee and the detectors), loop heads (widened against their
+     * previous state), the sources of back edges (read again by the narrowing head) and
+     * nodes with interprocedural successors keep their states.
+     */
+    //@{
+    /// Collect the components reading the state of each node of wto
+    void collectStateReaders(const ICFGWTO* wto);
+    /// Wait for the readers of the state of the node just handled
+    void watchStateReaders(const ICFGSingletonWTO* singleton);
+    /// Evict the states whose last reader is the component just handled
+    void evictDeadStates(const ICFGWTOComp* comp);
+    /// Drop the state of node, handing it to the callee analysis being summarised
+    void evictState(const ICFGNode* node);
+    //@}
+
 
     /**
      * handle SVF Statement like CmpStmt, CallStmt, GepStmt, LoadStmt, StoreStmt, etc.
@@ -350,6 +450,50 @@ private:
     Map<std::string, std::function<void(const CallICFGNode*)>> func_map;
 
     Map<const ICFGNode*, AbstractState> abstractTrace; // abstract states immediately after nodes
+    AbstractState::VarToAbsValMap defValues; ///< values of the sparse variables at their definitions
+
+    /// Values of a node state a summarised callee analysis changed from its entry state
+    struct StateChange
+    {
+        const ICFGNode* node;
+        AbstractState::VarToAbsValMap vars;
+        AbstractState::AddrToAbsValMap locs;
+        Set<NodeID> freedAddrs;
+    };
+    /// Entry state (with the arguments and reachable objects, sorted, it is keyed on),
+    /// functions, state changes and visited nodes (in order of last visit) of the last
+    /// analysis of a callee
+    struct CalleeSummary
+    {
+        AbstractState entry;
+        std::vector<NodeID> args;
+        std::vector<NodeID> objs;
+        Set<const FunObjVar*> funs;
+        std::vector<StateChange> changes;
+        std::vector<const ICFGNode*> evictions;
+        std::vector<const ICFGNode*> visits;
+    };
+    /// Entry and visits of a callee analysis in progress
+    struct SummaryRecord
+    {
+        AbstractState entry;
+        std::vector<NodeID> args;
+        std::vector<NodeID> objs;
+        Map<const ICFGNode*, u32_t> lastVisit;
+        Map<const ICFGNode*, AbstractState> evicted;	///< last states of the visited nodes evicted
+        u32_t numVisits{0};
+        bool overflow{false};	///< too many entry values to be summarised
+    };
+    Map<const FunObjVar*, CalleeSummary> calleeSummaries;
+    std::vector<SummaryRecord> summaryRecords;	///< one per callee being analysed and summarised
+    std::vector<NodeID> globalObjs;	///< global objects, from which callee summaries reach memory
+
+    /// Components reading the state of a node (keyed by its singleton, as functions of a
+    /// recursion may be in several WTOs), and nodes read by a component
+    Map<const ICFGSingletonWTO*, std::vector<const ICFGWTOComp*>> stateReaders;
+    Map<const ICFGWTOComp*, std::vector<const ICFGNode*>> readStates;
+    /// Readers yet to be handled since a node was last handled
+    Map<const ICFGNode*, std::vector<const ICFGWTOComp*>> pendingStateReaders;
     std::string moduleName;
 
     std::vector<std::unique_ptr<AEDetector>> detectors;
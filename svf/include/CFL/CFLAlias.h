@@ -70,6 +70,12 @@ public:
             return AliasResult::NoAlias;
     }
 
+    /// Aliasing here is not decided by points-to sets, so is not cached
+    std::vector<AliasResult> batchAlias(const std::vector<NodePair>& queries) override
+    {
+        return PointerAnalysis::batchAlias(queries);
+    }
+
     /// Get points-to targets of a pointer.  V In this context
     virtual const PointsTo& getCFLPts(NodeID ptr)
     {
@@ -79,6 +79,12 @@ public:
     /// Compute points-to set for a context-sensitive pointer
     virtual const CxtPtSet& computeDDAPts(const CxtVar& cxtVar);
 
+    /// Answer queries whose definitions come first on the SVFG first
+    inline void orderDDAQueries(std::vector<NodeID>& queries) override
+    {
+        sortQueriesTopologically(queries);
+    }
+
     /// Handle out-of-budget dpm
     void handleOutOfBudgetDpm(const CxtLocDPItem& dpm);
 
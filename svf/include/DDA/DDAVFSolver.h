@@ -34,8 +34,10 @@
 #include "Graphs/SCC.h"
 #include "MSSA/SVFGBuilder.h"
 #include "MemoryModel/PointsTo.h"
+#include "Util/Options.h"
 #include "WPA/Andersen.h"
 #include <algorithm>
+#include <map>
 
 namespace SVF
 {
@@ -60,6 +62,7 @@ public:
     typedef OrderedSet<const SVFGEdge* > ConstSVFGEdgeSet;
     typedef SVFGEdge::SVFGEdgeSetTy SVFGEdgeSet;
     typedef OrderedMap<const SVFGNode*, DPTItemSet> StoreToPMSetMap;
+    typedef std::multimap<u64_t, std::vector<DPIm>> StepsToDPMsMap;
 
     ///Constructor
     DDAVFSolver(): outOfBudgetQuery(false),_pag(nullptr),_svfg(nullptr),_ander(nullptr),_callGraph(nullptr), _callGraphSCC(nullptr), _svfgSCC(nullptr), ddaStat(nullptr)
@@ -326,12 +329,44 @@ protected:
         if(outOfBudgetQuery)
             OOBResetVisited();
 
+        retireQueryDpms();
         locToDpmSetMap.clear();
         dpmToloadDpmMap.clear();
         loadToPTCVarMap.clear();
         outOfBudgetQuery = false;
         ddaStat->_NumOfStep = 0;
     }
+    /// Points-to caches are kept across queries. With a -dda-cache-size budget, the dpms
+    /// of each query are recorded with the steps the query took, and those of the cheapest
+    /// queries to recompute are evicted first once the caches outgrow the budget.
+    //@{
+    inline void retireQueryDpms()
+    {
+        if (Options::DDACacheSize() == 0 || locToDpmSetMap.empty())
+            return;
+
+        std::vector<DPIm>& dpms = stepsToDpms.emplace(ddaStat->_NumOfStep, std::vector<DPIm>())->second;
+        for (const typename LocToDPMVecMap::value_type& locDpms : locToDpmSetMap)
+            dpms.insert(dpms.end(), locDpms.second.begin(), locDpms.second.end());
+        evictCachedPointsTo(Options::DDACacheSize());
+    }
+    void evictCachedPointsTo(u32_t budget)
+    {
+        while (dpmToTLCPtSetMap.size() + dpmToADCPtSetMap.size() > budget && !stepsToDpms.empty())
+        {
+            for (const DPIm& dpm : stepsToDpms.begin()->second)
+            {
+                // Out-of-budget dpms are never recomputed, so keep their conservative points-to.
+                if (isOutOfBudgetDpm(dpm))
+                    continue;
+                backwardVisited.erase(dpm);
+                dpmToTLCPtSetMap.erase(dpm);
+                dpmToADCPtSetMap.erase(dpm);
+            }
+            stepsToDpms.erase(stepsToDpms.begin());
+        }
+    }
+    //@}
     /// Reset visited map if the current query is out-of-budget
     inline void OOBResetVisited()
     {
@@ -608,6 +643,30 @@ protected:
         }
         _svfgSCC->find();
     }
+    /// Order query pointers topologically by their definitions on the SVFG, so that the
+    /// points-to of value-flow predecessors are cached before the queries reaching them.
+    void sortQueriesTopologically(std::vector<NodeID>& queries)
+    {
+        SVFGSCCDetection();
+        Map<NodeID, u32_t> topoOrder;
+        typename SVFGSCC::GNodeStack topoStack = _svfgSCC->topoNodeStack();
+        for (u32_t i = 0; !topoStack.empty(); ++i, topoStack.pop())
+            topoOrder[topoStack.top()] = i;
+
+        std::vector<std::pair<u32_t, NodeID>> orderedQueries;
+        for (NodeID ptr : queries)
+        {
+            NodeID def = getDefSVFGNode(_pag->getGNode(ptr))->getId();
+            orderedQueries.emplace_back(topoOrder[getSVFGSCCRepNode(def)], ptr);
+        }
+        std::stable_sort(orderedQueries.begin(), orderedQueries.end(),
+                         [](const std::pair<u32_t, NodeID>& a, const std::pair<u32_t, NodeID>& b)
+        {
+            return a.first < b.first;
+        });
+        for (u32_t i = 0; i < queries.size(); ++i)
+            queries[i] = orderedQueries[i].second;
+    }
     /// Get SCC rep node of a SVFG node.
     inline NodeID getSVFGSCCRepNode(NodeID id)
     {
@@ -785,6 +844,7 @@ protected:
     DPMToCVarMap loadToPTCVarMap;	///< map a load dpm to its cvar pointed by its pointer operand
     DPTItemSet outOfBudgetDpms;		///< out of budget dpm set
     StoreToPMSetMap storeToDPMs;	///< map store to set of DPM which have been stong updated there
+    StepsToDPMsMap stepsToDpms;		///< dpms of past queries keyed by their steps, for cache eviction
     DDAStat* ddaStat;				///< DDA stat
     SVFGBuilder svfgBuilder;			///< SVFG Builder
 };
@@ -73,6 +73,12 @@ public:
     /// Compute points-to set for all top variable
     void computeDDAPts(NodeID id) override;
 
+    /// Answer queries whose definitions come first on the SVFG first
+    inline void orderDDAQueries(std::vector<NodeID>& queries) override
+    {
+        sortQueriesTopologically(queries);
+    }
+
     /// Handle out-of-budget dpm
     void handleOutOfBudgetDpm(const LocDPItem& dpm);
 
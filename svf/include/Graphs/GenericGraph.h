@@ -35,12 +35,20 @@
 #include "Graphs/GraphTraits.h"
 #include "SVFIR/SVFValue.h"
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
 namespace SVF
 {
 /// Forward declaration of some friend classes
 ///@{
 template <typename, typename> class GenericGraphWriter;
 template <typename, typename> class GenericGraphReader;
+template <typename, typename> class GenericGraph;
 ///@}
 
 /*!
@@ -134,12 +142,282 @@ protected:
 
 
 
+/*!
+ * Contiguous range of the compact edge array of a frozen graph
+ */
+template<class EdgeTy>
+class FrozenEdgeRange
+{
+public:
+    typedef EdgeTy* const* iterator;
+    typedef iterator const_iterator;
+
+    FrozenEdgeRange(iterator b, iterator e): _begin(b), _end(e) {}
+
+    inline iterator begin() const
+    {
+        return _begin;
+    }
+    inline iterator end() const
+    {
+        return _end;
+    }
+    inline u32_t size() const
+    {
+        return _end - _begin;
+    }
+    inline bool empty() const
+    {
+        return _begin == _end;
+    }
+
+private:
+    iterator _begin;
+    iterator _end;
+};
+
+/*!
+ * Node table of a graph, indexed by node ID.
+ * Node IDs are mostly dense as they come from NodeIDAllocator or per-graph
+ * counters, so the nodes are kept in a vector of (ID, node) entries. Removed
+ * nodes leave a tombstone (a null node) behind. The vector only grows
+ * geometrically, so IDs far beyond it (e.g., values under the dense
+ * allocation strategy, or GEP objects under the debug one) are kept in an
+ * ordered map instead, all of them above the IDs of the vector. Iteration is
+ * in ascending ID order like the OrderedMap it replaces, and iterators remain
+ * valid while nodes are added.
+ */
+template<class NodeTy>
+class DenseNodeMap
+{
+public:
+    typedef std::pair<const NodeID, NodeTy*> value_type;
+    typedef std::vector<value_type> EntryVector;
+    typedef OrderedMap<NodeID, NodeTy*> SparseMap;
+
+    template <bool IsConst>
+    class DenseNodeMapIterator
+    {
+        friend class DenseNodeMap;
+        typedef typename std::conditional<IsConst, const DenseNodeMap, DenseNodeMap>::type MapTy;
+        typedef typename std::conditional<IsConst, typename SparseMap::const_iterator, typename SparseMap::iterator>::type SparseIter;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef typename DenseNodeMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<IsConst, const value_type*, value_type*>::type pointer;
+        typedef typename std::conditional<IsConst, const value_type&, value_type&>::type reference;
+
+        DenseNodeMapIterator(): map(nullptr), idx(inSparse), sit() {}
+        DenseNodeMapIterator(MapTy* m, size_t i): map(m), idx(i), sit()
+        {
+            skipTombstones();
+        }
+        DenseNodeMapIterator(MapTy* m, SparseIter it): map(m), idx(inSparse), sit(it) {}
+        /// iterator to const_iterator
+        template <bool WasConst, typename = typename std::enable_if<IsConst && !WasConst>::type>
+        DenseNodeMapIterator(const DenseNodeMapIterator<WasConst>& it): map(it.map), idx(it.idx), sit(it.sit) {}
+
+        inline reference operator*() const
+        {
+            return idx == inSparse ? *sit : map->entries[idx];
+        }
+        inline pointer operator->() const
+        {
+            return &**this;
+        }
+        inline DenseNodeMapIterator& operator++()
+        {
+            if (idx == inSparse)
+                ++sit;
+            else
+            {
+                ++idx;
+                skipTombstones();
+            }
+            return *this;
+        }
+        inline DenseNodeMapIterator operator++(int)
+        {
+            DenseNodeMapIterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        inline DenseNodeMapIterator& operator--()
+        {
+            if (idx == inSparse)
+            {
+                if (sit != map->sparse.begin())
+                {
+                    --sit;
+                    return *this;
+                }
+                idx = map->entries.size();
+            }
+            do
+            {
+                assert(idx > 0 && "decrementing the first iterator");
+                --idx;
+            }
+            while (map->entries[idx].second == nullptr);
+            return *this;
+        }
+        inline DenseNodeMapIterator operator--(int)
+        {
+            DenseNodeMapIterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        inline bool operator==(const DenseNodeMapIterator& rhs) const
+        {
+            return idx == rhs.idx && (idx != inSparse || sit == rhs.sit);
+        }
+        inline bool operator!=(const DenseNodeMapIterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        /// Past the vector, continue with the ordered map
+        inline void skipTombstones()
+        {
+            while (idx < map->entries.size() && map->entries[idx].second == nullptr)
+                ++idx;
+            if (idx >= map->entries.size())
+            {
+                idx = inSparse;
+                sit = map->sparse.begin();
+            }
+        }
+
+        /// idx of an iterator into the ordered map
+        static constexpr size_t inSparse = ~static_cast<size_t>(0);
+
+        MapTy* map;
+        size_t idx;
+        SparseIter sit;
+
+        template <bool> friend class DenseNodeMapIterator;
+    };
+
+    typedef DenseNodeMapIterator<false> iterator;
+    typedef DenseNodeMapIterator<true> const_iterator;
+
+    DenseNodeMap(): numOfNodes(0) {}
+
+    inline iterator begin()
+    {
+        return iterator(this, 0);
+    }
+    inline iterator end()
+    {
+        return iterator(this, sparse.end());
+    }
+    inline const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+    inline const_iterator end() const
+    {
+        return const_iterator(this, sparse.end());
+    }
+
+    /// Node of id, nullptr if there is none
+    inline NodeTy* lookup(NodeID id) const
+    {
+        if (id < entries.size())
+            return entries[id].second;
+        auto it = sparse.find(id);
+        return it != sparse.end() ? it->second : nullptr;
+    }
+    inline iterator find(NodeID id)
+    {
+        if (id < entries.size())
+            return entries[id].second ? iterator(this, id) : end();
+        return iterator(this, sparse.find(id));
+    }
+    inline const_iterator find(NodeID id) const
+    {
+        if (id < entries.size())
+            return entries[id].second ? const_iterator(this, id) : end();
+        return const_iterator(this, sparse.find(id));
+    }
+    inline u32_t count(NodeID id) const
+    {
+        return lookup(id) ? 1 : 0;
+    }
+
+    /// Set the node of id, replacing the existing one if any
+    inline void set(NodeID id, NodeTy* node)
+    {
+        assert(node && "null node added to a graph?");
+        if (id >= entries.size() && canGrowTo(id))
+        {
+            entries.reserve(std::max<size_t>(static_cast<size_t>(id) + 1, 2 * entries.size()));
+            while (entries.size() <= id)
+                entries.emplace_back(entries.size(), nullptr);
+        }
+        NodeTy*& slot = id < entries.size() ? entries[id].second : sparse[id];
+        if (slot == nullptr)
+            numOfNodes++;
+        slot = node;
+    }
+
+    /// Leave a tombstone at it, or remove it from the ordered map
+    inline void erase(iterator it)
+    {
+        assert(it.map == this && it != end() && "erasing an invalid iterator");
+        if (it.idx == iterator::inSparse)
+            sparse.erase(it.sit);
+        else
+        {
+            assert(entries[it.idx].second && "erasing a tombstone");
+            entries[it.idx].second = nullptr;
+        }
+        numOfNodes--;
+    }
+
+    inline void clear()
+    {
+        EntryVector().swap(entries);
+        sparse.clear();
+        numOfNodes = 0;
+    }
+
+    /// Number of nodes (excluding tombstones)
+    inline size_t size() const
+    {
+        return numOfNodes;
+    }
+    inline bool empty() const
+    {
+        return numOfNodes == 0;
+    }
+
+private:
+    /// Whether the vector may grow up to id: at most doubling it, and never
+    /// over IDs already in the ordered map
+    inline bool canGrowTo(NodeID id) const
+    {
+        return static_cast<size_t>(id) < 2 * entries.size() + MinEntries &&
+               (sparse.empty() || id < sparse.begin()->first);
+    }
+
+    static constexpr size_t MinEntries = 1024;
+
+    EntryVector entries;    ///< entries[id] == (id, node of id or nullptr)
+    SparseMap sparse;       ///< nodes whose IDs are beyond entries
+    size_t numOfNodes;      ///< number of nodes in entries and sparse
+};
+
 /*!
  * Generic node on the graph as base class
  */
 template<class NodeTy,class EdgeTy>
 class GenericNode: public SVFValue
 {
+    friend class GenericGraph<NodeTy, EdgeTy>;
 
 public:
     typedef NodeTy NodeType;
@@ -151,11 +429,35 @@ public:
     typedef typename GEdgeSetTy::iterator iterator;
     typedef typename GEdgeSetTy::const_iterator const_iterator;
     ///@}
+    typedef FrozenEdgeRange<EdgeType> FrozenEdgeRangeTy;
+    typedef typename EdgeType::GEdgeKind GEdgeKind;
 
 private:
 
-    GEdgeSetTy InEdges; ///< all incoming edge of this node
-    GEdgeSetTy OutEdges; ///< all outgoing edge of this node
+    mutable GEdgeSetTy InEdges; ///< all incoming edge of this node
+    mutable GEdgeSetTy OutEdges; ///< all outgoing edge of this node
+
+    const GenericGraph<NodeTy, EdgeTy>* frozenGraph = nullptr; ///< frozen graph holding the compact edges of this node
+    u32_t frozenIdx = 0; ///< index of this node in the compact arrays of frozenGraph
+    /// Whether InEdges/OutEdges have been released by freezing (see GenericGraph::freeze)
+    mutable std::atomic<bool> edgeSetsReleased{false};
+
+    /// Edge sets, restored from the compact arrays first if they have been released
+    //@{
+    inline GEdgeSetTy& inEdgeSet() const
+    {
+        if (edgeSetsReleased.load(std::memory_order_acquire))
+            restoreEdgeSets();
+        return InEdges;
+    }
+    inline GEdgeSetTy& outEdgeSet() const
+    {
+        if (edgeSetsReleased.load(std::memory_order_acquire))
+            restoreEdgeSets();
+        return OutEdges;
+    }
+    void restoreEdgeSets() const;
+    //@}
 
 public:
     /// Constructor
@@ -167,7 +469,7 @@ public:
     /// Destructor
     virtual ~GenericNode()
     {
-        for (auto * edge : OutEdges)
+        for (auto * edge : outEdgeSet())
             delete edge;
     }
 
@@ -175,11 +477,11 @@ public:
     ///@{
     inline const GEdgeSetTy& getOutEdges() const
     {
-        return OutEdges;
+        return outEdgeSet();
     }
     inline const GEdgeSetTy& getInEdges() const
     {
-        return InEdges;
+        return inEdgeSet();
     }
     ///@}
 
@@ -187,10 +489,14 @@ public:
     //@{
     inline bool hasIncomingEdge() const
     {
+        if (edgeSetsReleased.load(std::memory_order_acquire))
+            return getFrozenInEdges().empty() == false;
         return (InEdges.empty() == false);
     }
     inline bool hasOutgoingEdge() const
     {
+        if (edgeSetsReleased.load(std::memory_order_acquire))
+            return getFrozenOutEdges().empty() == false;
         return (OutEdges.empty() == false);
     }
     //@}
@@ -199,35 +505,35 @@ public:
     //@{
     inline iterator OutEdgeBegin()
     {
-        return OutEdges.begin();
+        return outEdgeSet().begin();
     }
     inline iterator OutEdgeEnd()
     {
-        return OutEdges.end();
+        return outEdgeSet().end();
     }
     inline iterator InEdgeBegin()
     {
-        return InEdges.begin();
+        return inEdgeSet().begin();
     }
     inline iterator InEdgeEnd()
     {
-        return InEdges.end();
+        return inEdgeSet().end();
     }
     inline const_iterator OutEdgeBegin() const
     {
-        return OutEdges.begin();
+        return outEdgeSet().begin();
     }
     inline const_iterator OutEdgeEnd() const
     {
-        return OutEdges.end();
+        return outEdgeSet().end();
     }
     inline const_iterator InEdgeBegin() const
     {
-        return InEdges.begin();
+        return inEdgeSet().begin();
     }
     inline const_iterator InEdgeEnd() const
     {
-        return InEdges.end();
+        return inEdgeSet().end();
     }
     //@}
 
@@ -235,47 +541,62 @@ public:
     //@{
     virtual inline iterator directOutEdgeBegin()
     {
-        return OutEdges.begin();
+        return outEdgeSet().begin();
     }
     virtual inline iterator directOutEdgeEnd()
     {
-        return OutEdges.end();
+        return outEdgeSet().end();
     }
     virtual inline iterator directInEdgeBegin()
     {
-        return InEdges.begin();
+        return inEdgeSet().begin();
     }
     virtual inline iterator directInEdgeEnd()
     {
-        return InEdges.end();
+        return inEdgeSet().end();
     }
 
     virtual inline const_iterator directOutEdgeBegin() const
     {
-        return OutEdges.begin();
+        return outEdgeSet().begin();
     }
     virtual inline const_iterator directOutEdgeEnd() const
     {
-        return OutEdges.end();
+        return outEdgeSet().end();
     }
     virtual inline const_iterator directInEdgeBegin() const
     {
-        return InEdges.begin();
+        return inEdgeSet().begin();
     }
     virtual inline const_iterator directInEdgeEnd() const
     {
-        return InEdges.end();
+        return inEdgeSet().end();
+    }
+    //@}
+
+    /// Compact edges of a frozen graph (see GenericGraph::freeze)
+    //@{
+    inline bool isFrozen() const
+    {
+        return frozenGraph != nullptr;
     }
+    inline FrozenEdgeRangeTy getFrozenOutEdges() const;
+    inline FrozenEdgeRangeTy getFrozenInEdges() const;
+    /// Compact edges of one kind only
+    inline FrozenEdgeRangeTy getFrozenOutEdges(GEdgeKind kind) const;
+    inline FrozenEdgeRangeTy getFrozenInEdges(GEdgeKind kind) const;
     //@}
 
     /// Add incoming and outgoing edges
     //@{
     inline bool addIncomingEdge(EdgeType* inEdge)
     {
+        assert(!isFrozen() && "can not add an edge to a frozen graph, thaw it first");
         return InEdges.insert(inEdge).second;
     }
     inline bool addOutgoingEdge(EdgeType* outEdge)
     {
+        assert(!isFrozen() && "can not add an edge to a frozen graph, thaw it first");
         return OutEdges.insert(outEdge).second;
     }
     //@}
@@ -284,6 +605,7 @@ public:
     ///@{
     inline u32_t removeIncomingEdge(EdgeType* edge)
     {
+        assert(!isFrozen() && "can not remove an edge from a frozen graph, thaw it first");
         iterator it = InEdges.find(edge);
         assert(it != InEdges.end() && "can not find in edge in SVFG node");
         InEdges.erase(it);
@@ -291,6 +613,7 @@ public:
     }
     inline u32_t removeOutgoingEdge(EdgeType* edge)
     {
+        assert(!isFrozen() && "can not remove an edge from a frozen graph, thaw it first");
         iterator it = OutEdges.find(edge);
         assert(it != OutEdges.end() && "can not find out edge in SVFG node");
         OutEdges.erase(it);
@@ -302,16 +625,16 @@ public:
     //@{
     inline EdgeType* hasIncomingEdge(EdgeType* edge) const
     {
-        const_iterator it = InEdges.find(edge);
-        if (it != InEdges.end())
+        const_iterator it = inEdgeSet().find(edge);
+        if (it != inEdgeSet().end())
             return *it;
         else
             return nullptr;
     }
     inline EdgeType* hasOutgoingEdge(EdgeType* edge) const
     {
-        const_iterator it = OutEdges.find(edge);
-        if (it != OutEdges.end())
+        const_iterator it = outEdgeSet().find(edge);
+        if (it != outEdgeSet().end())
             return *it;
         else
             return nullptr;
@@ -338,12 +661,15 @@ class GenericGraph
 {
     friend class GenericGraphWriter<NodeTy, EdgeTy>;
     friend class GenericGraphReader<NodeTy, EdgeTy>;
+    friend class GenericNode<NodeTy, EdgeTy>;
 
 public:
     typedef NodeTy NodeType;
     typedef EdgeTy EdgeType;
     /// NodeID to GenericNode map
-    typedef OrderedMap<NodeID, NodeType*> IDToNodeMapTy;
+    typedef DenseNodeMap<NodeType> IDToNodeMapTy;
+    typedef FrozenEdgeRange<EdgeType> FrozenEdgeRangeTy;
+    typedef typename EdgeType::GEdgeKind GEdgeKind;
 
     /// Node Iterators
     //@{
@@ -363,6 +689,7 @@ public:
     /// Release memory
     void destroy()
     {
+        thaw();
         for (auto &entry : IDToNodeMap)
             delete entry.second;
     }
@@ -389,28 +716,29 @@ public:
     /// Add a Node
     inline void addGNode(NodeID id, NodeType* node)
     {
-        IDToNodeMap[id] = node;
+        assert(!frozen && "can not add a node to a frozen graph, thaw it first");
+        IDToNodeMap.set(id, node);
         nodeNum++;
     }
 
     /// Get a node
     inline NodeType* getGNode(NodeID id) const
     {
-        const_iterator it = IDToNodeMap.find(id);
-        assert(it != IDToNodeMap.end() && "Node not found!");
-        return it->second;
+        NodeType* node = IDToNodeMap.lookup(id);
+        assert(node && "Node not found!");
+        return node;
     }
 
     /// Has a node
     inline bool hasGNode(NodeID id) const
     {
-        const_iterator it = IDToNodeMap.find(id);
-        return it != IDToNodeMap.end();
+        return IDToNodeMap.lookup(id) != nullptr;
     }
 
     /// Delete a node
     inline void removeGNode(NodeType* node)
     {
+        assert(!frozen && "can not remove a node from a frozen graph, thaw it first");
         assert(node->hasIncomingEdge() == false
                && node->hasOutgoingEdge() == false
                && "node which have edges can't be deleted");
@@ -439,14 +767,213 @@ public:
         edgeNum++;
     }
 
+    /// Compact mode.
+    /// Once a graph is built, freeze() lays the in/out edges of all nodes out in
+    /// contiguous (CSR) arrays, with the edges of each node grouped by kind, and
+    /// releases the edge sets of the nodes. Solvers which only traverse the graph
+    /// iterate the arrays through GenericNode::getFrozenOutEdges/getFrozenInEdges.
+    /// The edge sets of a node are rebuilt from the arrays when they are accessed
+    /// while frozen, and those of all nodes by thaw().
+    /// Nodes and edges can not be added or removed until the graph is thawed.
+    //@{
+    void freeze()
+    {
+        if (frozen)
+            return;
+
+        edgeMemBeforeFreeze = getEdgeMemoryUsage();
+
+        size_t numOfOutEdges = 0, numOfInEdges = 0;
+        for (const auto& entry : IDToNodeMap)
+        {
+            numOfOutEdges += entry.second->getOutEdges().size();
+            numOfInEdges += entry.second->getInEdges().size();
+        }
+        frozenOutOffsets.reserve(IDToNodeMap.size() + 1);
+        frozenInOffsets.reserve(IDToNodeMap.size() + 1);
+        frozenOutEdges.reserve(numOfOutEdges);
+        frozenInEdges.reserve(numOfInEdges);
+
+        u32_t idx = 0;
+        for (const auto& entry : IDToNodeMap)
+        {
+            GenericNode<NodeTy, EdgeTy>* node = entry.second;
+            frozenOutOffsets.push_back(frozenOutEdges.size());
+            frozenInOffsets.push_back(frozenInEdges.size());
+            appendByKind(node->getOutEdges(), frozenOutEdges);
+            appendByKind(node->getInEdges(), frozenInEdges);
+            node->frozenGraph = this;
+            node->frozenIdx = idx++;
+            typename GenericNode<NodeTy, EdgeTy>::GEdgeSetTy().swap(node->OutEdges);
+            typename GenericNode<NodeTy, EdgeTy>::GEdgeSetTy().swap(node->InEdges);
+            node->edgeSetsReleased.store(true, std::memory_order_release);
+        }
+        frozenOutOffsets.push_back(frozenOutEdges.size());
+        frozenInOffsets.push_back(frozenInEdges.size());
+
+        frozen = true;
+        edgeMemAfterFreeze = getEdgeMemoryUsage();
+    }
+
+    void thaw()
+    {
+        if (!frozen)
+            return;
+
+        // Edge sets restored while frozen count against the compact mode.
+        edgeMemAfterFreeze = getEdgeMemoryUsage();
+
+        for (const auto& entry : IDToNodeMap)
+        {
+            GenericNode<NodeTy, EdgeTy>* node = entry.second;
+            if (node->edgeSetsReleased.load(std::memory_order_acquire))
+                node->restoreEdgeSets();
+            node->frozenGraph = nullptr;
+        }
+        std::vector<u32_t>().swap(frozenOutOffsets);
+        std::vector<u32_t>().swap(frozenInOffsets);
+        std::vector<EdgeType*>().swap(frozenOutEdges);
+        std::vector<EdgeType*>().swap(frozenInEdges);
+
+        frozen = false;
+    }
+
+    inline bool isFrozen() const
+    {
+        return frozen;
+    }
+
+    /// Approximate bytes taken by the edge sets of all nodes and the compact arrays
+    u64_t getEdgeMemoryUsage() const
+    {
+        // An OrderedSet entry is a tree node: colour, three links and the edge.
+        const u64_t setEntryBytes = 4 * sizeof(void*) + sizeof(EdgeType*);
+        u64_t numOfSetEntries = 0;
+        for (const auto& entry : IDToNodeMap)
+        {
+            const GenericNode<NodeTy, EdgeTy>* node = entry.second;
+            numOfSetEntries += node->InEdges.size() + node->OutEdges.size();
+        }
+        return numOfSetEntries * setEntryBytes
+               + (frozenOutOffsets.capacity() + frozenInOffsets.capacity()) * sizeof(u32_t)
+               + (frozenOutEdges.capacity() + frozenInEdges.capacity()) * sizeof(EdgeType*);
+    }
+    /// Edge memory (see getEdgeMemoryUsage) right before the last freeze, and at
+    /// the end of its frozen period, including the edge sets restored meanwhile
+    /// (right after the freeze until the graph is thawed)
+    //@{
+    inline u64_t getEdgeMemBeforeFreeze() const
+    {
+        return edgeMemBeforeFreeze;
+    }
+    inline u64_t getEdgeMemAfterFreeze() const
+    {
+        return edgeMemAfterFreeze;
+    }
+    //@}
+    //@}
+
+private:
+    /// Append edges to array, ordered by kind (and by the edge set order within a kind)
+    template <class EdgeSetTy>
+    static inline void appendByKind(const EdgeSetTy& edges, std::vector<EdgeType*>& array)
+    {
+        size_t start = array.size();
+        array.insert(array.end(), edges.begin(), edges.end());
+        std::stable_sort(array.begin() + start, array.end(), [](const EdgeType* lhs, const EdgeType* rhs)
+        {
+            return lhs->getEdgeKind() < rhs->getEdgeKind();
+        });
+    }
+
+    /// Sub-range of the edges of kind in a range ordered by kind
+    static inline FrozenEdgeRangeTy kindRange(const FrozenEdgeRangeTy& edges, GEdgeKind kind)
+    {
+        typename FrozenEdgeRangeTy::iterator lo = std::lower_bound(edges.begin(), edges.end(), kind,
+                [](const EdgeType* edge, GEdgeKind k)
+        {
+            return edge->getEdgeKind() < k;
+        });
+        typename FrozenEdgeRangeTy::iterator hi = std::upper_bound(lo, edges.end(), kind,
+                [](GEdgeKind k, const EdgeType* edge)
+        {
+            return k < edge->getEdgeKind();
+        });
+        return FrozenEdgeRangeTy(lo, hi);
+    }
+
+    inline FrozenEdgeRangeTy frozenOutRange(u32_t idx) const
+    {
+        return FrozenEdgeRangeTy(frozenOutEdges.data() + frozenOutOffsets[idx],
+                                 frozenOutEdges.data() + frozenOutOffsets[idx + 1]);
+    }
+    inline FrozenEdgeRangeTy frozenInRange(u32_t idx) const
+    {
+        return FrozenEdgeRangeTy(frozenInEdges.data() + frozenInOffsets[idx],
+                                 frozenInEdges.data() + frozenInOffsets[idx + 1]);
+    }
+
 protected:
     IDToNodeMapTy IDToNodeMap; ///< node map
 
 public:
     u32_t edgeNum;		///< total num of node
     u32_t nodeNum;		///< total num of edge
+
+private:
+    bool frozen = false;    ///< whether the compact arrays below are in use
+    std::vector<u32_t> frozenOutOffsets;    ///< node index --> start of its out edges in frozenOutEdges (plus the end)
+    std::vector<u32_t> frozenInOffsets;     ///< node index --> start of its in edges in frozenInEdges (plus the end)
+    std::vector<EdgeType*> frozenOutEdges;  ///< out edges of all nodes, node by node
+    std::vector<EdgeType*> frozenInEdges;   ///< in edges of all nodes, node by node
+    mutable std::mutex edgeSetsLock;        ///< serialises rebuilding edge sets while frozen
+    u64_t edgeMemBeforeFreeze = 0;
+    u64_t edgeMemAfterFreeze = 0;
 };
 
+/*!
+ * Rebuild the edge sets released by freezing from the compact arrays. Nodes of
+ * a frozen graph may be read concurrently, so this is serialised per graph.
+ */
+template<class NodeTy, class EdgeTy>
+void GenericNode<NodeTy, EdgeTy>::restoreEdgeSets() const
+{
+    std::lock_guard<std::mutex> guard(frozenGraph->edgeSetsLock);
+    if (!edgeSetsReleased.load(std::memory_order_relaxed))
+        return;
+    FrozenEdgeRangeTy inEdges = getFrozenInEdges();
+    InEdges.insert(inEdges.begin(), inEdges.end());
+    FrozenEdgeRangeTy outEdges = getFrozenOutEdges();
+    OutEdges.insert(outEdges.begin(), outEdges.end());
+    edgeSetsReleased.store(false, std::memory_order_release);
+}
+
+template<class NodeTy, class EdgeTy>
+inline typename GenericNode<NodeTy, EdgeTy>::FrozenEdgeRangeTy GenericNode<NodeTy, EdgeTy>::getFrozenOutEdges() const
+{
+    assert(isFrozen() && "graph of this node is not frozen!");
+    return frozenGraph->frozenOutRange(frozenIdx);
+}
+
+template<class NodeTy, class EdgeTy>
+inline typename GenericNode<NodeTy, EdgeTy>::FrozenEdgeRangeTy GenericNode<NodeTy, EdgeTy>::getFrozenInEdges() const
+{
+    assert(isFrozen() && "graph of this node is not frozen!");
+    return frozenGraph->frozenInRange(frozenIdx);
+}
+
+template<class NodeTy, class EdgeTy>
+inline typename GenericNode<NodeTy, EdgeTy>::FrozenEdgeRangeTy GenericNode<NodeTy, EdgeTy>::getFrozenOutEdges(GEdgeKind kind) const
+{
+    return GenericGraph<NodeTy, EdgeTy>::kindRange(getFrozenOutEdges(), kind);
+}
+
+template<class NodeTy, class EdgeTy>
+inline typename GenericNode<NodeTy, EdgeTy>::FrozenEdgeRangeTy GenericNode<NodeTy, EdgeTy>::getFrozenInEdges(GEdgeKind kind) const
+{
+    return GenericGraph<NodeTy, EdgeTy>::kindRange(getFrozenInEdges(), kind);
+}
+
 } // End namespace SVF
 
 /* !
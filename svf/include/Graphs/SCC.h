@@ -41,15 +41,15 @@
 #define SCC_H_
 
 #include "SVFIR/SVFValue.h"	// for NodeBS
+#include "Util/DenseIDMap.h"
+#include <algorithm>
 #include <limits.h>
 #include <stack>
-#include <map>
+#include <vector>
 
 namespace SVF
 {
 
-class GNodeSCCInfo;
-
 template<class GraphType>
 class SCCDetection
 {
@@ -65,57 +65,6 @@ private:
 public:
     typedef std::stack<NodeID> GNodeStack;
 
-    class GNodeSCCInfo
-    {
-    public:
-        GNodeSCCInfo() : _visited(false), _inSCC(false), _rep(UINT_MAX) {}
-
-        inline bool visited(void) const
-        {
-            return _visited;
-        }
-        inline void visited(bool v)
-        {
-            _visited = v;
-        }
-        inline bool inSCC(void)   const
-        {
-            return _inSCC;
-        }
-        inline void inSCC(bool v)
-        {
-            _inSCC = v;
-        }
-        inline NodeID rep(void)const
-        {
-            return _rep;
-        }
-        inline void rep(NodeID n)
-        {
-            _rep = n;
-        }
-        inline void addSubNodes(NodeID n)
-        {
-            _subNodes.set(n);
-        }
-        inline NodeBS& subNodes()
-        {
-            return _subNodes;
-        }
-        inline const NodeBS& subNodes() const
-        {
-            return _subNodes;
-        }
-    private:
-        bool     _visited;
-        bool     _inSCC;
-        NodeID  _rep;
-        NodeBS _subNodes; /// nodes in the scc represented by this node
-    };
-
-    typedef Map<NodeID,GNodeSCCInfo > GNODESCCInfoMap;
-    typedef Map<NodeID, NodeID> NodeToNodeMap;
-
     SCCDetection(const GraphType &GT)
         : _graph(GT),
           _I(0)
@@ -151,17 +100,11 @@ public:
         return revTopoOrder;
     }
 
-    const inline GNODESCCInfoMap &GNodeSCCInfo() const
-    {
-        return _NodeSCCAuxInfo;
-    }
-
     /// get the rep node if not found return itself
     inline NodeID repNode(NodeID n) const
     {
-        typename GNODESCCInfoMap::const_iterator it = _NodeSCCAuxInfo.find(n);
-        assert(it!=_NodeSCCAuxInfo.end() && "scc rep not found");
-        NodeID rep = it->second.rep();
+        assert(isVisited(n) && "scc rep not found");
+        NodeID rep = _state.lookup(n).rep;
         return rep!= UINT_MAX ? rep : n ;
     }
 
@@ -193,9 +136,8 @@ public:
     /// get all subnodes in one scc, if size is empty insert itself into the set
     inline const NodeBS& subNodes(NodeID n)  const
     {
-        typename GNODESCCInfoMap::const_iterator it = _NodeSCCAuxInfo.find(n);
-        assert(it!=_NodeSCCAuxInfo.end() && "scc rep not found");
-        return it->second.subNodes();
+        assert(isVisited(n) && "scc rep not found");
+        return _state.lookup(n).subNodes;
     }
 
     /// get all repNodeID
@@ -209,54 +151,55 @@ public:
         return _graph;
     }
 private:
+    /// A node whose children are being visited, replacing a frame of the
+    /// recursive formulation.
+    struct VisitFrame
+    {
+        NodeID v;
+        child_iterator EI;
+        child_iterator EE;
 
-    GNODESCCInfoMap  _NodeSCCAuxInfo;
+        VisitFrame(NodeID n, child_iterator begin, child_iterator end) : v(n), EI(begin), EE(end) {}
+    };
+
+    /// Per node state
+    struct NodeState
+    {
+        NodeID D{0};            ///< visiting order, 0 if not visited
+        NodeID rep{UINT_MAX};   ///< rep node, UINT_MAX if none
+        bool inSCC{false};      ///< whether the SCC of the node has been found
+        NodeBS subNodes;        ///< nodes in the scc represented by this node
+    };
+
+    /// Per node state, indexed by node ID. It only grows, and only the states of
+    /// the nodes visited by the last detection are reset, so it is reused by
+    /// repeated detections on the same graph.
+    DenseIDMap<NodeState> _state;
+    std::vector<NodeID> _visitedNodes;
+    std::vector<VisitFrame> _visitStack;
 
     const GraphType &           _graph;
     NodeID                   _I;
-    NodeToNodeMap            _D;
     GNodeStack             _SS;
     GNodeStack             _T;
     NodeBS repNodes;
 
-    inline bool visited(NodeID n)
-    {
-        return _NodeSCCAuxInfo[n].visited();
-    }
-    inline bool inSCC(NodeID n)
-    {
-        return _NodeSCCAuxInfo[n].inSCC();
-    }
-
-    inline void setVisited(NodeID n,bool v)
-    {
-        _NodeSCCAuxInfo[n].visited(v);
-    }
-    inline void setInSCC(NodeID n,bool v)
+    inline bool isVisited(NodeID n) const
     {
-        _NodeSCCAuxInfo[n].inSCC(v);
+        return _state.lookup(n).D != 0;
     }
     inline void rep(NodeID n, NodeID r)
     {
-        _NodeSCCAuxInfo[n].rep(r);
-        _NodeSCCAuxInfo[r].addSubNodes(n);
+        _state[n].rep = r;
+        _state[r].subNodes.set(n);
         if (n != r)
         {
-            _NodeSCCAuxInfo[n].subNodes().clear();
+            _state[n].subNodes.clear();
             repNodes.reset(n);
             repNodes.set(r);
         }
     }
 
-    inline NodeID rep(NodeID n)
-    {
-        return _NodeSCCAuxInfo[n].rep();
-    }
-    inline bool isInSCC(NodeID n)
-    {
-        return _NodeSCCAuxInfo[n].inSCC();
-    }
-
     inline GNODE Node(NodeID id) const
     {
         return GTraits::getNode(_graph, id);
@@ -267,43 +210,45 @@ private:
         return GTraits::getNodeID(node);
     }
 
-    void visit(NodeID v)
+    /// Number v and start visiting its children
+    inline void enter(NodeID v)
     {
-        // SVFUtil::outs() << "visit GNODE: " << Node_Index(v)<< "\n";
         _I += 1;
-        _D[v] = _I;
+        _state[v].D = _I;
+        _visitedNodes.push_back(v);
         this->rep(v,v);
-        this->setVisited(v,true);
 
-        child_iterator EI = GTraits::direct_child_begin(Node(v));
-        child_iterator EE = GTraits::direct_child_end(Node(v));
+        GNODE node = Node(v);
+        _visitStack.emplace_back(v, GTraits::direct_child_begin(node), GTraits::direct_child_end(node));
+    }
 
-        for (; EI != EE; ++EI)
+    /// Child w of v has been visited
+    inline void visitedChild(NodeID v, NodeID w)
+    {
+        if (!_state.lookup(w).inSCC)
         {
-            NodeID w = Node_Index(*EI);
-
-            if (!this->visited(w))
-                visit(w);
-            if (!this->inSCC(w))
-            {
-                NodeID rep;
-                rep = _D[this->rep(v)] < _D[this->rep(w)] ?
-                      this->rep(v) : this->rep(w);
-                this->rep(v,rep);
-            }
+            NodeID repV = _state.lookup(v).rep;
+            NodeID repW = _state.lookup(w).rep;
+            this->rep(v, _state.lookup(repV).D < _state.lookup(repW).D ? repV : repW);
         }
-        if (this->rep(v) == v)
+    }
+
+    /// All children of v have been visited
+    inline void leave(NodeID v)
+    {
+        if (_state.lookup(v).rep == v)
         {
-            this->setInSCC(v,true);
+            NodeID D = _state.lookup(v).D;
+            _state[v].inSCC = true;
             while (!_SS.empty())
             {
                 NodeID w = _SS.top();
-                if (_D[w] <= _D[v])
+                if (_state.lookup(w).D <= D)
                     break;
                 else
                 {
                     _SS.pop();
-                    this->setInSCC(w,true);
+                    _state[w].inSCC = true;
                     this->rep(w,v);
                 }
             }
@@ -313,11 +258,53 @@ private:
             _SS.push(v);
     }
 
+    /// Depth-first visit from root, with an explicit stack so deep graphs
+    /// (e.g., long copy chains) cannot overflow the call stack
+    void visit(NodeID root)
+    {
+        enter(root);
+        while (!_visitStack.empty())
+        {
+            VisitFrame& frame = _visitStack.back();
+            if (frame.EI != frame.EE)
+            {
+                NodeID w = Node_Index(*frame.EI);
+                if (!isVisited(w))
+                {
+                    // frame is invalidated; resumed once w has been left.
+                    enter(w);
+                    continue;
+                }
+                visitedChild(frame.v, w);
+                ++frame.EI;
+            }
+            else
+            {
+                NodeID v = frame.v;
+                _visitStack.pop_back();
+                leave(v);
+                if (!_visitStack.empty())
+                {
+                    VisitFrame& parent = _visitStack.back();
+                    visitedChild(parent.v, v);
+                    ++parent.EI;
+                }
+            }
+        }
+    }
+
     void clear()
     {
-        _NodeSCCAuxInfo.clear();
+        for (NodeID n : _visitedNodes)
+        {
+            NodeState& state = _state[n];
+            state.D = 0;
+            state.rep = UINT_MAX;
+            state.inSCC = false;
+            state.subNodes.clear();
+        }
+        _visitedNodes.clear();
         _I = 0;
-        _D.clear();
         repNodes.clear();
         while(!_SS.empty())
             _SS.pop();
@@ -336,19 +323,10 @@ public:
         for (; I != E; ++I)
         {
             NodeID node = Node_Index(*I);
-            if (!this->visited(node))
-            {
-                // We skip any nodes that have a representative other than
-                // themselves.  Such nodes occur as a result of merging
-                // nodes either through unifying an ACC or other node
-                // merging optimizations.  Any such node should have no
-                // outgoing edges and therefore should no longer be a member
-                // of an SCC.
-                if (this->rep(node) == UINT_MAX || this->rep(node) == node)
-                    visit(node);
-                else
-                    this->visited(node);
-            }
+            // Nodes merged into a rep by an earlier visit of this detection
+            // have been visited as well.
+            if (!isVisited(node))
+                visit(node);
         }
     }
 
@@ -358,13 +336,8 @@ public:
         clear();
         for (NodeID node : candidates)
         {
-            if (!this->visited(node))
-            {
-                if (this->rep(node) == UINT_MAX || this->rep(node) == node)
-                    visit(node);
-                else
-                    this->visited(node);
-            }
+            if (!isVisited(node))
+                visit(node);
         }
     }
 
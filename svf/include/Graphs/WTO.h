@@ -723,6 +723,12 @@ protected:
     inline virtual std::vector<const NodeT *> getSuccessors(const NodeT* node)
     {
         std::vector<const NodeT *> succssors;
+        if (node->isFrozen())
+        {
+            for (const EdgeT* e : node->getFrozenOutEdges())
+                succssors.push_back(e->getDstNode());
+            return succssors;
+        }
         for (const auto& e : node->getOutEdges())
         {
             succssors.push_back(e->getDstNode());
@@ -0,0 +1,164 @@
+//===- BinaryPtsFile.h -- Memory-mappable points-to result file ------------//
+
+/*
+ * BinaryPtsFile.h
+ *
+ * Versioned binary format for storing pointer analysis results which can be
+ * memory mapped and queried lazily.
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef BINARYPTSFILE_H_
+#define BINARYPTSFILE_H_
+
+#include <string>
+#include <vector>
+
+#include "MemoryModel/PointsTo.h"
+#include "SVFIR/SVFType.h"
+
+namespace SVF
+{
+
+/// Binary counterpart of the text format written by BVDataPTAImpl::writeToFile.
+/// The file is a fixed-size header followed by 8-byte aligned sections:
+///   - node table:      sorted IDs of the variables with a non-empty points-to set,
+///   - var->set index:  for each entry of the node table, the index of its points-to set,
+///   - set offsets:     numSets + 1 offsets into the pool (set i is [off[i], off[i+1])),
+///   - set pool:        sorted elements of all unique points-to sets, back to back,
+///   - gep table:       (base, offset, ID) of every gep object,
+///   - FI bitmap:       field-insensitivity of base objects, one bit per node ID.
+/// Identical points-to sets are stored once. Readers map the file and only touch the
+/// pages of the sets they query.
+class BinaryPtsFile
+{
+public:
+    static const char Magic[8];
+    static const u32_t Version;
+
+    /// Gep object entry of the gep table.
+    struct GepObj
+    {
+        NodeID base;
+        NodeID id;
+        APOffset offset;
+    };
+
+    /// File header, at offset 0. Offsets are in bytes from the start of the file.
+    struct Header
+    {
+        char magic[8];
+        u32_t version;
+        u32_t reserved;
+        u64_t numVars;
+        u64_t numSets;
+        u64_t numPoolElems;
+        u64_t numGepObjs;
+        u64_t numFIWords;
+        u64_t nodeTableOffset;
+        u64_t varSetOffset;
+        u64_t setOffsetsOffset;
+        u64_t poolOffset;
+        u64_t gepTableOffset;
+        u64_t fiBitmapOffset;
+    };
+
+    /// Writes a binary points-to file in one go.
+    class Writer
+    {
+    public:
+        /// Record the points-to set of var. Empty sets are not stored.
+        void addPts(NodeID var, const PointsTo& pts);
+        /// Record a gep object.
+        void addGepObj(NodeID base, APOffset offset, NodeID id);
+        /// Record that base object is field-insensitive.
+        void setFieldInsensitive(NodeID base);
+        /// Write everything recorded to filename. Returns false on I/O error.
+        bool write(const std::string& filename) const;
+
+    private:
+        std::vector<std::pair<NodeID, u32_t>> varToSet;
+        Map<PointsTo, u32_t> setToIdx;
+        std::vector<const PointsTo*> sets;
+        std::vector<GepObj> gepObjs;
+        std::vector<u64_t> fiBitmap;
+    };
+
+    BinaryPtsFile() = default;
+    ~BinaryPtsFile();
+
+    BinaryPtsFile(const BinaryPtsFile&) = delete;
+    BinaryPtsFile& operator=(const BinaryPtsFile&) = delete;
+
+    /// Returns true if filename starts with the magic of this format.
+    static bool isBinaryPtsFile(const std::string& filename);
+
+    /// Map filename read-only and validate its header. Returns false on failure.
+    bool open(const std::string& filename);
+
+    /// Number of variables with a stored points-to set.
+    inline u64_t getNumVars() const
+    {
+        return header()->numVars;
+    }
+
+    /// Number of unique points-to sets.
+    inline u64_t getNumSets() const
+    {
+        return header()->numSets;
+    }
+
+    /// ID of the i-th variable of the node table.
+    inline NodeID getVar(u64_t i) const
+    {
+        return nodeTable()[i];
+    }
+
+    /// Fill pts with the stored points-to set of var.
+    /// Returns false (leaving pts untouched) if nothing is stored for var.
+    bool getPts(NodeID var, PointsTo& pts) const;
+
+    /// Gep table.
+    ///@{
+    inline u64_t getNumGepObjs() const
+    {
+        return header()->numGepObjs;
+    }
+    inline const GepObj& getGepObj(u64_t i) const
+    {
+        return gepTable()[i];
+    }
+    ///@}
+
+    /// Field-insensitive base objects.
+    void getFieldInsensitiveObjs(std::vector<NodeID>& objs) const;
+
+private:
+    inline const Header* header() const
+    {
+        return reinterpret_cast<const Header*>(data);
+    }
+    template <typename T>
+    inline const T* section(u64_t offset) const
+    {
+        return reinterpret_cast<const T*>(data + offset);
+    }
+    inline const NodeID* nodeTable() const
+    {
+        return section<NodeID>(header()->nodeTableOffset);
+    }
+    inline const GepObj* gepTable() const
+    {
+        return section<GepObj>(header()->gepTableOffset);
+    }
+
+    void close();
+
+    const char* data = nullptr;
+    u64_t size = 0;
+};
+
+} // End namespace SVF
+
+#endif /* BINARYPTSFILE_H_ */
@@ -109,6 +109,22 @@ public:
         return unionPts(ptsMap[dstKey], srcDataSet);
     }
 
+    /// Union for concurrent solvers: only updates the points-to set of dstKey, which
+    /// must already exist (e.g., through getPts). Callers must serialise unions into the
+    /// same key and record the reverse points-to afterwards with addRevPts.
+    inline bool unionPtsNoRev(const Key& dstKey, const DataSet& srcDataSet)
+    {
+        PtsMapIter it = ptsMap.find(dstKey);
+        assert(it != ptsMap.end() && "MutablePTData::unionPtsNoRev: points-to set not created!");
+        return unionPts(it->second, srcDataSet);
+    }
+
+    /// Record dstKey in the reverse points-to of every element of srcDataSet.
+    inline void addRevPts(const Key& dstKey, const DataSet& srcDataSet)
+    {
+        addRevPts(srcDataSet, dstKey);
+    }
+
     virtual inline void dumpPTData() override
     {
         dumpPts(ptsMap);
@@ -274,6 +290,18 @@ public:
         return mutPTData.unionPts(dstKey, srcDataSet);
     }
 
+    /// See MutablePTData::unionPtsNoRev and MutablePTData::addRevPts.
+    ///@{
+    inline bool unionPtsNoRev(const Key& dstKey, const DataSet& srcDataSet)
+    {
+        return mutPTData.unionPtsNoRev(dstKey, srcDataSet);
+    }
+    inline void addRevPts(const Key& dstKey, const DataSet& srcDataSet)
+    {
+        mutPTData.addRevPts(dstKey, srcDataSet);
+    }
+    ///@}
+
     virtual void clearPts(const Key& var, const Data& element) override
     {
         mutPTData.clearPts(var, element);
@@ -461,6 +489,14 @@ public:
     }
     ///@}
 
+    /// Create the (empty) IN/OUT entries of loc. Solvers working concurrently on
+    /// different locations then only ever look up existing entries.
+    virtual inline void initLoc(LocID loc)
+    {
+        dfInPtsMap[loc];
+        dfOutPtsMap[loc];
+    }
+
     virtual inline bool updateDFInFromIn(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
     {
         return this->unionPts(getDFInPtsSet(dstLoc,dstVar), getDFInPtsSet(srcLoc,srcVar));
@@ -800,6 +836,13 @@ public:
         return false;
     }
 
+    virtual inline void initLoc(LocID loc) override
+    {
+        BaseMutDFPTData::initLoc(loc);
+        inUpdatedVarMap[loc];
+        outUpdatedVarMap[loc];
+    }
+
     virtual inline void clearAllDFOutUpdatedVar(LocID loc) override
     {
         if (this->hasDFOutSet(loc))
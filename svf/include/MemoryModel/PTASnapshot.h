@@ -0,0 +1,127 @@
+//===- PTASnapshot.h -- Read-only snapshot of pointer analysis results -----//
+
+/*
+ * PTASnapshot.h
+ *
+ * Immutable, compact copy of solved points-to sets which client analyses can
+ * query from many threads without synchronisation.
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PTASNAPSHOT_H_
+#define PTASNAPSHOT_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "SVFIR/SVFType.h"
+
+namespace SVF
+{
+
+class BVDataPTAImpl;
+
+/// Snapshot of the points-to sets of a solved BVDataPTAImpl (see BVDataPTAImpl::snapshot).
+/// Points-to sets are stored once per distinct set, back to back in one pool, with their
+/// elements sorted and already mapped back to node IDs:
+///   - ptrIds:      sorted IDs of the nodes with non-empty points-to sets (node IDs may be
+///                  sparse, so they are not used as indices),
+///   - ptrSets:     for each of ptrIds, the index of its points-to set (0 is the empty set),
+///   - setOffsets:  numSets + 1 offsets into the pool (set i is [off[i], off[i+1])),
+///   - expandedSet: for each set, the index of the set with its field-insensitive objects
+///                  expanded to all their fields (as alias queries need).
+/// Nothing is mutated after construction, so all queries are const and lock-free.
+class PTASnapshot
+{
+public:
+    /// Sorted targets of a points-to set. Valid as long as the snapshot is.
+    class PtsRange
+    {
+    public:
+        PtsRange(const NodeID* b, const NodeID* e): b(b), e(e) {}
+
+        inline const NodeID* begin() const
+        {
+            return b;
+        }
+        inline const NodeID* end() const
+        {
+            return e;
+        }
+        inline u32_t size() const
+        {
+            return e - b;
+        }
+        inline bool empty() const
+        {
+            return b == e;
+        }
+        /// Binary search for n
+        bool test(NodeID n) const;
+        /// Whether this and rhs share an element
+        bool intersects(const PtsRange& rhs) const;
+
+    private:
+        const NodeID* b;
+        const NodeID* e;
+    };
+
+    /// Copy the points-to sets of all SVFIR nodes of pta
+    explicit PTASnapshot(BVDataPTAImpl* pta);
+
+    PTASnapshot(const PTASnapshot&) = delete;
+    PTASnapshot& operator=(const PTASnapshot&) = delete;
+
+    /// Points-to set of ptr
+    inline PtsRange getPts(NodeID ptr) const
+    {
+        return getSetRange(getSet(ptr));
+    }
+
+    /// Whether ptr points to obj
+    inline bool pointsTo(NodeID ptr, NodeID obj) const
+    {
+        return getPts(ptr).test(obj);
+    }
+
+    /// Same answer as BVDataPTAImpl::alias on the analysis when snapshotted
+    AliasResult alias(NodeID node1, NodeID node2) const;
+
+    /// Statistics
+    //@{
+    inline u32_t getNumOfSets() const
+    {
+        return setOffsets.size() - 1;
+    }
+    inline u64_t getNumOfTargets() const
+    {
+        return pool.size();
+    }
+    /// Bytes taken by the snapshot
+    u64_t getMemoryUsage() const;
+    //@}
+
+private:
+    inline u32_t getSet(NodeID ptr) const
+    {
+        auto it = std::lower_bound(ptrIds.begin(), ptrIds.end(), ptr);
+        return it != ptrIds.end() && *it == ptr ? ptrSets[it - ptrIds.begin()] : 0;
+    }
+
+    inline PtsRange getSetRange(u32_t set) const
+    {
+        return PtsRange(pool.data() + setOffsets[set], pool.data() + setOffsets[set + 1]);
+    }
+
+    std::vector<NodeID> ptrIds;
+    std::vector<u32_t> ptrSets;
+    std::vector<u64_t> setOffsets;
+    std::vector<u32_t> expandedSet;
+    std::vector<NodeID> pool;
+    NodeID blackHole;
+};
+
+} // End namespace SVF
+
+#endif /* PTASNAPSHOT_H_ */
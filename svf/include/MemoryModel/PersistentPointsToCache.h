@@ -43,9 +43,10 @@ public:
     };
 
 public:
-    PersistentPointsToCache(void) : idCounter(1)
+    PersistentPointsToCache(void) : idCounter(1), liveAfterLastCollection(1)
     {
         idToPts.push_back(std::make_unique<Data>());
+        refCounts.push_back(0);
         ptsToId[Data()] = emptyPointsToId();
 
         initStats();
@@ -55,6 +56,8 @@ public:
     void clear()
     {
         idToPts.clear();
+        refCounts.clear();
+        freeIds.clear();
         ptsToId.clear();
 
         unionCache.clear();
@@ -70,8 +73,10 @@ public:
         // Put the empty data back in.
         ptsToId[Data()] = emptyPointsToId();
         idToPts.push_back(std::make_unique<Data>());
+        refCounts.push_back(0);
 
         idCounter = 1;
+        liveAfterLastCollection = 1;
         // Cache is empty...
         initStats();
     }
@@ -79,11 +84,17 @@ public:
     /// Remaps all points-to sets stored in the cache to the current mapping.
     void remapAllPts(void)
     {
-        for (auto &d : idToPts) d->checkAndRemap();
+        for (auto &d : idToPts)
+        {
+            if (d != nullptr) d->checkAndRemap();
+        }
 
         // Rebuild ptsToId from idToPts.
         ptsToId.clear();
-        for (PointsToID i = 0; i < idToPts.size(); ++i) ptsToId[*idToPts[i]] = i;
+        for (PointsToID i = 0; i < idToPts.size(); ++i)
+        {
+            if (idToPts[i] != nullptr) ptsToId[*idToPts[i]] = i;
+        }
     }
 
     /// If pts is not in the PersistentPointsToCache, inserts it, assigns an ID, and returns
@@ -95,21 +106,84 @@ public:
         if (foundId != ptsToId.end()) return foundId->second;
 
         // Otherwise, insert it.
-        PointsToID id = newPointsToId();
-        idToPts.push_back(std::make_unique<Data>(pts));
-        ptsToId[pts] = id;
-
-        return id;
+        return storeNewPts(pts);
     }
 
     /// Returns the points-to set which id represents. id must be stored in the cache.
     const Data &getActualPts(PointsToID id) const
     {
         // Check if the points-to set for ID has already been stored.
-        assert(idToPts.size() > id && "PPTC::getActualPts: points-to set not stored!");
+        assert(idToPts.size() > id && idToPts[id] != nullptr && "PPTC::getActualPts: points-to set not stored!");
         return *idToPts.at(id);
     }
 
+    /// Reference counting of points-to IDs, for holders which want unused points-to
+    /// sets to be garbage collected (see collectGarbage). Newly created sets start
+    /// with no references.
+    ///@{
+    inline void refPts(PointsToID id)
+    {
+        ++refCounts[id];
+    }
+    inline void unrefPts(PointsToID id)
+    {
+        assert(refCounts[id] > 0 && "PPTC::unrefPts: points-to set not referenced!");
+        --refCounts[id];
+    }
+    inline u32_t getRefCount(PointsToID id) const
+    {
+        return refCounts[id];
+    }
+    ///@}
+
+    /// Frees every points-to set without references and forgets the cached operations
+    /// involving them. Freed IDs are reused for new sets.
+    /// Only valid when *all* holders of IDs count their references, and only at points
+    /// where no reference to an unreferenced set (e.g., from getActualPts) is live.
+    /// Returns the number of sets freed.
+    size_t collectGarbage(void)
+    {
+        std::vector<bool> dead(idToPts.size(), false);
+        size_t numFreed = 0;
+        // The empty set is never freed.
+        for (PointsToID id = emptyPointsToId() + 1; id < idToPts.size(); ++id)
+        {
+            if (idToPts[id] == nullptr || refCounts[id] != 0) continue;
+            dead[id] = true;
+            ptsToId.erase(*idToPts[id]);
+            idToPts[id].reset();
+            freeIds.push_back(id);
+            ++numFreed;
+        }
+
+        if (numFreed != 0)
+        {
+            purgeOpCache(unionCache, dead);
+            purgeOpCache(complementCache, dead);
+            purgeOpCache(intersectionCache, dead);
+        }
+
+        ++numCollections;
+        numCollectedPts += numFreed;
+        liveAfterLastCollection = getNumLivePts();
+        return numFreed;
+    }
+
+    /// Runs collectGarbage once the number of stored sets has doubled since the last
+    /// collection, so that collection costs amortised constant time per created set.
+    /// Same requirements as collectGarbage.
+    size_t maybeCollectGarbage(void)
+    {
+        if (getNumLivePts() < 2 * liveAfterLastCollection) return 0;
+        return collectGarbage();
+    }
+
+    /// Number of points-to sets currently stored.
+    inline size_t getNumLivePts(void) const
+    {
+        return idToPts.size() - freeIds.size();
+    }
+
     /// Unions lhs and rhs and returns their union's ID.
     PointsToID unionPts(PointsToID lhs, PointsToID rhs)
     {
@@ -315,7 +389,9 @@ public:
         static const unsigned fieldWidth = 25;
         SVFUtil::outs().flags(std::ios::left);
 
-        SVFUtil::outs() << std::setw(fieldWidth) << "UniquePointsToSets"      << idToPts.size()          << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "UniquePointsToSets"      << getNumLivePts()         << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "GarbageCollections"      << numCollections          << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "CollectedPointsToSets"   << numCollectedPts         << "\n";
 
         SVFUtil::outs() << std::setw(fieldWidth) << "TotalUnions"             << totalUnions             << "\n";
         SVFUtil::outs() << std::setw(fieldWidth) << "PropertyUnions"          << propertyUnions          << "\n";
@@ -345,12 +421,13 @@ public:
     Map<Data, unsigned> getAllPts(void)
     {
         Map<Data, unsigned> allPts;
-        for (const auto &d : idToPts) allPts[*d] = 1;
+        for (const auto &d : idToPts)
+        {
+            if (d != nullptr) allPts[*d] = 1;
+        }
         return allPts;
     }
 
-    // TODO: ref count API for garbage collection.
-
 private:
     PointsToID newPointsToId(void)
     {
@@ -359,6 +436,37 @@ private:
         return idCounter++;
     }
 
+    /// Interns pts, which must not be stored yet, reusing a garbage collected ID if possible.
+    PointsToID storeNewPts(const Data &pts)
+    {
+        PointsToID id;
+        if (!freeIds.empty())
+        {
+            id = freeIds.back();
+            freeIds.pop_back();
+            idToPts[id] = std::make_unique<Data>(pts);
+        }
+        else
+        {
+            id = newPointsToId();
+            idToPts.push_back(std::make_unique<Data>(pts));
+            refCounts.push_back(0);
+        }
+
+        ptsToId[pts] = id;
+        return id;
+    }
+
+    /// Removes every cached operation whose operands or result are dead.
+    static void purgeOpCache(OpCache &opCache, const std::vector<bool> &dead)
+    {
+        for (typename OpCache::iterator it = opCache.begin(); it != opCache.end();)
+        {
+            if (dead[it->first.first] || dead[it->first.second] || dead[it->second]) it = opCache.erase(it);
+            else ++it;
+        }
+    }
+
     /// Performs dataOp on lhs and rhs, checking the opCache first and updating it afterwards.
     /// commutative indicates whether the operation in question is commutative or not.
     /// opPerformed is set to true if the operation was *not* cached and thus performed, false otherwise.
@@ -386,12 +494,7 @@ private:
         // Intern points-to set: check if result already exists.
         typename PTSToIDMap::const_iterator foundId = ptsToId.find(result);
         if (foundId != ptsToId.end()) resultId = foundId->second;
-        else
-        {
-            resultId = newPointsToId();
-            idToPts.push_back(std::make_unique<Data>(result));
-            ptsToId[result] = resultId;
-        }
+        else resultId = storeNewPts(result);
 
         // Cache the result, for hash-consing.
         opCache[operands] = resultId;
@@ -418,15 +521,21 @@ private:
         propertyIntersections    = 0;
         lookupIntersections      = 0;
         preemptiveIntersections  = 0;
+        numCollections           = 0;
+        numCollectedPts          = 0;
     }
 
 private:
     /// Maps points-to IDs (indices) to their corresponding points-to set.
     /// Reverse of idToPts.
-    /// Elements are only added through push_back, so the number of elements
-    /// stored is the size of the vector.
+    /// Elements are only added through push_back; garbage collected sets are
+    /// nullptr until their ID is reused (see freeIds).
     /// Not const so we can remap.
     std::vector<std::unique_ptr<Data>> idToPts;
+    /// Number of references to each points-to ID (see refPts).
+    std::vector<u32_t> refCounts;
+    /// Garbage collected IDs available for reuse.
+    std::vector<PointsToID> freeIds;
     /// Maps points-to sets to their corresponding ID.
     PTSToIDMap ptsToId;
 
@@ -439,6 +548,8 @@ private:
 
     /// Used to generate new PointsToIDs. Any non-zero is valid.
     PointsToID idCounter;
+    /// Number of stored sets after the last garbage collection.
+    size_t liveAfterLastCollection;
 
     // Statistics:
     u64_t totalUnions;
@@ -456,6 +567,8 @@ private:
     u64_t propertyIntersections;
     u64_t lookupIntersections;
     u64_t preemptiveIntersections;
+    u64_t numCollections;
+    u64_t numCollectedPts;
 };
 
 } // End namespace SVF
@@ -45,14 +45,19 @@ public:
     typedef Map<Data, KeySet> RevPtsMap;
 
     /// Constructor
-    explicit PersistentPTData(PersistentPointsToCache<DataSet> &cache, bool reversePT = true, PTDataTy ty = PTDataTy::PersBase)
-        : BasePTData(reversePT, ty), ptCache(cache) { }
-
+    /// When refCounted, the points-to IDs held are reference counted in the cache so
+    /// that unused sets can be garbage collected (the hybrid backing).
+    explicit PersistentPTData(PersistentPointsToCache<DataSet> &cache, bool reversePT = true, PTDataTy ty = PTDataTy::PersBase,
+                              bool refCounted = false)
+        : BasePTData(reversePT, ty), ptCache(cache), refCounted(refCounted) { }
+
+    /// References are not released: the cache may be destroyed first and dies
+    /// with the analysis anyway.
     ~PersistentPTData() override = default;
 
     inline void clear() override
     {
-        ptsMap.clear();
+        clearIds(ptsMap);
         revPtsMap.clear();
     }
 
@@ -101,7 +106,7 @@ public:
         PointsToID complementId = ptCache.complementPts(varId, toRemoveId);
         if (varId != complementId)
         {
-            ptsMap[var] = complementId;
+            setId(ptsMap, var, complementId);
             clearSingleRevPts(revPtsMap[element], var);
         }
     }
@@ -109,7 +114,7 @@ public:
     void clearFullPts(const Key& var) override
     {
         clearRevPts(getPts(var), var);
-        ptsMap[var] = PersistentPointsToCache<DataSet>::emptyPointsToId();
+        setId(ptsMap, var, PersistentPointsToCache<DataSet>::emptyPointsToId());
     }
 
     void remapAllPts() override
@@ -148,6 +153,48 @@ public:
     }
     ///@}
 
+    /// Points key to id in map, maintaining reference counts when refCounted.
+    inline void setId(KeyToIDMap &map, const Key &key, PointsToID id)
+    {
+        PointsToID &oldId = map[key];
+        if (refCounted)
+        {
+            // The empty set is never collected so it need not be counted.
+            if (id != PersistentPointsToCache<DataSet>::emptyPointsToId()) ptCache.refPts(id);
+            if (oldId != PersistentPointsToCache<DataSet>::emptyPointsToId()) ptCache.unrefPts(oldId);
+        }
+        oldId = id;
+    }
+
+    /// Drops all of map, releasing its references when refCounted.
+    inline void clearIds(KeyToIDMap &map)
+    {
+        if (refCounted)
+        {
+            for (const typename KeyToIDMap::value_type &ki : map)
+            {
+                if (ki.second != PersistentPointsToCache<DataSet>::emptyPointsToId()) ptCache.unrefPts(ki.second);
+            }
+        }
+        map.clear();
+    }
+
+    /// Memory taken by the points-to sets of all keys: keyBytes when every key owns
+    /// a copy of its set (as in MutablePTData) and sharedBytes when each distinct
+    /// set is stored once.
+    void getMemoryUsage(u64_t &keyBytes, u64_t &sharedBytes) const
+    {
+        keyBytes = 0;
+        sharedBytes = 0;
+        Set<PointsToID> seen;
+        for (const typename KeyToIDMap::value_type &ki : ptsMap)
+        {
+            u64_t bytes = ptCache.getActualPts(ki.second).getMemoryUsage();
+            keyBytes += bytes;
+            if (seen.insert(ki.second).second) sharedBytes += bytes;
+        }
+    }
+
 private:
     /// Internal unionPts since other methods follow the same pattern.
     /// Renamed because PointsToID and Key may be the same type...
@@ -159,7 +206,7 @@ private:
         bool changed = newDstId != dstId;
         if (changed)
         {
-            ptsMap[dstKey] = newDstId;
+            setId(ptsMap, dstKey, newDstId);
 
             // Reverse points-to only needs to be handled when dst's
             // points-to set has changed (i.e., do it the first time only).
@@ -193,6 +240,8 @@ protected:
     PersistentPointsToCache<DataSet> &ptCache;
     KeyToIDMap ptsMap;
     RevPtsMap revPtsMap;
+    /// Whether IDs held are reference counted in ptCache.
+    bool refCounted;
 };
 
 /// DiffPTData implemented with a persistent points-to backing.
@@ -209,16 +258,18 @@ public:
     typedef typename BasePersPTData::RevPtsMap RevPtsMap;
 
     /// Constructor
-    explicit PersistentDiffPTData(PersistentPointsToCache<DataSet> &cache, bool reversePT = true, PTDataTy ty = PTDataTy::PersDiff)
-        : BaseDiffPTData(reversePT, ty), ptCache(cache), persPTData(cache, reversePT) { }
+    /// refCounted selects the hybrid backing (see PersistentPTData).
+    explicit PersistentDiffPTData(PersistentPointsToCache<DataSet> &cache, bool reversePT = true, PTDataTy ty = PTDataTy::PersDiff,
+                                  bool refCounted = false)
+        : BaseDiffPTData(reversePT, ty), ptCache(cache), persPTData(cache, reversePT, PTDataTy::PersBase, refCounted) { }
 
     ~PersistentDiffPTData() override = default;
 
     void clear() override
     {
         persPTData.clear();
-        diffPtsMap.clear();
-        propaPtsMap.clear();
+        persPTData.clearIds(diffPtsMap);
+        persPTData.clearIds(propaPtsMap);
     }
 
     inline const DataSet &getPts(const Key& var) override
@@ -279,10 +330,10 @@ public:
         PointsToID allId = ptCache.emplacePts(all);
         // Diff is made up of the entire points-to set minus what has been propagated.
         PointsToID diffId = ptCache.complementPts(allId, propaId);
-        diffPtsMap[var] = diffId;
+        persPTData.setId(diffPtsMap, var, diffId);
 
         // We've now propagated the entire thing.
-        propaPtsMap[var] = allId;
+        persPTData.setId(propaPtsMap, var, allId);
 
         // Whether diff is empty or not; just need to check against the ID since it
         // is the only empty set.
@@ -293,12 +344,12 @@ public:
     {
         PointsToID dstId = propaPtsMap[dst];
         PointsToID srcId = propaPtsMap[src];
-        propaPtsMap[dst] = ptCache.intersectPts(dstId, srcId);
+        persPTData.setId(propaPtsMap, dst, ptCache.intersectPts(dstId, srcId));
     }
 
     inline void clearPropaPts(Key &var) override
     {
-        propaPtsMap[var] = ptCache.emptyPointsToId();
+        persPTData.setId(propaPtsMap, var, ptCache.emptyPointsToId());
     }
 
     Map<DataSet, unsigned> getAllPts(bool liveOnly) const override
@@ -306,6 +357,12 @@ public:
         return persPTData.getAllPts(liveOnly);
     }
 
+    /// See PersistentPTData::getMemoryUsage.
+    void getMemoryUsage(u64_t &keyBytes, u64_t &sharedBytes) const
+    {
+        persPTData.getMemoryUsage(keyBytes, sharedBytes);
+    }
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const PersistentDiffPTData<Key, KeySet, Data, DataSet> *)
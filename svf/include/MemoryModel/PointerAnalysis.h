@@ -32,6 +32,7 @@
 
 #include <unistd.h>
 #include <signal.h>
+#include <mutex>
 
 #include "Graphs/CHG.h"
 #include "Graphs/ThreadCallGraph.h"
@@ -65,6 +66,8 @@ public:
         Andersen_WPA,		///< Andersen PTA
         AndersenSCD_WPA,    ///< Selective cycle detection andersen-style WPA
         AndersenSFR_WPA,    ///< Stride-based field representation
+        AndersenLCD_WPA,    ///< Lazy cycle detection andersen-style WPA
+        AndersenHCD_WPA,    ///< Hybrid cycle detection andersen-style WPA
         AndersenWaveDiff_WPA,	///< Diff wave propagation andersen-style WPA
         Steensgaard_WPA,      ///< Steensgaard PTA
         CSCallString_WPA,	///< Call string based context sensitive WPA
@@ -152,6 +155,8 @@ protected:
     ICFG* icfg;
     /// CHGraph
     CommonCHGraph *chgraph;
+    /// Serializes the parts of batched alias queries which may update analysis state
+    std::mutex queryLock;
 
 public:
     /// Get ICFG
@@ -225,6 +230,9 @@ public:
     /// Compute points-to results on-demand, overridden by derived classes
     virtual void computeDDAPts(NodeID) {}
 
+    /// Order a batch of on-demand queries to favour reuse between them, overridden by derived classes
+    virtual void orderDDAQueries(std::vector<NodeID>&) {}
+
     /// Interface exposed to users of our pointer analysis, given Value infos
     virtual AliasResult alias(const SVFVar* V1,
                               const SVFVar* V2) = 0;
@@ -232,6 +240,10 @@ public:
     /// Interface exposed to users of our pointer analysis, given PAGNodeID
     virtual AliasResult alias(NodeID node1, NodeID node2) = 0;
 
+    /// Answer a batch of alias queries, in query order. Unlike alias(), this can be
+    /// called from several client threads at once once the analysis is solved.
+    virtual std::vector<AliasResult> batchAlias(const std::vector<NodePair>& queries);
+
     /// Get points-to targets of a pointer. It needs to be implemented in child class
     virtual const PointsTo& getPts(NodeID ptr) = 0;
 
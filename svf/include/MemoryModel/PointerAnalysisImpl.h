@@ -32,6 +32,10 @@
 
 #include <Graphs/ConsG.h>
 #include "MemoryModel/PointerAnalysis.h"
+#include "MemoryModel/BinaryPtsFile.h"
+#include "MemoryModel/PTASnapshot.h"
+#include "Util/AtomicStat.h"
+#include "Util/ShardedLRUCache.h"
 
 namespace SVF
 {
@@ -65,6 +69,7 @@ public:
     {
         Mutable,
         Persistent,
+        Hybrid,
     };
 
     /// Constructor
@@ -87,10 +92,12 @@ public:
     ///@{
     inline const PointsTo& getPts(NodeID id) override
     {
+        loadMappedPts(id);
         return ptD->getPts(id);
     }
     inline const NodeSet& getRevPts(NodeID nodeId) override
     {
+        loadAllMappedPts();
         return ptD->getRevPts(nodeId);
     }
     //@}
@@ -98,13 +105,17 @@ public:
     /// Remove element from the points-to set of id.
     virtual inline void clearPts(NodeID id, NodeID element)
     {
+        loadMappedPts(id);
         ptD->clearPts(id, element);
+        invalidateAliasCache();
     }
 
     /// Clear points-to set of id.
     virtual inline void clearFullPts(NodeID id)
     {
+        loadMappedPts(id);
         ptD->clearFullPts(id);
+        invalidateAliasCache();
     }
 
     /// Union/add points-to. Add the reverse points-to for node collapse purpose
@@ -112,15 +123,34 @@ public:
     //@{
     virtual inline bool unionPts(NodeID id, const PointsTo& target)
     {
-        return ptD->unionPts(id, target);
+        loadMappedPts(id);
+        return recordUnion(ptD->unionPts(id, target));
     }
     virtual inline bool unionPts(NodeID id, NodeID ptd)
     {
-        return ptD->unionPts(id,ptd);
+        loadMappedPts(id);
+        loadMappedPts(ptd);
+        return recordUnion(ptD->unionPts(id,ptd));
     }
     virtual inline bool addPts(NodeID id, NodeID ptd)
     {
-        return ptD->addPts(id,ptd);
+        loadMappedPts(id);
+        if (!ptD->addPts(id,ptd))
+            return false;
+        invalidateAliasCache();
+        return true;
+    }
+    //@}
+
+    /// Number of points-to set unions performed while solving, and how many of them changed their destination
+    //@{
+    inline u64_t getNumOfUnions() const
+    {
+        return numOfUnions;
+    }
+    inline u64_t getNumOfChangedUnions() const
+    {
+        return numOfChangedUnions;
     }
     //@}
 
@@ -128,6 +158,8 @@ public:
     virtual inline void clearAllPts()
     {
         ptD->clear();
+        mappedPts.reset();
+        invalidateAliasCache();
     }
 
     /// Expand FI objects
@@ -138,6 +170,10 @@ public:
     /// Remap all points-to sets to use the current mapping.
     void remapPointsToSets(void);
 
+    /// Immutable copy of the current points-to sets, to be queried concurrently by
+    /// clients once solving is done. Later changes to this analysis are not reflected.
+    std::unique_ptr<const PTASnapshot> snapshot();
+
     /// Interface for analysis result storage on filesystem.
     //@{
     virtual void writeToFile(const std::string& filename);
@@ -150,12 +186,56 @@ public:
     virtual void readAndSetObjFieldSensitivity(std::ifstream& f, const std::string& delimiterStr);
     //@}
 
+    /// Interface for analysis result storage in the binary format (see BinaryPtsFile).
+    /// Points-to sets of a binary file are loaded lazily, on the first access to a variable,
+    /// and all at once by the accessors reading reverse points-to or the whole data.
+    //@{
+    virtual void writeToBinaryFile(const std::string& filename);
+    virtual bool readFromBinaryFile(const std::string& filename);
+    //@}
+
 protected:
-    /// Get points-to data structure
+    /// Get points-to data structure, with all the points-to sets of mapped binary results
     inline PTDataTy* getPTDataTy() const
     {
+        loadAllMappedPts();
         return ptD.get();
     }
+    /// Get points-to data structure, with only the points-to sets of mapped binary results
+    /// loaded so far: the sets accessed are to be loaded first by loadMappedPts
+    inline PTDataTy* getLoadedPTDataTy() const
+    {
+        return ptD.get();
+    }
+
+    /// Count unions performed on the points-to data for the statistics
+    //@{
+    inline bool recordUnion(bool changed)
+    {
+        ++numOfUnions;
+        if (changed)
+            ++numOfChangedUnions;
+        return changed;
+    }
+    inline void recordUnions(u64_t unions, u64_t changed)
+    {
+        numOfUnions += unions;
+        numOfChangedUnions += changed;
+    }
+    //@}
+
+    /// Points-to sets have changed (other than by counted unions), or been freed and
+    /// their slots reused (garbage collection), so cached alias results are stale
+    inline void invalidateAliasCache()
+    {
+        ++numOfPtsInvalidations;
+    }
+    /// Moves on whenever points-to sets may have changed; aliasCache holds results of
+    /// aliasCacheGeneration only
+    inline u64_t getPtsGeneration() const
+    {
+        return numOfChangedUnions + numOfPtsInvalidations;
+    }
 
 
     /// Finalization of pointer analysis, and normalize points-to information to Bit Vector representation
@@ -207,12 +287,50 @@ protected:
     /// i.e., replace fieldObj with baseObj if it is field-insensitive
     virtual void normalizePointsTo();
 
+    /// Create the gep object of base at offset with the given ID (when reading results from file).
+    void addGepObjVarFromFile(NodeID base, APOffset offset, NodeID id);
+
+    /// Load the points-to set of id from the mapped binary results, if any and not done yet.
+    inline void loadMappedPts(NodeID id) const
+    {
+        if (mappedPts && mappedPtsLoaded.test_and_set(id))
+            loadMappedPtsFromFile(id);
+    }
+
+    /// Load all the points-to sets of the mapped binary results not loaded yet, and unmap them.
+    inline void loadAllMappedPts() const
+    {
+        if (mappedPts)
+            loadAllMappedPtsFromFile();
+    }
+
 private:
+    void loadMappedPtsFromFile(NodeID id) const;
+    void loadAllMappedPtsFromFile() const;
+
     /// Points-to data
     std::unique_ptr<PTDataTy> ptD;
 
+    /// Union statistics (updated concurrently by the parallel solvers)
+    AtomicStat<u64_t> numOfUnions = 0;
+    AtomicStat<u64_t> numOfChangedUnions = 0;
+
     PersistentPointsToCache<PointsTo> ptCache;
 
+    /// Results of batched alias queries keyed by the (ordered) addresses of the two
+    /// points-to sets. Equal persistent points-to sets are interned, so share entries.
+    /// Addresses are only meaningful while no points-to set changes, so the cache is
+    /// dropped when the points-to generation moves on (see getPtsGeneration).
+    typedef std::pair<const PointsTo*, const PointsTo*> PtsPair;
+    ShardedLRUCache<PtsPair, AliasResult> aliasCache;
+    AtomicStat<u64_t> numOfPtsInvalidations = 0;
+    u64_t aliasCacheGeneration = 0;
+
+    /// Binary results read by readFromBinaryFile and the variables already loaded from them
+    /// (loaded by the const accessors as well).
+    mutable std::unique_ptr<BinaryPtsFile> mappedPts;
+    mutable NodeBS mappedPtsLoaded;
+
 public:
     /// Interface expose to users of our pointer analysis, given Value infos
     AliasResult alias(const SVFVar* V1,
@@ -227,6 +345,15 @@ public:
     /// Interface expose to users of our pointer analysis, given two pts
     virtual AliasResult alias(const PointsTo& pts1, const PointsTo& pts2);
 
+    /// Batched alias queries answered through aliasCache
+    std::vector<AliasResult> batchAlias(const std::vector<NodePair>& queries) override;
+
+    /// Drop cached alias results; needed when points-to sets change after querying
+    inline void clearAliasCache()
+    {
+        aliasCache.clear();
+    }
+
     /// dump and debug, print out conditional pts
     //@{
     void dumpCPts() override
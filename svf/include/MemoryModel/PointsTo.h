@@ -17,6 +17,7 @@
 #include "SVFIR/SVFType.h"
 #include "Util/BitVector.h"
 #include "Util/CoreBitVector.h"
+#include "Util/RoaringBitVector.h"
 #include "Util/SparseBitVector.h"
 
 namespace SVF
@@ -33,6 +34,7 @@ public:
         SBV,
         CBV,
         BV,
+        RBV,
     };
 
     class PointsToIterator;
@@ -121,6 +123,9 @@ public:
     /// Return a hash of this set.
     size_t hash() const;
 
+    /// Returns the (approximate) memory used by this set, in bytes.
+    size_t getMemoryUsage() const;
+
     /// Checks if this points-to set is using the current best mapping.
     /// If not, remaps.
     void checkAndRemap();
@@ -168,6 +173,8 @@ private:
         CoreBitVector cbv;
         /// Bit vector backing.
         BitVector bv;
+        /// Roaring bit vector backing.
+        RoaringBitVector rbv;
     };
 
     /// Type of this points-to set.
@@ -227,6 +234,7 @@ public:
             SparseBitVector<>::iterator sbvIt;
             CoreBitVector::iterator cbvIt;
             BitVector::iterator bvIt;
+            RoaringBitVector::iterator rbvIt;
         };
     };
 };
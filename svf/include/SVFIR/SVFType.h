@@ -657,9 +657,9 @@ template <> struct std::hash<SVF::NodePair>
 };
 
 /// Specialise hash for SparseBitVectors.
-template <unsigned N> struct std::hash<SVF::SparseBitVector<N>>
+template <unsigned N, bool F> struct std::hash<SVF::SparseBitVector<N, F>>
 {
-    size_t operator()(const SVF::SparseBitVector<N>& sbv) const
+    size_t operator()(const SVF::SparseBitVector<N, F>& sbv) const
     {
         SVF::Hash<std::pair<std::pair<size_t, size_t>, size_t>> h;
         return h(std::make_pair(std::make_pair(sbv.count(), sbv.find_first()),
@@ -0,0 +1,84 @@
+//===- AtomicStat.h -- Statistics updated by concurrent workers ---------------//
+
+/*
+ * AtomicStat.h
+ *
+ * Counters and timers which may be updated by the workers of a ThreadPool.
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef ATOMICSTAT_H_
+#define ATOMICSTAT_H_
+
+#include <atomic>
+#include <type_traits>
+
+namespace SVF
+{
+
+/// Statistic (counter or accumulated time) which the parallel solvers update from
+/// several threads. It reads and updates like a plain T; every operation is a relaxed
+/// atomic one since statistics are only reported after solving.
+template<typename T>
+class AtomicStat
+{
+public:
+    AtomicStat(T v = 0): value(v) {}
+    AtomicStat(const AtomicStat& other): value(other.load()) {}
+
+    inline AtomicStat& operator=(T v)
+    {
+        value.store(v, std::memory_order_relaxed);
+        return *this;
+    }
+    inline AtomicStat& operator=(const AtomicStat& other)
+    {
+        return *this = other.load();
+    }
+
+    inline T load() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+    inline operator T() const
+    {
+        return load();
+    }
+
+    /// Add delta, returning the previous value
+    inline T add(T delta)
+    {
+        if constexpr (std::is_integral<T>::value)
+            return value.fetch_add(delta, std::memory_order_relaxed);
+        else
+        {
+            T cur = load();
+            while (!value.compare_exchange_weak(cur, cur + delta, std::memory_order_relaxed))
+                ;
+            return cur;
+        }
+    }
+
+    inline AtomicStat& operator+=(T delta)
+    {
+        add(delta);
+        return *this;
+    }
+    inline AtomicStat& operator++()
+    {
+        add(1);
+        return *this;
+    }
+    inline T operator++(int)
+    {
+        return add(1);
+    }
+
+private:
+    std::atomic<T> value;
+};
+
+} // End namespace SVF
+
+#endif /* ATOMICSTAT_H_ */
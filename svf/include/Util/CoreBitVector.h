@@ -112,6 +112,12 @@ public:
     /// Hash for this CBV.
     size_t hash(void) const;
 
+    /// Heap memory used by the words, in bytes.
+    size_t getMemoryUsage(void) const
+    {
+        return words.capacity() * sizeof(Word);
+    }
+
     const_iterator begin(void) const;
     const_iterator end(void) const;
 
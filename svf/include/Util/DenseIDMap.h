@@ -0,0 +1,96 @@
+//===- DenseIDMap.h -- Map from mostly dense node IDs ---------------------------//
+
+/*
+ * DenseIDMap.h
+ *
+ * A map from node IDs to values, indexed directly by ID. Node IDs are mostly
+ * dense as they come from NodeIDAllocator, so the values are kept in a vector
+ * indexed by ID, with a hash map only for the outlier IDs far beyond it (e.g.,
+ * values under the dense allocation strategy).
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef DENSEIDMAP_H_
+#define DENSEIDMAP_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "Util/GeneralType.h"
+
+namespace SVF
+{
+
+/// Like DenseNodeMap, the vector at most doubles to take in an ID, and IDs beyond
+/// that go to the hash map (moved to the vector once it has grown over them). IDs
+/// without a value map to the default value given on construction.
+///
+/// A reference returned by operator[] is invalidated by inserting another ID.
+template<typename T>
+class DenseIDMap
+{
+public:
+    explicit DenseIDMap(const T& dflt = T()) : dflt(dflt) {}
+
+    /// Value of id, the default value if there is none
+    inline const T& lookup(NodeID id) const
+    {
+        if (id < values.size())
+            return values[id];
+        auto it = sparse.find(id);
+        return it != sparse.end() ? it->second : dflt;
+    }
+
+    /// Value of id, set to the default value if there was none
+    inline T& operator[](NodeID id)
+    {
+        if (id < values.size())
+            return values[id];
+        if (static_cast<size_t>(id) < 2 * values.size() + MinEntries)
+        {
+            grow(std::max<size_t>(static_cast<size_t>(id) + 1, 2 * values.size()));
+            return values[id];
+        }
+        return sparse.emplace(id, dflt).first->second;
+    }
+
+    /// Make room in the vector for the IDs below num
+    inline void reserve(size_t num)
+    {
+        if (num > values.size())
+            grow(num);
+    }
+
+    inline void clear()
+    {
+        std::vector<T>().swap(values);
+        sparse.clear();
+    }
+
+private:
+    inline void grow(size_t size)
+    {
+        values.resize(size, dflt);
+        for (auto it = sparse.begin(); it != sparse.end();)
+        {
+            if (it->first < size)
+            {
+                values[it->first] = std::move(it->second);
+                it = sparse.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    static constexpr size_t MinEntries = 1024;
+
+    std::vector<T> values;	///< values[id] == value of id
+    Map<NodeID, T> sparse;	///< values of the IDs beyond values
+    T dflt;
+};
+
+} // End namespace SVF
+
+#endif /* DENSEIDMAP_H_ */
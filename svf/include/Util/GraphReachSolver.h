@@ -100,6 +100,12 @@ protected:
             FWProcessCurNode(item);
 
             GNODE* v = getNode(getNodeIDFromItem(item));
+            if (v->isFrozen())
+            {
+                for (GEDGE* edge : v->getFrozenOutEdges())
+                    FWProcessOutgoingEdge(item, edge);
+                continue;
+            }
             child_iterator EI = GTraits::child_begin(v);
             child_iterator EE = GTraits::child_end(v);
             for (; EI != EE; ++EI)
@@ -119,6 +125,12 @@ protected:
             BWProcessCurNode(item);
 
             GNODE* v = getNode(getNodeIDFromItem(item));
+            if (v->isFrozen())
+            {
+                for (GEDGE* edge : v->getFrozenInEdges())
+                    BWProcessIncomingEdge(item, edge);
+                continue;
+            }
             inv_child_iterator EI = InvGTraits::child_begin(v);
             inv_child_iterator EE = InvGTraits::child_end(v);
             for (; EI != EE; ++EI)
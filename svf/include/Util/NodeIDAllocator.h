@@ -142,6 +142,7 @@ public:
         static const std::string DistanceMatrixTime;
         static const std::string FastClusterTime;
         static const std::string DendrogramTraversalTime;
+        static const std::string MinHashTime;
         static const std::string EvalTime;
         static const std::string TotalTime;
         static const std::string TheoreticalNumWords;
@@ -193,6 +194,18 @@ public:
                                                 const size_t numObjects, const Map<NodeID, unsigned> &nodeMap,
                                                 double &distanceMatrixTime);
 
+        /// Allocates the objects of a region in the order of the MinHash signatures of the
+        /// points-to sets they occur in. Objects occurring in the same points-to sets have the
+        /// same signature, and so consecutive identifiers. Approximates the clustering of
+        /// fastcluster in O(numHashes * sum of |pts|) + a sort, without a distance matrix.
+        static inline void minHashOrder(const std::vector<std::pair<const PointsTo *, unsigned>> &pointsToSets,
+                                        const size_t numObjects, const Map<NodeID, unsigned> &nodeMap,
+                                        std::vector<NodeID> &mapping, unsigned &allocCounter,
+                                        const std::vector<NodeID> &regionNodeMap, double &minHashTime);
+
+        /// Mixes x into a well-distributed 64-bit hash (splitmix64 finaliser).
+        static inline u64_t mixHash(u64_t x);
+
         /// Traverses the dendrogram produced by fastcluster, making node o, where o is the nth leaf (per
         /// recursive DFS) map to n. index is the dendrogram node to work off. The traversal should start
         /// at the top, which is the "last" (consider that it is 2D) element of the dendrogram, numObjects - 1.
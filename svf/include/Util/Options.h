@@ -8,6 +8,7 @@
 #include "Util/PTAStat.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
 #include "Util/NodeIDAllocator.h"
+#include "Util/WorkList.h"
 
 namespace SVF
 {
@@ -52,6 +53,9 @@ public:
     ///       directly, but it seems we will always want single anyway, and this is for testing.
     static const OptionMap<u32_t> ClusterMethod;
 
+    /// Length of the signatures of MinHash clustering.
+    static const Option<u32_t> ClusterMinHashes;
+
     /// Cluster partitions separately.
     static const Option<bool> RegionedClustering;
 
@@ -74,9 +78,36 @@ public:
     /// Number of threads for the versioning phase.
     static const Option<u32_t> VersioningThreads;
 
+    /// Number of threads for the copy propagation phase of wave propagation.
+    static const Option<u32_t> AnderThreads;
+
+    /// Number of threads for solving independent SVFG regions in flow-sensitive analysis.
+    static const Option<u32_t> FsThreads;
+    static const Option<bool> FsThreadsCheck;
+
+    /// Maximum number of cached results of batched alias queries.
+    static const Option<u32_t> AliasCacheSize;
+
+    /// Worklist policies of the Andersen's, flow-sensitive, and versioned flow-sensitive solvers.
+    //@{
+    static const OptionMap<PolicyWorkList::Policy> AnderWorklist;
+    static const OptionMap<PolicyWorkList::Policy> FsWorklist;
+    static const OptionMap<PolicyWorkList::Policy> VfsWorklist;
+    //@}
+
+    /// Offline variable substitution before Andersen's solving.
+    static const OptionMap<u32_t> AnderVarSubst;
+    static const Option<bool> AnderVarSubstCheck;
+
     // ContextDDA.cpp
     static const Option<u32_t> CxtBudget;
 
+    // DDAClient.cpp
+    static const Option<bool> DDABatch;
+
+    // DDAVFSolver.h
+    static const Option<u32_t> DDACacheSize;
+
     // DDAPass.cpp
     static const Option<u32_t> MaxPathLen;
     static const Option<u32_t> MaxContextLen;
@@ -107,6 +138,9 @@ public:
     // Sparse value-flow graph (VFG.cpp)
     static const Option<bool> DumpVFG;
 
+    // Compact edge layout of generic graphs (GenericGraph.h)
+    static const Option<bool> CompactGraphs;
+
     // Base class of pointer analyses (PointerAnalysis.cpp)
     static const Option<bool> TypePrint;
     static const Option<bool> FuncPointerPrint;
@@ -209,6 +243,7 @@ public:
     static const Option<std::string> WriteAnder;
     // static const Option<string> ReadAnder;
     static const Option<std::string> ReadAnder;
+    static const Option<bool> WriteAnderBinary;
     static const Option<bool> DiffPts;
     static Option<bool> DetectPWC;
     static const Option<bool> VtableInSVFIR;
@@ -243,8 +278,12 @@ public:
     static const Option<u32_t> WidenDelay;
     /// recursion handling mode, Default: TOP
     static const OptionMap<u32_t> HandleRecur;
-    /// Use sparse abstract state representation (TODO: to implement)
-    //static const Option<bool> UseSparseState;
+    /// maximum number of node states a callee summary may record, Default: 0 (no summaries)
+    static const Option<u32_t> AESummaryLimit;
+    /// Keep top-level variables at their definitions instead of in every abstract state, Default: false
+    static const Option<bool> UseSparseState;
+    /// Drop the state of a node from the trace once the nodes reading it are handled, Default: false
+    static const Option<bool> AEEvictStates;
     /// the max time consumptions (seconds). Default: 4 hours 14400s
     static const Option<u32_t> Timeout;
     /// bug info output file, Default: output.db
@@ -0,0 +1,459 @@
+//===- PersistentIDMap.h -- Map from IDs sharing structure between copies -----//
+
+/*
+ * PersistentIDMap.h
+ *
+ * A map keyed by u32_t IDs whose copies share their unchanged parts. Copying is
+ * O(1), updating a copy only duplicates the path to the updated entry, and
+ * comparing or combining two maps skips the subtrees they still share.
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PERSISTENTIDMAP_H_
+#define PERSISTENTIDMAP_H_
+
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "Util/GeneralType.h"
+
+namespace SVF
+{
+
+/// Hash array mapped trie over the bits of the keys, 5 bits per level (at most 7 levels).
+/// A slot of a node either holds one entry, if it is the only key with that prefix, or a
+/// child node. Entries are never erased (only clear() drops them all), so the layout of a
+/// map only depends on its set of keys, and two maps are equal iff their nodes are.
+///
+/// Nodes and entries are reference counted and copied on write: the non-const accessors
+/// first make the path to the entry private to this map. A reference returned by
+/// operator[] remains valid while this map is not copied, but must not be written through
+/// after a copy as the entry is then shared. Not to be shared between threads.
+///
+/// V must provide bool equals(const V&) const.
+template<typename V>
+class PersistentIDMap
+{
+public:
+    typedef u32_t key_type;
+    typedef V mapped_type;
+    typedef std::pair<const u32_t, V> value_type;
+
+private:
+    typedef std::shared_ptr<value_type> EntryPtr;
+    struct Node;
+    typedef std::shared_ptr<Node> NodePtr;
+
+    struct Node
+    {
+        u32_t dataMap = 0;	///< slots holding an entry
+        u32_t nodeMap = 0;	///< slots holding a child
+        u32_t size = 0;	///< number of entries in this subtree
+        std::vector<EntryPtr> data;	///< ordered by slot
+        std::vector<NodePtr> children;	///< ordered by slot
+    };
+
+    static constexpr u32_t Bits = 5;
+    static constexpr u32_t MaxDepth = 7;
+
+public:
+    class const_iterator
+    {
+        friend class PersistentIDMap;
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename PersistentIDMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef const value_type& reference;
+
+        const_iterator(): depth(-1) {}
+
+        inline reference operator*() const
+        {
+            return *nodes[depth]->data[pos[depth]];
+        }
+        inline pointer operator->() const
+        {
+            return &**this;
+        }
+        inline const_iterator& operator++()
+        {
+            ++pos[depth];
+            settle();
+            return *this;
+        }
+        inline const_iterator operator++(int)
+        {
+            const_iterator it = *this;
+            ++*this;
+            return it;
+        }
+        inline bool operator==(const const_iterator& rhs) const
+        {
+            return depth == rhs.depth &&
+                   (depth < 0 || (nodes[depth] == rhs.nodes[depth] && pos[depth] == rhs.pos[depth]));
+        }
+        inline bool operator!=(const const_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        /// Move to the next entry at or after the cursor. pos of a node runs over its
+        /// entries, then its children; it is past a child while visiting that child.
+        void settle()
+        {
+            while (depth >= 0)
+            {
+                const Node* n = nodes[depth];
+                u32_t p = pos[depth];
+                if (p < n->data.size())
+                    return;
+                if (p < n->data.size() + n->children.size())
+                {
+                    pos[depth] = p + 1;
+                    ++depth;
+                    nodes[depth] = n->children[p - n->data.size()].get();
+                    pos[depth] = 0;
+                }
+                else
+                    --depth;
+            }
+        }
+
+        const Node* nodes[MaxDepth];
+        u32_t pos[MaxDepth];
+        s32_t depth;	///< -1 at the end
+    };
+    typedef const_iterator iterator;
+
+    PersistentIDMap() = default;
+
+    PersistentIDMap(std::initializer_list<value_type> entries)
+    {
+        for (const value_type& e : entries)
+            (*this)[e.first] = e.second;
+    }
+
+    inline u32_t size() const
+    {
+        return root ? root->size : 0;
+    }
+    inline bool empty() const
+    {
+        return size() == 0;
+    }
+    inline void clear()
+    {
+        root.reset();
+    }
+
+    /// Value of key, nullptr if absent
+    const V* lookup(u32_t key) const
+    {
+        u32_t shift = 0;
+        for (const Node* n = root.get(); n; shift += Bits)
+        {
+            u32_t bit = bitOf(key, shift);
+            if (n->nodeMap & bit)
+                n = n->children[index(n->nodeMap, bit)].get();
+            else if (n->dataMap & bit)
+            {
+                const EntryPtr& e = n->data[index(n->dataMap, bit)];
+                return e->first == key ? &e->second : nullptr;
+            }
+            else
+                return nullptr;
+        }
+        return nullptr;
+    }
+
+    inline u32_t count(u32_t key) const
+    {
+        return lookup(key) != nullptr;
+    }
+
+    inline const V& at(u32_t key) const
+    {
+        const V* v = lookup(key);
+        assert(v && "key not in map?");
+        return *v;
+    }
+
+    /// Value of key, inserting a default one if absent
+    V& operator[](u32_t key)
+    {
+        EntryPtr* e = update(mutableRoot(), 0, key, true, nullptr);
+        makeUnique(*e);
+        return (*e)->second;
+    }
+
+    const_iterator begin() const
+    {
+        const_iterator it;
+        if (root)
+        {
+            it.depth = 0;
+            it.nodes[0] = root.get();
+            it.pos[0] = 0;
+            it.settle();
+        }
+        return it;
+    }
+    inline const_iterator end() const
+    {
+        return const_iterator();
+    }
+
+    const_iterator find(u32_t key) const
+    {
+        const_iterator it;
+        u32_t shift = 0;
+        s32_t depth = 0;
+        for (const Node* n = root.get(); n; shift += Bits, ++depth)
+        {
+            u32_t bit = bitOf(key, shift);
+            it.nodes[depth] = n;
+            if (n->nodeMap & bit)
+            {
+                u32_t c = index(n->nodeMap, bit);
+                it.pos[depth] = n->data.size() + c + 1;
+                n = n->children[c].get();
+            }
+            else
+            {
+                if (n->dataMap & bit)
+                {
+                    u32_t i = index(n->dataMap, bit);
+                    if (n->data[i]->first == key)
+                    {
+                        it.pos[depth] = i;
+                        it.depth = depth;
+                        return it;
+                    }
+                }
+                break;
+            }
+        }
+        return end();
+    }
+
+    /// Same keys with equal values. Shared subtrees are not visited.
+    bool equals(const PersistentIDMap& rhs) const
+    {
+        if (size() != rhs.size())
+            return false;
+        return empty() || equalNodes(root.get(), rhs.root.get());
+    }
+
+    /// Combine rhs into this map: f(mine, theirs) is applied to the keys of both maps
+    /// whose values differ, and the keys only in rhs are added when addMissing. f must
+    /// leave v as is on f(v, v) (as joins, meets, widenings and narrowings do), which
+    /// lets the subtrees shared by both maps be skipped. Added entries stay shared.
+    template<typename F>
+    void mergeWith(const PersistentIDMap& rhs, F f, bool addMissing)
+    {
+        if (rhs.empty() || root == rhs.root)
+            return;
+        if (empty())
+        {
+            if (addMissing)
+                root = rhs.root;
+            return;
+        }
+        makeUnique(root);
+        mergeNodes(root.get(), rhs.root.get(), 0, f, addMissing);
+    }
+
+    /// Entries of this map which base lacks or maps to another value. Subtrees shared
+    /// with base are skipped and the entries are shared with this map.
+    PersistentIDMap difference(const PersistentIDMap& base) const
+    {
+        PersistentIDMap diff;
+        if (root && root != base.root)
+            collectDifference(root.get(), base.root.get(), base, diff);
+        return diff;
+    }
+
+private:
+    static inline u32_t bitOf(u32_t key, u32_t shift)
+    {
+        return 1u << ((key >> shift) & 31);
+    }
+
+    /// Position of the slot bit among the slots of bitmap
+    static inline u32_t index(u32_t bitmap, u32_t bit)
+    {
+        return __builtin_popcount(bitmap & (bit - 1));
+    }
+
+    template<typename T>
+    static inline void makeUnique(std::shared_ptr<T>& p)
+    {
+        if (p.use_count() > 1)
+            p = std::make_shared<T>(*p);
+    }
+
+    inline Node* mutableRoot()
+    {
+        if (!root)
+            root = std::make_shared<Node>();
+        else
+            makeUnique(root);
+        return root.get();
+    }
+
+    /// Slot of key under the private node n (at the given shift), making the nodes on the
+    /// way private. If key is absent, entry (or a default entry if null) is inserted when
+    /// insert, otherwise nullptr is returned.
+    static EntryPtr* update(Node* n, u32_t shift, u32_t key, bool insert, const EntryPtr& entry)
+    {
+        Node* path[MaxDepth];
+        u32_t depth = 0;
+        while (true)
+        {
+            assert(depth < MaxDepth && "keys with the same bits?");
+            path[depth++] = n;
+            u32_t bit = bitOf(key, shift);
+            if (n->nodeMap & bit)
+            {
+                NodePtr& child = n->children[index(n->nodeMap, bit)];
+                makeUnique(child);
+                n = child.get();
+            }
+            else if (n->dataMap & bit)
+            {
+                u32_t i = index(n->dataMap, bit);
+                if (n->data[i]->first == key)
+                    return &n->data[i];
+                if (!insert)
+                    return nullptr;
+                // Push the resident entry down next to key.
+                NodePtr child = std::make_shared<Node>();
+                child->dataMap = bitOf(n->data[i]->first, shift + Bits);
+                child->size = 1;
+                child->data.push_back(std::move(n->data[i]));
+                n->data.erase(n->data.begin() + i);
+                n->dataMap ^= bit;
+                n->nodeMap |= bit;
+                n->children.insert(n->children.begin() + index(n->nodeMap, bit), child);
+                n = child.get();
+            }
+            else
+            {
+                if (!insert)
+                    return nullptr;
+                n->dataMap |= bit;
+                auto it = n->data.insert(n->data.begin() + index(n->dataMap, bit),
+                                         entry ? entry : std::make_shared<value_type>(key, V()));
+                for (u32_t d = 0; d < depth; ++d)
+                    ++path[d]->size;
+                return &*it;
+            }
+            shift += Bits;
+        }
+    }
+
+    static bool equalNodes(const Node* a, const Node* b)
+    {
+        if (a == b)
+            return true;
+        if (a->dataMap != b->dataMap || a->nodeMap != b->nodeMap || a->size != b->size)
+            return false;
+        for (u32_t i = 0; i < a->data.size(); ++i)
+        {
+            const EntryPtr& x = a->data[i];
+            const EntryPtr& y = b->data[i];
+            if (x != y && (x->first != y->first || !x->second.equals(y->second)))
+                return false;
+        }
+        for (u32_t i = 0; i < a->children.size(); ++i)
+        {
+            if (!equalNodes(a->children[i].get(), b->children[i].get()))
+                return false;
+        }
+        return true;
+    }
+
+    /// Add to diff the entries under n which base (whose node at the same position is b,
+    /// if any) lacks or maps to another value
+    static void collectDifference(const Node* n, const Node* b, const PersistentIDMap& base,
+                                  PersistentIDMap& diff)
+    {
+        for (const EntryPtr& e : n->data)
+        {
+            const V* v = base.lookup(e->first);
+            if (!v || (v != &e->second && !v->equals(e->second)))
+                update(diff.mutableRoot(), 0, e->first, true, e);
+        }
+        for (u32_t slots = n->nodeMap; slots; slots &= slots - 1)
+        {
+            u32_t bit = slots & (~slots + 1);
+            const Node* child = n->children[index(n->nodeMap, bit)].get();
+            const Node* bchild = b && (b->nodeMap & bit) ? b->children[index(b->nodeMap, bit)].get() : nullptr;
+            if (child != bchild)
+                collectDifference(child, bchild, base, diff);
+        }
+    }
+
+    template<typename F>
+    static void mergeNodes(Node* n, const Node* r, u32_t shift, F& f, bool addMissing)
+    {
+        for (u32_t slots = r->dataMap | r->nodeMap; slots; slots &= slots - 1)
+        {
+            u32_t bit = slots & (~slots + 1);
+            if (r->dataMap & bit)
+                mergeEntry(n, shift, r->data[index(r->dataMap, bit)], f, addMissing);
+            else if (n->nodeMap & bit)
+            {
+                NodePtr& child = n->children[index(n->nodeMap, bit)];
+                const NodePtr& rchild = r->children[index(r->nodeMap, bit)];
+                if (child == rchild)
+                    continue;
+                makeUnique(child);
+                mergeNodes(child.get(), rchild.get(), shift + Bits, f, addMissing);
+            }
+            else if (n->dataMap & bit)
+                mergeSubtree(n, shift, r->children[index(r->nodeMap, bit)].get(), f, addMissing);
+            else if (addMissing)
+            {
+                n->nodeMap |= bit;
+                n->children.insert(n->children.begin() + index(n->nodeMap, bit),
+                                   r->children[index(r->nodeMap, bit)]);
+            }
+        }
+        n->size = n->data.size();
+        for (const NodePtr& child : n->children)
+            n->size += child->size;
+    }
+
+    /// Merge every entry of the subtree r into the private node n
+    template<typename F>
+    static void mergeSubtree(Node* n, u32_t shift, const Node* r, F& f, bool addMissing)
+    {
+        for (const EntryPtr& e : r->data)
+            mergeEntry(n, shift, e, f, addMissing);
+        for (const NodePtr& child : r->children)
+            mergeSubtree(n, shift, child.get(), f, addMissing);
+    }
+
+    template<typename F>
+    static void mergeEntry(Node* n, u32_t shift, const EntryPtr& re, F& f, bool addMissing)
+    {
+        EntryPtr* e = update(n, shift, re->first, addMissing, re);
+        if (!e || *e == re || (*e)->second.equals(re->second))
+            return;
+        makeUnique(*e);
+        f((*e)->second, re->second);
+    }
+
+    NodePtr root;
+};
+
+} // End namespace SVF
+
+#endif /* PERSISTENTIDMAP_H_ */
@@ -0,0 +1,276 @@
+//===- RoaringBitVector.h -- Compressed bitmap data structure ------------//
+
+/*
+ * RoaringBitVector.h
+ *
+ * Compressed bitmap made up of array, bitmap, and run containers, each
+ * holding a 2^16 chunk of the universe (a la Roaring bitmaps).
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef ROARINGBITVECTOR_H_
+#define ROARINGBITVECTOR_H_
+
+#include <assert.h>
+#include <vector>
+
+#include "SVFIR/SVFType.h"
+
+namespace SVF
+{
+
+/// A compressed bitmap which splits the universe into chunks of 2^16 bits and
+/// only stores the non-empty chunks, each in one of three containers:
+///  - array:  sorted low 16 bits of the elements, for sparse chunks,
+///  - bitmap: the 2^16 bits of the chunk, for dense chunks,
+///  - run:    sorted, maximal [start, last] intervals, for clustered chunks.
+/// Containers are picked to minimise space whenever a chunk is rebuilt by a
+/// set operation, so both very sparse sets (few elements spread across the
+/// node space) and very dense ones (e.g. objects of large arrays and heap
+/// clones numbered consecutively) stay compact. Operations on dense containers
+/// work on whole words with simple loops which compilers vectorise.
+/// Abbreviated RBV.
+class RoaringBitVector
+{
+public:
+    typedef unsigned long long Word;
+
+    /// Number of low bits of an element stored in its container.
+    static const u32_t ChunkBits = 16;
+    /// Number of words of a bitmap container.
+    static const u32_t BitmapWords = (1u << ChunkBits) / (sizeof(Word) * 8);
+    /// Array containers larger than this are converted into bitmaps.
+    static const u32_t MaxArraySize = 4096;
+
+    class RoaringBitVectorIterator;
+    typedef RoaringBitVectorIterator const_iterator;
+    typedef const_iterator iterator;
+
+public:
+    /// Construct empty RBV.
+    RoaringBitVector(void) = default;
+
+    RoaringBitVector(const RoaringBitVector &rbv) = default;
+    RoaringBitVector(RoaringBitVector &&rbv) = default;
+    RoaringBitVector &operator=(const RoaringBitVector &rhs) = default;
+    RoaringBitVector &operator=(RoaringBitVector &&rhs) = default;
+
+    /// Returns true if no bits are set.
+    bool empty(void) const
+    {
+        return containers.empty();
+    }
+
+    /// Returns number of bits set.
+    u32_t count(void) const;
+
+    /// Empty the RBV.
+    void clear(void);
+
+    /// Returns true if bit is set in this RBV.
+    bool test(u32_t bit) const;
+
+    /// Check if bit is set. If it is, returns false.
+    /// Otherwise, sets bit and returns true.
+    bool test_and_set(u32_t bit);
+
+    /// Sets bit in the RBV.
+    void set(u32_t bit);
+
+    /// Resets bit in the RBV.
+    void reset(u32_t bit);
+
+    /// Returns true if this RBV is a superset of rhs.
+    bool contains(const RoaringBitVector &rhs) const;
+
+    /// Returns true if this RBV and rhs share any set bits.
+    bool intersects(const RoaringBitVector &rhs) const;
+
+    /// Returns true if this RBV and rhs have the same bits set.
+    bool operator==(const RoaringBitVector &rhs) const;
+
+    /// Returns true if either this RBV or rhs has a bit set unique to the other.
+    bool operator!=(const RoaringBitVector &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /// Put union of this RBV and rhs into this RBV.
+    /// Returns true if RBV changed.
+    bool operator|=(const RoaringBitVector &rhs);
+
+    /// Put intersection of this RBV and rhs into this RBV.
+    /// Returns true if RBV changed.
+    bool operator&=(const RoaringBitVector &rhs);
+
+    /// Remove set bits in rhs from this RBV.
+    /// Returns true if RBV changed.
+    bool operator-=(const RoaringBitVector &rhs)
+    {
+        return intersectWithComplement(rhs);
+    }
+
+    /// Put intersection of this RBV with complement of rhs into this RBV.
+    /// Returns true if this RBV changed.
+    bool intersectWithComplement(const RoaringBitVector &rhs);
+
+    /// Put intersection of lhs with complement of rhs into this RBV.
+    void intersectWithComplement(const RoaringBitVector &lhs, const RoaringBitVector &rhs);
+
+    /// Hash for this RBV. Independent of the containers used.
+    size_t hash(void) const;
+
+    /// Heap memory used by the containers, in bytes.
+    size_t getMemoryUsage(void) const;
+
+    const_iterator begin(void) const;
+    const_iterator end(void) const;
+
+private:
+    /// Set operation performed on a pair of containers.
+    enum SetOp
+    {
+        UnionOp,
+        IntersectOp,
+        DifferenceOp,
+    };
+
+    /// Elements of one chunk. Never empty.
+    struct Container
+    {
+        enum Kind : u8_t
+        {
+            ArrayContainer,
+            BitmapContainer,
+            RunContainer,
+        };
+
+        /// High bits shared by all elements.
+        u16_t key;
+        Kind kind;
+        /// Number of elements.
+        u32_t card;
+        /// Array: sorted elements. Run: flattened [start, last] pairs.
+        std::vector<u16_t> vals;
+        /// Bitmap: BitmapWords words.
+        std::vector<Word> bits;
+
+        Container(u16_t key) : key(key), kind(ArrayContainer), card(0) { }
+    };
+
+    /// Index of the container with key, or of where it would be inserted.
+    size_t findContainer(u16_t key) const;
+
+    static inline u16_t highBits(u32_t bit)
+    {
+        return (u16_t)(bit >> ChunkBits);
+    }
+    static inline u16_t lowBits(u32_t bit)
+    {
+        return (u16_t)bit;
+    }
+
+    /// Operations on single containers.
+    ///@{
+    static bool containerTest(const Container &c, u16_t low);
+    /// Writes the elements of c as a bitmap into words (BitmapWords long).
+    static void toBitmap(const Container &c, Word *words);
+    /// Makes c hold exactly the bits of words using the smallest container
+    /// (runs are only considered when allowRuns). Returns false if words is empty.
+    static bool fromBitmap(Container &c, const Word *words, bool allowRuns = true);
+    /// Turns a run container into an array or a bitmap, which support cheap
+    /// single bit updates.
+    static void unpackRuns(Container &c);
+    /// Performs c = c op rhs. Returns true if c changed. c may end up empty.
+    static bool containerOp(Container &c, const Container &rhs, SetOp op);
+    static bool containerIntersects(const Container &lhs, const Container &rhs);
+    /// Returns true if lhs and rhs (with the same key) hold the same elements.
+    static bool containerEquals(const Container &lhs, const Container &rhs);
+    ///@}
+
+public:
+    class RoaringBitVectorIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = u32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = u32_t *;
+        using reference = u32_t &;
+
+        RoaringBitVectorIterator(void) = delete;
+
+        /// Returns an iterator to the beginning of rbv if end is false, and to
+        /// the end of rbv if end is true.
+        RoaringBitVectorIterator(const RoaringBitVector *rbv, bool end=false);
+
+        RoaringBitVectorIterator(const RoaringBitVectorIterator &it) = default;
+        RoaringBitVectorIterator(RoaringBitVectorIterator &&it) = default;
+
+        RoaringBitVectorIterator &operator=(const RoaringBitVectorIterator &it) = default;
+        RoaringBitVectorIterator &operator=(RoaringBitVectorIterator &&it) = default;
+
+        /// Pre-increment: ++it.
+        const RoaringBitVectorIterator &operator++(void);
+
+        /// Post-increment: it++.
+        const RoaringBitVectorIterator operator++(int);
+
+        /// Dereference: *it.
+        u32_t operator*(void) const
+        {
+            assert(!atEnd() && "RoaringBitVectorIterator::*: dereferencing end!");
+            return ((u32_t)rbv->containers[containerIdx].key << ChunkBits) | low;
+        }
+
+        /// Equality: *this == rhs.
+        bool operator==(const RoaringBitVectorIterator &rhs) const
+        {
+            assert(rbv == rhs.rbv && "RoaringBitVectorIterator::==: comparing iterators from different RBVs!");
+            return containerIdx == rhs.containerIdx && pos == rhs.pos && low == rhs.low;
+        }
+
+        /// Inequality: *this != rhs.
+        bool operator!=(const RoaringBitVectorIterator &rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        bool atEnd(void) const
+        {
+            return containerIdx >= rbv->containers.size();
+        }
+
+        /// Moves to the first element of the current container (or the end).
+        void enterContainer(void);
+
+    private:
+        /// RoaringBitVector we are iterating over.
+        const RoaringBitVector *rbv;
+        /// Container we are in.
+        size_t containerIdx;
+        /// Array: index of the element. Run: index of the run. Bitmap: unused.
+        u32_t pos;
+        /// Low bits of the current element.
+        u32_t low;
+    };
+
+private:
+    /// Non-empty containers, sorted by key.
+    std::vector<Container> containers;
+};
+
+template <>
+struct Hash<RoaringBitVector>
+{
+    size_t operator()(const RoaringBitVector &rbv) const
+    {
+        return rbv.hash();
+    }
+};
+
+} // End namespace SVF
+
+#endif  // ROARINGBITVECTOR_H_
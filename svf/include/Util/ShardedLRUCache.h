@@ -0,0 +1,123 @@
+//===- ShardedLRUCache.h -- Bounded cache shared between threads --------------//
+
+/*
+ * ShardedLRUCache.h
+ *
+ * A bounded key-value cache evicting the least recently used entries. Keys are
+ * spread over independently locked shards so that concurrent clients rarely
+ * contend.
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SHARDEDLRUCACHE_H_
+#define SHARDEDLRUCACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "Util/GeneralType.h"
+
+namespace SVF
+{
+
+template<typename Key, typename Value, typename KeyHash = Hash<Key>>
+class ShardedLRUCache
+{
+public:
+    /// At most capacity entries (rounded up to a multiple of numShards) are kept.
+    /// A capacity of 0 disables the cache.
+    ShardedLRUCache(size_t capacity, u32_t numShards = 64)
+        : numShards(numShards), shardCapacity((capacity + numShards - 1) / numShards),
+          shards(std::make_unique<Shard[]>(numShards))
+    {
+    }
+
+    ShardedLRUCache(const ShardedLRUCache&) = delete;
+    ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+
+    inline bool enabled() const
+    {
+        return shardCapacity != 0;
+    }
+
+    /// Sets value and returns true if key is cached
+    bool get(const Key& key, Value& value)
+    {
+        if (!enabled()) return false;
+
+        Shard& shard = getShard(key);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        typename Shard::Index::iterator it = shard.index.find(key);
+        if (it == shard.index.end()) return false;
+
+        // Move to the front: most recently used.
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    /// Caches value for key, evicting the least recently used entry of its shard if full
+    void put(const Key& key, const Value& value)
+    {
+        if (!enabled()) return;
+
+        Shard& shard = getShard(key);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        typename Shard::Index::iterator it = shard.index.find(key);
+        if (it != shard.index.end())
+        {
+            it->second->second = value;
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            return;
+        }
+
+        if (shard.entries.size() == shardCapacity)
+        {
+            shard.index.erase(shard.entries.back().first);
+            shard.entries.pop_back();
+        }
+        shard.entries.emplace_front(key, value);
+        shard.index[key] = shard.entries.begin();
+    }
+
+    void clear()
+    {
+        for (u32_t i = 0; i < numShards; ++i)
+        {
+            std::lock_guard<std::mutex> guard(shards[i].lock);
+            shards[i].entries.clear();
+            shards[i].index.clear();
+        }
+    }
+
+private:
+    struct Shard
+    {
+        typedef std::list<std::pair<Key, Value>> Entries;
+        typedef Map<Key, typename Entries::iterator, KeyHash> Index;
+
+        std::mutex lock;
+        Entries entries;	///< most recently used first
+        Index index;
+    };
+
+    inline Shard& getShard(const Key& key)
+    {
+        size_t h = KeyHash()(key);
+        // Keys like pointers or IDs often differ in their high bits only.
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return shards[h % numShards];
+    }
+
+    u32_t numShards;
+    size_t shardCapacity;
+    std::unique_ptr<Shard[]> shards;
+};
+
+} // End namespace SVF
+
+#endif /* SHARDEDLRUCACHE_H_ */
@@ -13,8 +13,24 @@
 #include <cstring>
 #include <climits>
 #include <limits>
+#include <algorithm>
 #include <iterator>
 #include <list>
+#include <type_traits>
+#include <vector>
+
+#include <Util/config.h>
+
+// Bits per element of SparseBitVector<>, set through the CMake variable of the
+// same name. Larger elements suit denser sets and let the word loops vectorise.
+#ifndef SVF_SBV_ELEMENT_SIZE
+#define SVF_SBV_ELEMENT_SIZE 128
+#endif
+// Whether SparseBitVector<> stores its elements in a vector rather than a list
+// (see SparseBitVector), set through the CMake option of the same name.
+#ifndef SVF_SBV_FLAT_LAYOUT
+#define SVF_SBV_FLAT_LAYOUT 0
+#endif
 
 // Appease GCC?
 #ifdef __has_builtin
@@ -256,7 +272,7 @@ inline unsigned countPopulation(T Value)
 /// have better worst cases for insertion in the middle (various balanced trees,
 /// etc) do not perform as well in practice as a linked list with this iterator
 /// kept up to date.  They are also significantly more memory intensive.
-template <unsigned ElementSize = 128> struct SparseBitVectorElement
+template <unsigned ElementSize = SVF_SBV_ELEMENT_SIZE> struct SparseBitVectorElement
 {
 
 public:
@@ -282,14 +298,16 @@ public:
     explicit SparseBitVectorElement(unsigned Idx) :  ElementIndex(Idx) {}
 
     // Comparison.
+    // The word loops below avoid early exits and data-dependent branches so
+    // that they are vectorised (e.g., into SSE2/AVX2 for larger elements).
     bool operator==(const SparseBitVectorElement &RHS) const
     {
         if (ElementIndex != RHS.ElementIndex)
             return false;
+        BitWord Diff = 0;
         for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i)
-            if (Bits[i] != RHS.Bits[i])
-                return false;
-        return true;
+            Diff |= Bits[i] ^ RHS.Bits[i];
+        return Diff == 0;
     }
 
     bool operator!=(const SparseBitVectorElement &RHS) const
@@ -311,10 +329,10 @@ public:
 
     bool empty() const
     {
+        BitWord Any = 0;
         for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i)
-            if (Bits[i])
-                return false;
-        return true;
+            Any |= Bits[i];
+        return Any == 0;
     }
 
     void set(unsigned Idx)
@@ -404,27 +422,23 @@ public:
     // Union this element with RHS and return true if this one changed.
     bool unionWith(const SparseBitVectorElement &RHS)
     {
-        bool changed = false;
+        BitWord Changed = 0;
         for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i)
         {
-            BitWord old = changed ? 0 : Bits[i];
-
-            Bits[i] |= RHS.Bits[i];
-            if (!changed && old != Bits[i])
-                changed = true;
+            const BitWord New = Bits[i] | RHS.Bits[i];
+            Changed |= New ^ Bits[i];
+            Bits[i] = New;
         }
-        return changed;
+        return Changed != 0;
     }
 
     // Return true if we have any bits in common with RHS
     bool intersects(const SparseBitVectorElement &RHS) const
     {
+        BitWord Common = 0;
         for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i)
-        {
-            if (RHS.Bits[i] & Bits[i])
-                return true;
-        }
-        return false;
+            Common |= RHS.Bits[i] & Bits[i];
+        return Common != 0;
     }
 
     // Intersect this Element with RHS and return true if this one changed.
@@ -432,23 +446,17 @@ public:
     bool intersectWith(const SparseBitVectorElement &RHS,
                        bool &BecameZero)
     {
-        bool changed = false;
-        bool allzero = true;
-
-        BecameZero = false;
+        BitWord Changed = 0;
+        BitWord Remaining = 0;
         for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i)
         {
-            BitWord old = changed ? 0 : Bits[i];
-
-            Bits[i] &= RHS.Bits[i];
-            if (Bits[i] != 0)
-                allzero = false;
-
-            if (!changed && old != Bits[i])
-                changed = true;
+            const BitWord New = Bits[i] & RHS.Bits[i];
+            Changed |= New ^ Bits[i];
+            Remaining |= New;
+            Bits[i] = New;
         }
-        BecameZero = allzero;
-        return changed;
+        BecameZero = Remaining == 0;
+        return Changed != 0;
     }
 
     // Intersect this Element with the complement of RHS and return true if this
@@ -457,23 +465,17 @@ public:
     bool intersectWithComplement(const SparseBitVectorElement &RHS,
                                  bool &BecameZero)
     {
-        bool changed = false;
-        bool allzero = true;
-
-        BecameZero = false;
+        BitWord Changed = 0;
+        BitWord Remaining = 0;
         for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i)
         {
-            BitWord old = changed ? 0 : Bits[i];
-
-            Bits[i] &= ~RHS.Bits[i];
-            if (Bits[i] != 0)
-                allzero = false;
-
-            if (!changed && old != Bits[i])
-                changed = true;
+            const BitWord New = Bits[i] & ~RHS.Bits[i];
+            Changed |= New ^ Bits[i];
+            Remaining |= New;
+            Bits[i] = New;
         }
-        BecameZero = allzero;
-        return changed;
+        BecameZero = Remaining == 0;
+        return Changed != 0;
     }
 
     // Three argument version of intersectWithComplement that intersects
@@ -482,24 +484,29 @@ public:
                                  const SparseBitVectorElement &RHS2,
                                  bool &BecameZero)
     {
-        bool allzero = true;
-
-        BecameZero = false;
+        BitWord Remaining = 0;
         for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i)
         {
             Bits[i] = RHS1.Bits[i] & ~RHS2.Bits[i];
-            if (Bits[i] != 0)
-                allzero = false;
+            Remaining |= Bits[i];
         }
-        BecameZero = allzero;
+        BecameZero = Remaining == 0;
     }
 };
 
-template <unsigned ElementSize = 128>
+/// FlatLayout selects how the elements are stored:
+///  - false: a std::list, as described above, with the current element cached
+///    for in-order accesses.
+///  - true: a sorted std::vector, so that a set is a single allocation without
+///    per-element pointers, and operations stream through contiguous memory.
+///    Elements are located by binary search. Inserting in the middle shifts the
+///    following elements, which is cheap for the (mostly small) points-to sets.
+template <unsigned ElementSize = SVF_SBV_ELEMENT_SIZE, bool FlatLayout = SVF_SBV_FLAT_LAYOUT>
 class SparseBitVector
 {
 
-    using ElementList = std::list<SparseBitVectorElement<ElementSize>>;
+    using Element = SparseBitVectorElement<ElementSize>;
+    using ElementList = typename std::conditional<FlatLayout, std::vector<Element>, std::list<Element>>::type;
     using ElementListIter = typename ElementList::iterator;
     using ElementListConstIter = typename ElementList::const_iterator;
     enum
@@ -524,9 +531,20 @@ class SparseBitVector
         // 'this' is always const in this particular function and we sort out the
         // difference in FindLowerBound and FindLowerBoundConst.
         ElementListIter Begin =
-            const_cast<SparseBitVector<ElementSize> *>(this)->Elements.begin();
+            const_cast<SparseBitVector *>(this)->Elements.begin();
         ElementListIter End =
-            const_cast<SparseBitVector<ElementSize> *>(this)->Elements.end();
+            const_cast<SparseBitVector *>(this)->Elements.end();
+
+        // Iterators into a vector do not survive insertions, so the flat layout
+        // does not cache the current element and binary searches instead.
+        if constexpr (FlatLayout)
+        {
+            return std::lower_bound(Begin, End, ElementIndex,
+                                    [](const Element &E, unsigned Idx)
+            {
+                return E.index() < Idx;
+            });
+        }
 
         if (Elements.empty())
         {
@@ -569,6 +587,33 @@ class SparseBitVector
         return FindLowerBoundImpl(ElementIndex);
     }
 
+    // Flat layout only: unions [RHSIter, RHSEnd) into the elements from Iter
+    // onwards (those before Iter are done) by merging into a new vector.
+    void mergeRemaining(ElementListIter Iter, ElementListConstIter RHSIter,
+                        ElementListConstIter RHSEnd)
+    {
+        ElementList Merged;
+        Merged.reserve(Elements.size() + (RHSEnd - RHSIter));
+        Merged.insert(Merged.end(), std::make_move_iterator(Elements.begin()),
+                      std::make_move_iterator(Iter));
+        while (Iter != Elements.end() && RHSIter != RHSEnd)
+        {
+            if (Iter->index() < RHSIter->index())
+                Merged.push_back(*Iter++);
+            else if (Iter->index() > RHSIter->index())
+                Merged.push_back(*RHSIter++);
+            else
+            {
+                Merged.push_back(*Iter++);
+                Merged.back().unionWith(*RHSIter++);
+            }
+        }
+        Merged.insert(Merged.end(), Iter, Elements.end());
+        Merged.insert(Merged.end(), RHSIter, RHSEnd);
+        Elements.swap(Merged);
+        CurrElementIter = Elements.begin();
+    }
+
     // Iterator to walk set bits in the bitmap.  This iterator is a lot uglier
     // than it would be, in order to be efficient.
     class SparseBitVectorIterator
@@ -576,7 +621,7 @@ class SparseBitVector
     private:
         bool AtEnd;
 
-        const SparseBitVector<ElementSize> *BitVector = nullptr;
+        const SparseBitVector *BitVector = nullptr;
 
         // Current element inside of bitmap.
         ElementListConstIter Iter;
@@ -659,7 +704,7 @@ class SparseBitVector
     public:
         SparseBitVectorIterator() = delete;
 
-        SparseBitVectorIterator(const SparseBitVector<ElementSize> *RHS,
+        SparseBitVectorIterator(const SparseBitVector *RHS,
                                 bool end = false):BitVector(RHS)
         {
             Iter = BitVector->Elements.begin();
@@ -777,7 +822,8 @@ public:
         // When the element is zeroed out, delete it.
         if (ElementIter->empty())
         {
-            ++CurrElementIter;
+            if constexpr (!FlatLayout)
+                ++CurrElementIter;
             Elements.erase(ElementIter);
         }
     }
@@ -859,6 +905,13 @@ public:
         {
             if (Iter1 == Elements.end() || Iter1->index() > Iter2->index())
             {
+                if constexpr (FlatLayout)
+                {
+                    // Inserting one by one would shift the tail of the vector
+                    // each time, so merge the rest into a new vector instead.
+                    mergeRemaining(Iter1, Iter2, RHS.Elements.end());
+                    return true;
+                }
                 Elements.insert(Iter1, *Iter2);
                 ++Iter2;
                 changed = true;
@@ -911,9 +964,7 @@ public:
                 changed |= Iter1->intersectWith(*Iter2, BecameZero);
                 if (BecameZero)
                 {
-                    ElementListIter IterTmp = Iter1;
-                    ++Iter1;
-                    Elements.erase(IterTmp);
+                    Iter1 = Elements.erase(Iter1);
                 }
                 else
                 {
@@ -923,9 +974,7 @@ public:
             }
             else
             {
-                ElementListIter IterTmp = Iter1;
-                ++Iter1;
-                Elements.erase(IterTmp);
+                Iter1 = Elements.erase(Iter1);
                 changed = true;
             }
         }
@@ -979,9 +1028,7 @@ public:
                 changed |= Iter1->intersectWithComplement(*Iter2, BecameZero);
                 if (BecameZero)
                 {
-                    ElementListIter IterTmp = Iter1;
-                    ++Iter1;
-                    Elements.erase(IterTmp);
+                    Iter1 = Elements.erase(Iter1);
                 }
                 else
                 {
@@ -998,15 +1045,15 @@ public:
         return changed;
     }
 
-    bool intersectWithComplement(const SparseBitVector<ElementSize> *RHS) const
+    bool intersectWithComplement(const SparseBitVector *RHS) const
     {
         return intersectWithComplement(*RHS);
     }
 
     //  Three argument version of intersectWithComplement.
     //  Result of RHS1 & ~RHS2 is stored into this bitmap.
-    void intersectWithComplement(const SparseBitVector<ElementSize> &RHS1,
-                                 const SparseBitVector<ElementSize> &RHS2)
+    void intersectWithComplement(const SparseBitVector &RHS1,
+                                 const SparseBitVector &RHS2)
     {
         if (this == &RHS1)
         {
@@ -1060,19 +1107,19 @@ public:
         std::copy(Iter1, RHS1.Elements.end(), std::back_inserter(Elements));
     }
 
-    void intersectWithComplement(const SparseBitVector<ElementSize> *RHS1,
-                                 const SparseBitVector<ElementSize> *RHS2)
+    void intersectWithComplement(const SparseBitVector *RHS1,
+                                 const SparseBitVector *RHS2)
     {
         intersectWithComplement(*RHS1, *RHS2);
     }
 
-    bool intersects(const SparseBitVector<ElementSize> *RHS) const
+    bool intersects(const SparseBitVector *RHS) const
     {
         return intersects(*RHS);
     }
 
     // Return true if we share any bits in common with RHS
-    bool intersects(const SparseBitVector<ElementSize> &RHS) const
+    bool intersects(const SparseBitVector &RHS) const
     {
         ElementListConstIter Iter1 = Elements.begin();
         ElementListConstIter Iter2 = RHS.Elements.begin();
@@ -1108,9 +1155,9 @@ public:
 
     // Return true iff all bits set in this SparseBitVector are
     // also set in RHS.
-    bool contains(const SparseBitVector<ElementSize> &RHS) const
+    bool contains(const SparseBitVector &RHS) const
     {
-        SparseBitVector<ElementSize> Result(*this);
+        SparseBitVector Result(*this);
         Result &= RHS;
         return (Result == RHS);
     }
@@ -1150,6 +1197,15 @@ public:
         return BitCount;
     }
 
+    /// Approximate heap memory used by the elements, in bytes.
+    size_t getMemoryUsage() const
+    {
+        if constexpr (FlatLayout)
+            return Elements.capacity() * sizeof(Element);
+        // Each list node holds an element plus the previous/next pointers.
+        return Elements.size() * (sizeof(Element) + 2 * sizeof(void*));
+    }
+
     iterator begin() const
     {
         return iterator(this);
@@ -1164,73 +1220,73 @@ public:
 // Convenience functions to allow Or and And without dereferencing in the user
 // code.
 
-template <unsigned ElementSize>
-inline bool operator |=(SparseBitVector<ElementSize> &LHS,
-                        const SparseBitVector<ElementSize> *RHS)
+template <unsigned ElementSize, bool FlatLayout>
+inline bool operator |=(SparseBitVector<ElementSize, FlatLayout> &LHS,
+                        const SparseBitVector<ElementSize, FlatLayout> *RHS)
 {
     return LHS |= *RHS;
 }
 
-template <unsigned ElementSize>
-inline bool operator |=(SparseBitVector<ElementSize> *LHS,
-                        const SparseBitVector<ElementSize> &RHS)
+template <unsigned ElementSize, bool FlatLayout>
+inline bool operator |=(SparseBitVector<ElementSize, FlatLayout> *LHS,
+                        const SparseBitVector<ElementSize, FlatLayout> &RHS)
 {
     return LHS->operator|=(RHS);
 }
 
-template <unsigned ElementSize>
-inline bool operator &=(SparseBitVector<ElementSize> *LHS,
-                        const SparseBitVector<ElementSize> &RHS)
+template <unsigned ElementSize, bool FlatLayout>
+inline bool operator &=(SparseBitVector<ElementSize, FlatLayout> *LHS,
+                        const SparseBitVector<ElementSize, FlatLayout> &RHS)
 {
     return LHS->operator&=(RHS);
 }
 
-template <unsigned ElementSize>
-inline bool operator &=(SparseBitVector<ElementSize> &LHS,
-                        const SparseBitVector<ElementSize> *RHS)
+template <unsigned ElementSize, bool FlatLayout>
+inline bool operator &=(SparseBitVector<ElementSize, FlatLayout> &LHS,
+                        const SparseBitVector<ElementSize, FlatLayout> *RHS)
 {
     return LHS &= *RHS;
 }
 
 // Convenience functions for infix union, intersection, difference operators.
 
-template <unsigned ElementSize>
-inline SparseBitVector<ElementSize>
-operator|(const SparseBitVector<ElementSize> &LHS,
-          const SparseBitVector<ElementSize> &RHS)
+template <unsigned ElementSize, bool FlatLayout>
+inline SparseBitVector<ElementSize, FlatLayout>
+operator|(const SparseBitVector<ElementSize, FlatLayout> &LHS,
+          const SparseBitVector<ElementSize, FlatLayout> &RHS)
 {
-    SparseBitVector<ElementSize> Result(LHS);
+    SparseBitVector<ElementSize, FlatLayout> Result(LHS);
     Result |= RHS;
     return Result;
 }
 
-template <unsigned ElementSize>
-inline SparseBitVector<ElementSize>
-operator&(const SparseBitVector<ElementSize> &LHS,
-          const SparseBitVector<ElementSize> &RHS)
+template <unsigned ElementSize, bool FlatLayout>
+inline SparseBitVector<ElementSize, FlatLayout>
+operator&(const SparseBitVector<ElementSize, FlatLayout> &LHS,
+          const SparseBitVector<ElementSize, FlatLayout> &RHS)
 {
-    SparseBitVector<ElementSize> Result(LHS);
+    SparseBitVector<ElementSize, FlatLayout> Result(LHS);
     Result &= RHS;
     return Result;
 }
 
-template <unsigned ElementSize>
-inline SparseBitVector<ElementSize>
-operator-(const SparseBitVector<ElementSize> &LHS,
-          const SparseBitVector<ElementSize> &RHS)
+template <unsigned ElementSize, bool FlatLayout>
+inline SparseBitVector<ElementSize, FlatLayout>
+operator-(const SparseBitVector<ElementSize, FlatLayout> &LHS,
+          const SparseBitVector<ElementSize, FlatLayout> &RHS)
 {
-    SparseBitVector<ElementSize> Result;
+    SparseBitVector<ElementSize, FlatLayout> Result;
     Result.intersectWithComplement(LHS, RHS);
     return Result;
 }
 
 // Dump a SparseBitVector to a stream
-template <unsigned ElementSize>
-void dump(const SparseBitVector<ElementSize> &LHS, std::ostream &out)
+template <unsigned ElementSize, bool FlatLayout>
+void dump(const SparseBitVector<ElementSize, FlatLayout> &LHS, std::ostream &out)
 {
     out << "[";
 
-    typename SparseBitVector<ElementSize>::iterator bi = LHS.begin(),
+    typename SparseBitVector<ElementSize, FlatLayout>::iterator bi = LHS.begin(),
                                                     be = LHS.end();
     if (bi != be)
     {
@@ -0,0 +1,92 @@
+//===- ThreadPool.h -- Work-stealing pool of worker threads ------------------//
+
+/*
+ * ThreadPool.h
+ *
+ * A fixed-size pool of worker threads executing index ranges with work stealing.
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SVFIR/SVFType.h"
+
+namespace SVF
+{
+
+/// Pool of long-lived worker threads used by the parallel solvers.
+/// Work is submitted as a parallel loop over [0, n): the index range is split
+/// evenly into one range per worker and each worker consumes its own range from
+/// the front. A worker which runs out of work steals the back half of the largest
+/// remaining range of another worker, so irregular per-index costs (e.g., nodes
+/// with very different points-to set sizes) are balanced dynamically.
+/// The calling thread takes part in the loop as worker 0.
+class ThreadPool
+{
+public:
+    /// Loop body: (index, worker ID). Worker IDs are in [0, getNumThreads()).
+    typedef std::function<void(u32_t, u32_t)> LoopBody;
+
+    /// Creates numThreads - 1 background threads (the caller is the last worker).
+    explicit ThreadPool(u32_t numThreads);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    inline u32_t getNumThreads() const
+    {
+        return numThreads;
+    }
+
+    /// Runs body(i, worker) for every i in [0, n) and returns when all are done.
+    /// Must not be called re-entrantly from within a loop body.
+    void parallelFor(u32_t n, const LoopBody& body);
+
+private:
+    /// Index range owned by a worker. Stolen from the back, consumed from the front.
+    struct WorkRange
+    {
+        std::mutex lock;
+        u32_t begin = 0;
+        u32_t end = 0;
+    };
+
+    /// Executes loop iterations until no range has work left.
+    void runWorker(u32_t worker);
+    /// Takes the next index from the worker's own range.
+    bool popOwn(u32_t worker, u32_t& idx);
+    /// Steals half of another worker's range into the worker's own range.
+    bool steal(u32_t worker, u32_t& idx);
+    /// Main loop of background threads.
+    void threadLoop(u32_t worker);
+
+    u32_t numThreads;
+    std::unique_ptr<WorkRange[]> ranges;
+    std::vector<std::thread> threads;
+
+    /// Synchronisation between parallelFor and the background threads.
+    ///@{
+    std::mutex poolMutex;
+    std::condition_variable wakeCV;
+    std::condition_variable doneCV;
+    const LoopBody* currentBody;
+    u64_t generation;
+    u32_t pending;
+    bool stop;
+    ///@}
+};
+
+} // End namespace SVF
+
+#endif /* THREADPOOL_H_ */
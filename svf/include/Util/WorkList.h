@@ -39,9 +39,12 @@
 #include "SVFIR/SVFValue.h"
 
 #include <assert.h>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <vector>
 #include <deque>
+#include <queue>
 #include <set>
 
 namespace SVF
@@ -312,6 +315,189 @@ private:
     DataVector data_list;    ///< work list using std::vector.
 };
 
+/**
+ * Worklist of node IDs whose order is picked at runtime by a Policy:
+ *  - FIFO:     first in first out, as FIFOWorkList.
+ *  - LRF:      least recently fired first, i.e., the node popped the longest
+ *              time ago (or never) goes first.
+ *  - Topo:     lowest topological rank first (ranks are given by setRank).
+ *  - TwoPhase: divide and conquer; nodes pushed while the current phase is
+ *              processed are deferred to the next phase, and each phase is
+ *              processed in topological rank order.
+ * Ties are broken in FIFO order.
+ * Elements in the list are unique as they're recorded by Set.
+ */
+class PolicyWorkList
+{
+public:
+    enum Policy
+    {
+        FIFO,
+        LRF,
+        Topo,
+        TwoPhase,
+    };
+
+    /// Rank of nodes with no rank set, processed after all ranked nodes.
+    static constexpr u32_t Unranked = UINT32_MAX;
+
+    PolicyWorkList(Policy policy = FIFO) : policy(policy), pushes(0), pops(0) {}
+
+    ~PolicyWorkList() {}
+
+    /// Change the policy. The work list must be empty.
+    inline void setPolicy(Policy p)
+    {
+        assert(empty() && "changing the policy of a non-empty work list!");
+        policy = p;
+    }
+    inline Policy getPolicy() const
+    {
+        return policy;
+    }
+
+    /// Whether the policy orders nodes by their topological rank.
+    inline bool usesRanks() const
+    {
+        return policy == Topo || policy == TwoPhase;
+    }
+
+    /// Set the topological rank of a node. Lower ranks are popped first.
+    /// Only affects nodes pushed afterwards.
+    inline void setRank(NodeID id, u32_t rank)
+    {
+        if (ranks.size() <= id)
+            ranks.resize(id + 1, Unranked);
+        ranks[id] = rank;
+    }
+
+    inline bool empty() const
+    {
+        return data_set.empty();
+    }
+
+    inline u32_t size() const
+    {
+        return data_set.size();
+    }
+
+    inline bool find(const NodeID &data) const
+    {
+        return data_set.find(data) != data_set.end();
+    }
+
+    /**
+     * Push a data into the work list.
+     */
+    inline bool push(const NodeID &data)
+    {
+        if (!data_set.insert(data).second)
+            return false;
+
+        switch (policy)
+        {
+        case FIFO:
+            data_list.push_back(data);
+            break;
+        case LRF:
+            data_heap.push(Entry(lastFired(data), pushes, data));
+            break;
+        case Topo:
+            data_heap.push(Entry(getRank(data), pushes, data));
+            break;
+        case TwoPhase:
+            data_list.push_back(data);
+            break;
+        }
+        ++pushes;
+        return true;
+    }
+
+    /**
+     * Pop the next data according to the policy.
+     */
+    inline NodeID pop()
+    {
+        assert(!empty() && "work list is empty");
+        NodeID data;
+        if (policy == FIFO)
+        {
+            data = data_list.front();
+            data_list.pop_front();
+        }
+        else
+        {
+            // Start the next phase once the current one has been processed.
+            if (policy == TwoPhase && data_heap.empty())
+            {
+                u64_t seq = 0;
+                for (NodeID id : data_list)
+                    data_heap.push(Entry(getRank(id), seq++, id));
+                data_list.clear();
+            }
+            data = data_heap.top().id;
+            data_heap.pop();
+        }
+
+        ++pops;
+        if (policy == LRF)
+        {
+            if (fired.size() <= data)
+                fired.resize(data + 1, 0);
+            fired[data] = pops;
+        }
+        data_set.erase(data);
+        return data;
+    }
+
+    /*!
+     * Clear all the data
+     */
+    inline void clear()
+    {
+        data_set.clear();
+        data_list.clear();
+        data_heap = DataHeap();
+    }
+
+private:
+    /// Pending node of a heap ordered policy, ordered by (key, seq).
+    struct Entry
+    {
+        u64_t key;
+        u64_t seq;
+        NodeID id;
+
+        Entry(u64_t key, u64_t seq, NodeID id) : key(key), seq(seq), id(id) {}
+
+        inline bool operator>(const Entry &rhs) const
+        {
+            return key != rhs.key ? key > rhs.key : seq > rhs.seq;
+        }
+    };
+    typedef std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> DataHeap;
+
+    inline u32_t getRank(NodeID id) const
+    {
+        return id < ranks.size() ? ranks[id] : Unranked;
+    }
+
+    /// Pop count when id was last popped, 0 if never.
+    inline u64_t lastFired(NodeID id) const
+    {
+        return id < fired.size() ? fired[id] : 0;
+    }
+
+    Policy policy;
+    Set<NodeID> data_set;           ///< store all data in the work list.
+    std::deque<NodeID> data_list;   ///< FIFO: the work list. TwoPhase: the next phase.
+    DataHeap data_heap;             ///< LRF/Topo: the work list. TwoPhase: the current phase.
+    std::vector<u32_t> ranks;       ///< topological rank of each node.
+    std::vector<u64_t> fired;       ///< LRF: value of pops when each node was last popped.
+    u64_t pushes;                   ///< number of pushes, to break ties.
+    u64_t pops;                     ///< number of pops, the clock of LRF.
+};
+
 } // End namespace SVF
 
 #endif /* WORKLIST_H_ */
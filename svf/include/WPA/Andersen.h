@@ -41,6 +41,7 @@
 #include "SVFIR/SVFIR.h"
 #include "Graphs/ConsG.h"
 #include "Util/Options.h"
+#include "Util/ThreadPool.h"
 
 namespace SVF
 {
@@ -58,6 +59,29 @@ class AndersenBase:  public WPAConstraintSolver, public BVDataPTAImpl
 public:
     typedef OrderedMap<const CallICFGNode*, NodeID> CallSite2DummyValPN;
 
+    /// A constraint graph edge added or removed by incremental solving
+    struct Constraint
+    {
+        ConstraintEdge::ConstraintEdgeK kind;
+        NodeID src;
+        NodeID dst;
+        AccessPath ap;  ///< accessed field of NormalGep constraints
+
+        Constraint(ConstraintEdge::ConstraintEdgeK k, NodeID s, NodeID d, const AccessPath& a = AccessPath())
+            : kind(k), src(s), dst(d), ap(a)
+        {
+        }
+    };
+    typedef std::vector<Constraint> ConstraintList;
+
+    /// Offline variable substitution
+    enum VarSubst
+    {
+        NoVarSubst,     ///< Solve the constraint graph as built
+        HVNSubst,       ///< Hash-based value numbering
+        HUSubst,        ///< HVN with unions of points-to labels
+    };
+
 public:
 
     /// Constructor
@@ -112,6 +136,8 @@ public:
                  || pta->getAnalysisTy() == AndersenWaveDiff_WPA
                  || pta->getAnalysisTy() == AndersenSCD_WPA
                  || pta->getAnalysisTy() == AndersenSFR_WPA
+                 || pta->getAnalysisTy() == AndersenLCD_WPA
+                 || pta->getAnalysisTy() == AndersenHCD_WPA
                  || pta->getAnalysisTy() == TypeCPP_WPA
                  || pta->getAnalysisTy() == Steensgaard_WPA);
     }
@@ -138,6 +164,13 @@ public:
     /// Add copy edge on constraint graph
     virtual bool addCopyEdge(NodeID src, NodeID dst) = 0;
 
+    /// Incremental solving: change the constraint graph of a solved analysis and
+    /// re-solve only the points-to sets affected by the change
+    //@{
+    virtual void addConstraints(const ConstraintList& constraints);
+    virtual void removeConstraints(const ConstraintList& constraints);
+    //@}
+
     /// dump statistics
     inline void printStat()
     {
@@ -160,6 +193,10 @@ public:
     static u32_t numOfProcessedStore;  /// Number of processed Store edge
     static u32_t numOfSfrs;
     static u32_t numOfFieldExpand;
+    static u32_t numOfLCDChecks;       /// Number of lazy cycle searches
+    static u32_t numOfHCDMerges;       /// Number of nodes merged by hybrid cycle detection
+    static u32_t numOfSubstNodes;      /// Number of nodes removed by offline variable substitution
+    static u32_t numOfSubstEdges;      /// Number of edges removed by offline variable substitution
 
     static u32_t numOfSCCDetection;
     static double timeOfSCCDetection;
@@ -170,9 +207,13 @@ public:
     static double timeOfProcessCopyGep;
     static double timeOfProcessLoadStore;
     static double timeOfUpdateCallGraph;
+    static double timeOfVarSubst;
     //@}
 
 protected:
+    /// Solve the worklist and update the call graph until nothing changes
+    void solveUntilFixpoint();
+
     /// Constraint Graph
     ConstraintGraph* consCG;
     CallSite2DummyValPN
@@ -194,7 +235,7 @@ public:
 
     /// Constructor
     Andersen(SVFIR* _pag, PTATY type = Andersen_WPA, bool alias_check = true)
-        :  AndersenBase(_pag, type, alias_check)
+        :  AndersenBase(_pag, type, alias_check), varSubst(static_cast<VarSubst>(Options::AnderVarSubst()))
     {
     }
 
@@ -219,6 +260,12 @@ public:
         timeOfProcessLoadStore = 0;
     }
 
+    /// Incremental solving
+    //@{
+    void addConstraints(const ConstraintList& constraints) override;
+    void removeConstraints(const ConstraintList& constraints) override;
+    //@}
+
     /// Methods for support type inquiry through isa, cast, and dyn_cast:
     //@{
     static inline bool classof(const Andersen *)
@@ -230,25 +277,32 @@ public:
         return (pta->getAnalysisTy() == Andersen_WPA
                 || pta->getAnalysisTy() == AndersenWaveDiff_WPA
                 || pta->getAnalysisTy() == AndersenSCD_WPA
-                || pta->getAnalysisTy() == AndersenSFR_WPA);
+                || pta->getAnalysisTy() == AndersenSFR_WPA
+                || pta->getAnalysisTy() == AndersenLCD_WPA
+                || pta->getAnalysisTy() == AndersenHCD_WPA);
     }
     //@}
 
     /// Operation of points-to set
     virtual inline const PointsTo& getPts(NodeID id)
     {
-        return getPTDataTy()->getPts(sccRepNode(id));
+        id = sccRepNode(id);
+        loadMappedPts(id);
+        return getLoadedPTDataTy()->getPts(id);
     }
     virtual inline bool unionPts(NodeID id, const PointsTo& target)
     {
         id = sccRepNode(id);
-        return getPTDataTy()->unionPts(id, target);
+        loadMappedPts(id);
+        return recordUnion(getLoadedPTDataTy()->unionPts(id, target));
     }
     virtual inline bool unionPts(NodeID id, NodeID ptd)
     {
         id = sccRepNode(id);
         ptd = sccRepNode(ptd);
-        return getPTDataTy()->unionPts(id,ptd);
+        loadMappedPts(id);
+        loadMappedPts(ptd);
+        return recordUnion(getLoadedPTDataTy()->unionPts(id,ptd));
     }
 
 
@@ -259,6 +313,12 @@ public:
         Options::DetectPWC.setValue(flag);
     }
 
+    /// Offline variable substitution done by initialize (-ander-var-subst by default)
+    void setVarSubst(VarSubst subst)
+    {
+        varSubst = subst;
+    }
+
 protected:
 
     CallSite2DummyValPN callsite2DummyValPN;        ///< Map an instruction to a dummy obj which created at an indirect callsite, which invokes a heap allocator
@@ -278,7 +338,10 @@ protected:
         if (Options::DiffPts())
             return getDiffPTDataTy()->getDiffPts(rep);
         else
-            return getPTDataTy()->getPts(rep);
+        {
+            loadMappedPts(rep);
+            return getLoadedPTDataTy()->getPts(rep);
+        }
     }
 
     /// Handle propagated points-to set.
@@ -329,6 +392,59 @@ protected:
         return false;
     }
 
+    /// Incremental solving
+    //@{
+    /// Nodes whose points-to sets may depend on the points-to sets of roots
+    void collectAffectedNodes(const NodeBS& roots, NodeBS& affected);
+    /// Whether copy edge src-->dst was added by processing a load or a store
+    /// (an object on either side) between nodes which are not merged
+    bool isDerivedCopyEdge(NodeID src, NodeID dst);
+    //@}
+
+    /// Offline constraint graph used before solving. Offline node 2 * i stands for
+    /// the i-th constraint node v and offline node 2 * i + 1 for its ref node *v.
+    /// An edge a --> b means pts(a) is contained in pts(b):
+    ///	src --copy--> dst   ==>  src --> dst
+    ///	src --load--> dst   ==>  *src --> dst
+    ///	src --store--> dst  ==>  src --> *dst
+    struct OfflineGraph
+    {
+        Map<NodeID, u32_t> nodeToIdx;
+        std::vector<NodeID> idxToNode;
+        std::vector<std::vector<u32_t>> succs;
+
+        inline u32_t varIdx(NodeID id) const
+        {
+            return 2 * nodeToIdx.at(id);
+        }
+        inline u32_t refIdx(NodeID id) const
+        {
+            return 2 * nodeToIdx.at(id) + 1;
+        }
+        inline NodeID getNode(u32_t idx) const
+        {
+            return idxToNode[idx / 2];
+        }
+        static inline bool isRef(u32_t idx)
+        {
+            return idx % 2 != 0;
+        }
+    };
+    typedef std::vector<std::vector<u32_t>> OfflineSCCs;
+
+    /// Offline analyses of the constraint graph
+    //@{
+    void buildOfflineGraph(OfflineGraph& og);
+    /// All SCCs of og, in reverse topological order
+    static void findOfflineSCCs(const OfflineGraph& og, OfflineSCCs& sccs);
+    /// Merge pointer-equivalent nodes found by HVN or HU (-ander-var-subst)
+    void substituteVars();
+    /// Compare the points-to sets of all SVFIR nodes with those solved without substitution
+    void checkVarSubst();
+    //@}
+
+    VarSubst varSubst;
+
     /// Merge sub node to its rep
     virtual void mergeNodeToRep(NodeID nodeId,NodeID newRepId);
 
@@ -427,6 +543,19 @@ public:
     virtual void postProcessNode(NodeID nodeId);
     virtual bool handleLoad(NodeID id, const ConstraintEdge* load);
     virtual bool handleStore(NodeID id, const ConstraintEdge* store);
+
+protected:
+    /// Parallel wave propagation (-ander-threads > 1).
+    /// The topological order is processed as by the serial solver, except that runs of
+    /// nodes which cannot change the constraint graph (no gep edge, not a PWC node) and
+    /// have no copy edge between them have their copy edges processed on the thread pool.
+    //@{
+    virtual void propagateInParallel(NodeStack& nodeStack);
+    void propagateBatch(const std::vector<NodeID>& batch);
+    //@}
+
+private:
+    std::unique_ptr<ThreadPool> threadPool;
 };
 
 } // End namespace SVF
@@ -0,0 +1,157 @@
+//===- AndersenCD.h -- Lazy and hybrid cycle detection Andersen's analysis---//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenCD.h
+ *
+ * Cycle detection strategies of Hardekopf and Lin, "The Ant and the
+ * Grasshopper: Fast and Accurate Pointer Analysis for Millions of Lines of
+ * Code" (PLDI'07).
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef INCLUDE_WPA_ANDERSENCD_H_
+#define INCLUDE_WPA_ANDERSENCD_H_
+
+#include "WPA/Andersen.h"
+
+namespace SVF
+{
+
+/*!
+ * Lazy Cycle Detection based Andersen analysis.
+ * A copy edge src-->dst whose propagation does not change dst while
+ * pts(src) == pts(dst) is likely to be part of a cycle. A cycle search is
+ * started from dst (at most once per edge) and any cycle found is collapsed.
+ */
+class AndersenLCD : public Andersen
+{
+protected:
+    static AndersenLCD* lcdAndersen;
+    /// Copy edges (between reps) which have already triggered a cycle search
+    NodePairSet checkedEdges;
+    /// Roots of the cycle searches to run after the current node
+    NodeSet lcdCandidates;
+
+public:
+    AndersenLCD(SVFIR* _pag, PTATY type = AndersenLCD_WPA) :
+        Andersen(_pag, type)
+    {
+    }
+
+    /// Create an singleton instance directly instead of invoking llvm pass manager
+    static AndersenLCD* createAndersenLCD(SVFIR* _pag)
+    {
+        if (lcdAndersen == nullptr)
+        {
+            lcdAndersen = new AndersenLCD(_pag);
+            lcdAndersen->analyze();
+            return lcdAndersen;
+        }
+        return lcdAndersen;
+    }
+
+    static void releaseAndersenLCD()
+    {
+        if (lcdAndersen)
+            delete lcdAndersen;
+        lcdAndersen = nullptr;
+    }
+
+protected:
+    virtual void solveWorklist();
+    virtual bool processCopy(NodeID node, const ConstraintEdge* edge);
+
+    /// Search cycles from the candidates and collapse them
+    void detectLazyCycles();
+
+    virtual const std::string PTAName() const
+    {
+        return "AndersenLCD";
+    }
+};
+
+
+/*!
+ * Hybrid Cycle Detection based Andersen analysis.
+ * Before solving, an offline constraint graph with a ref node *p for every
+ * pointer p is built from the copy, load and store edges. Pointers in the
+ * same offline SCC are merged straight away. If *p shares an SCC with a
+ * pointer q, every object p points to must be equivalent to q, so the
+ * pointees of p are merged into q during solving, without any online
+ * cycle search.
+ */
+class AndersenHCD : public Andersen
+{
+public:
+    typedef Map<NodeID, NodeBS> PointeeEquivMap;
+
+protected:
+    static AndersenHCD* hcdAndersen;
+    /// (rep of) pointer p --> nodes which the pointees of p are merged into
+    PointeeEquivMap pointeeEquivs;
+
+public:
+    AndersenHCD(SVFIR* _pag, PTATY type = AndersenHCD_WPA) :
+        Andersen(_pag, type)
+    {
+    }
+
+    /// Create an singleton instance directly instead of invoking llvm pass manager
+    static AndersenHCD* createAndersenHCD(SVFIR* _pag)
+    {
+        if (hcdAndersen == nullptr)
+        {
+            hcdAndersen = new AndersenHCD(_pag);
+            hcdAndersen->analyze();
+            return hcdAndersen;
+        }
+        return hcdAndersen;
+    }
+
+    static void releaseAndersenHCD()
+    {
+        if (hcdAndersen)
+            delete hcdAndersen;
+        hcdAndersen = nullptr;
+    }
+
+protected:
+    virtual void initialize();
+    virtual void processNode(NodeID nodeId);
+    virtual void mergeNodeToRep(NodeID nodeId, NodeID newRepId);
+
+    /// Offline SCC detection on the constraint graph with ref nodes
+    void detectOfflineCycles();
+    /// Merge the pointees of nodeId into their offline equivalent nodes
+    void mergePointees(NodeID nodeId);
+
+    virtual const std::string PTAName() const
+    {
+        return "AndersenHCD";
+    }
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_WPA_ANDERSENCD_H_ */
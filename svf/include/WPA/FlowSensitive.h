@@ -34,6 +34,7 @@
 #include "Graphs/SVFGOPT.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
 #include "MSSA/SVFGBuilder.h"
+#include "Util/ThreadPool.h"
 #include "WPA/WPAFSSolver.h"
 
 namespace SVF
@@ -140,6 +141,36 @@ protected:
     /// SCC detection
     NodeStack& SCCDetect() override;
 
+    /// Parallel solving (-fs-threads > 1).
+    /// The SCCs of the SVFG are grouped into levels such that every SVFG edge between
+    /// two SCCs goes from a lower level to a higher one. The SCCs of a level are solved
+    /// to their local fixpoint on the thread pool, each with its own worklist; nodes of
+    /// other SCCs they push are deferred to their level. SCCs which may create field
+    /// objects (gep nodes) are solved serially after the parallel ones of their level.
+    //@{
+    /// An SCC being solved and the nodes it pushed outside of itself.
+    struct SCCTask
+    {
+        NodeID rep;
+        FIFOWorkList<NodeID> worklist;
+        std::vector<NodeID> deferred;
+        u64_t visits = 0;
+    };
+
+    void solveInParallel();
+    void computeSCCLevels(std::vector<std::vector<NodeID>>& levels, NodeBS& serialReps);
+    void solveSCC(SCCTask& task);
+    /// Create all points-to entries the parallel phases may look up.
+    void prepareConcurrentSolving();
+    /// Push into the worklist of the current SCC task if any
+    void pushIntoWorklist(NodeID id) override;
+    /// Solve again serially and compare all points-to sets (-fs-threads-check)
+    void checkThreads();
+
+    /// SCC task of the current thread, nullptr outside parallel solving.
+    static thread_local SCCTask* curSCCTask;
+    //@}
+
     /// Propagation
     //@{
     /// Propagate points-to information from an edge's src node to its dst node.
@@ -159,12 +190,12 @@ protected:
     /// Handle weak updates
     virtual bool weakUpdateOutFromIn(const SVFGNode* node)
     {
-        return getDFPTDataTy()->updateAllDFOutFromIn(node->getId(),0,false);
+        return recordUnion(getDFPTDataTy()->updateAllDFOutFromIn(node->getId(),0,false));
     }
     /// Handle strong updates
     virtual bool strongUpdateOutFromIn(const SVFGNode* node, NodeID singleton)
     {
-        return getDFPTDataTy()->updateAllDFOutFromIn(node->getId(),singleton,true);
+        return recordUnion(getDFPTDataTy()->updateAllDFOutFromIn(node->getId(),singleton,true));
     }
     //@}
 
@@ -175,11 +206,11 @@ protected:
 
     virtual inline bool propDFOutToIn(const SVFGNode* srcStmt, NodeID srcVar, const SVFGNode* dstStmt, NodeID dstVar)
     {
-        return getDFPTDataTy()->updateAllDFInFromOut(srcStmt->getId(), srcVar, dstStmt->getId(),dstVar);
+        return recordUnion(getDFPTDataTy()->updateAllDFInFromOut(srcStmt->getId(), srcVar, dstStmt->getId(),dstVar));
     }
     virtual inline bool propDFInToIn(const SVFGNode* srcStmt, NodeID srcVar, const SVFGNode* dstStmt, NodeID dstVar)
     {
-        return getDFPTDataTy()->updateAllDFInFromIn(srcStmt->getId(), srcVar, dstStmt->getId(),dstVar);
+        return recordUnion(getDFPTDataTy()->updateAllDFInFromIn(srcStmt->getId(), srcVar, dstStmt->getId(),dstVar));
     }
     //@}
 
@@ -187,24 +218,24 @@ protected:
     //@{
     inline bool updateOutFromIn(const SVFGNode* srcStmt, NodeID srcVar, const SVFGNode* dstStmt, NodeID dstVar)
     {
-        return getDFPTDataTy()->updateDFOutFromIn(srcStmt->getId(),srcVar, dstStmt->getId(),dstVar);
+        return recordUnion(getDFPTDataTy()->updateDFOutFromIn(srcStmt->getId(),srcVar, dstStmt->getId(),dstVar));
     }
     virtual inline bool updateInFromIn(const SVFGNode* srcStmt, NodeID srcVar, const SVFGNode* dstStmt, NodeID dstVar)
     {
-        return getDFPTDataTy()->updateDFInFromIn(srcStmt->getId(),srcVar, dstStmt->getId(),dstVar);
+        return recordUnion(getDFPTDataTy()->updateDFInFromIn(srcStmt->getId(),srcVar, dstStmt->getId(),dstVar));
     }
     virtual inline bool updateInFromOut(const SVFGNode* srcStmt, NodeID srcVar, const SVFGNode* dstStmt, NodeID dstVar)
     {
-        return getDFPTDataTy()->updateDFInFromOut(srcStmt->getId(),srcVar, dstStmt->getId(),dstVar);
+        return recordUnion(getDFPTDataTy()->updateDFInFromOut(srcStmt->getId(),srcVar, dstStmt->getId(),dstVar));
     }
 
     virtual inline bool unionPtsFromIn(const SVFGNode* stmt, NodeID srcVar, NodeID dstVar)
     {
-        return getDFPTDataTy()->updateTLVPts(stmt->getId(),srcVar,dstVar);
+        return recordUnion(getDFPTDataTy()->updateTLVPts(stmt->getId(),srcVar,dstVar));
     }
     virtual inline bool unionPtsFromTop(const SVFGNode* stmt, NodeID srcVar, NodeID dstVar)
     {
-        return getDFPTDataTy()->updateATVPts(srcVar,stmt->getId(),dstVar);
+        return recordUnion(getDFPTDataTy()->updateATVPts(srcVar,stmt->getId(),dstVar));
     }
 
     inline void clearAllDFOutVarFlag(const SVFGNode* stmt)
@@ -217,6 +248,8 @@ protected:
     //@{
     void processNode(NodeID nodeId) override;
     bool processSVFGNode(SVFGNode* node);
+    /// Propagate along the compact out edges of node when the SVFG is frozen
+    void propagate(SVFGNode** v) override;
     virtual bool processAddr(const AddrSVFGNode* addr);
     virtual bool processCopy(const CopySVFGNode* copy);
     virtual bool processPhi(const PHISVFGNode* phi);
@@ -281,16 +314,17 @@ protected:
     std::vector<std::pair<hclust_fast_methods, std::vector<NodeID>>> candidateMappings;
 
     /// Statistics.
+    /// Those updated while processing nodes are atomic for parallel solving.
     //@{
-    u32_t numOfProcessedAddr;	/// Number of processed Addr node
-    u32_t numOfProcessedCopy;	/// Number of processed Copy node
-    u32_t numOfProcessedGep;	/// Number of processed Gep node
-    u32_t numOfProcessedPhi;	/// Number of processed Phi node
-    u32_t numOfProcessedLoad;	/// Number of processed Load node
-    u32_t numOfProcessedStore;	/// Number of processed Store node
-    u32_t numOfProcessedActualParam;	/// Number of processed actual param node
-    u32_t numOfProcessedFormalRet;	/// Number of processed formal ret node
-    u32_t numOfProcessedMSSANode;	/// Number of processed mssa node
+    AtomicStat<u32_t> numOfProcessedAddr;	/// Number of processed Addr node
+    AtomicStat<u32_t> numOfProcessedCopy;	/// Number of processed Copy node
+    AtomicStat<u32_t> numOfProcessedGep;	/// Number of processed Gep node
+    AtomicStat<u32_t> numOfProcessedPhi;	/// Number of processed Phi node
+    AtomicStat<u32_t> numOfProcessedLoad;	/// Number of processed Load node
+    AtomicStat<u32_t> numOfProcessedStore;	/// Number of processed Store node
+    AtomicStat<u32_t> numOfProcessedActualParam;	/// Number of processed actual param node
+    AtomicStat<u32_t> numOfProcessedFormalRet;	/// Number of processed formal ret node
+    AtomicStat<u32_t> numOfProcessedMSSANode;	/// Number of processed mssa node
 
     u32_t maxSCCSize;
     u32_t numOfSCC;
@@ -298,23 +332,32 @@ protected:
 
     double solveTime;	///< time of solve.
     double sccTime;	///< time of SCC detection.
-    double processTime;	///< time of processNode.
-    double propagationTime;	///< time of points-to propagation.
-    double directPropaTime;	///< time of points-to propagation of address-taken objects
-    double indirectPropaTime; ///< time of points-to propagation of top-level pointers
-    double updateTime;	///< time of strong/weak updates.
-    double addrTime;	///< time of handling address edges
-    double copyTime;	///< time of handling copy edges
-    double gepTime;	///< time of handling gep edges
-    double loadTime;	///< time of load edges
-    double storeTime;	///< time of store edges
-    double phiTime;	///< time of phi nodes.
+    AtomicStat<double> processTime;	///< time of processNode.
+    AtomicStat<double> propagationTime;	///< time of points-to propagation.
+    AtomicStat<double> directPropaTime;	///< time of points-to propagation of address-taken objects
+    AtomicStat<double> indirectPropaTime; ///< time of points-to propagation of top-level pointers
+    AtomicStat<double> updateTime;	///< time of strong/weak updates.
+    AtomicStat<double> addrTime;	///< time of handling address edges
+    AtomicStat<double> copyTime;	///< time of handling copy edges
+    AtomicStat<double> gepTime;	///< time of handling gep edges
+    AtomicStat<double> loadTime;	///< time of load edges
+    AtomicStat<double> storeTime;	///< time of store edges
+    AtomicStat<double> phiTime;	///< time of phi nodes.
     double updateCallGraphTime; ///< time of updating call graph
 
     NodeBS svfgHasSU;
     //@}
 
     void svfgStat();
+
+private:
+    /// Number of locks striped over the destination nodes of propagations leaving an SCC.
+    static const u32_t NumDstLocks = 1024;
+
+    std::unique_ptr<ThreadPool> threadPool;
+    std::unique_ptr<std::mutex[]> dstLocks;
+    /// Guards svfgHasSU during parallel solving
+    std::mutex suLock;
 };
 
 } // End namespace SVF
@@ -9,6 +9,7 @@
 #define INCLUDE_WPA_STEENSGAARD_H_
 
 #include "WPA/Andersen.h"
+#include "Util/DenseIDMap.h"
 
 namespace SVF
 {
@@ -21,9 +22,6 @@ class Steensgaard : public AndersenBase
 {
 
 public:
-    typedef Map<NodeID, NodeID> NodeToEquivClassMap;
-    typedef Map<NodeID, Set<NodeID>> NodeToSubsMap;
-
     /// Constructor
     Steensgaard(SVFIR* _pag) : AndersenBase(_pag, Steensgaard_WPA, true) {}
 
@@ -70,20 +68,25 @@ public:
     /// Operation of points-to set
     virtual inline const PointsTo& getPts(NodeID id) override
     {
-        return getPTDataTy()->getPts(getEC(id));
+        id = getEC(id);
+        loadMappedPts(id);
+        return getLoadedPTDataTy()->getPts(id);
     }
     /// pts(id) = pts(id) U target
     virtual inline bool unionPts(NodeID id, const PointsTo& target) override
     {
         id = getEC(id);
-        return getPTDataTy()->unionPts(id, target);
+        loadMappedPts(id);
+        return getLoadedPTDataTy()->unionPts(id, target);
     }
     /// pts(id) = pts(id) U pts(ptd)
     virtual inline bool unionPts(NodeID id, NodeID ptd) override
     {
         id = getEC(id);
         ptd = getEC(ptd);
-        return getPTDataTy()->unionPts(id, ptd);
+        loadMappedPts(id);
+        loadMappedPts(ptd);
+        return getLoadedPTDataTy()->unionPts(id, ptd);
     }
 
     /// API for equivalence class operations
@@ -91,27 +94,31 @@ public:
     /// An equivalence class has a set of sub constraint nodes.
     inline NodeID getEC(NodeID id) const
     {
-        NodeToEquivClassMap::const_iterator it = nodeToECMap.find(id);
-        if (it == nodeToECMap.end())
-            return id;
-        else
-            return it->second;
+        NodeID root = ecRoot(id);
+        NodeID label = ecNodes.lookup(root).label;
+        return label != UINT_MAX ? label : root;
     }
     /// Return getEC(id)
     inline NodeID sccRepNode(NodeID id) const override
     {
         return getEC(id);
     }
+    /// Merge the EC of node into the EC of rep, which keeps its ID
     void setEC(NodeID node, NodeID rep);
 
-    inline Set<NodeID>& getSubNodes(NodeID id)
-    {
-        nodeToSubsMap[id].insert(id);
-        return nodeToSubsMap[id];
-    }
-    inline void addSubNode(NodeID node, NodeID sub)
+    /// Nodes in the EC of id, materialised from its member list
+    inline NodeBS getSubNodes(NodeID id) const
     {
-        nodeToSubsMap[node].insert(sub);
+        NodeBS subNodes;
+        NodeID sub = id;
+        do
+        {
+            subNodes.set(sub);
+            NodeID next = ecNodes.lookup(sub).next;
+            sub = next != UINT_MAX ? next : sub;
+        }
+        while (sub != id);
+        return subNodes;
     }
 
     /// Add copy edge on constraint graph
@@ -121,9 +128,37 @@ public:
     }
 
 private:
+    /// Root of the union-find tree of id, compressing the path to it
+    inline NodeID ecRoot(NodeID id) const
+    {
+        NodeID root = id;
+        for (NodeID parent = ecNodes.lookup(root).parent; parent != UINT_MAX; parent = ecNodes.lookup(root).parent)
+            root = parent;
+        while (id != root)
+        {
+            NodeID parent = ecNodes.lookup(id).parent;
+            if (parent != root)
+                ecNodes[id].parent = root;
+            id = parent;
+        }
+        return root;
+    }
+    /// Make room in the union-find arrays for num nodes
+    void reserveECs(size_t num);
+
     static Steensgaard* steens; // static instance
-    NodeToEquivClassMap nodeToECMap;
-    NodeToSubsMap nodeToSubsMap;
+
+    /// Union-find with path compression and union by rank, indexed by node ID.
+    /// UINT_MAX stands for the node itself, so nodes never merged are in ECs of
+    /// their own with default entries.
+    struct ECNode
+    {
+        NodeID parent{UINT_MAX};	///< parent in the union-find forest (none for roots)
+        NodeID label{UINT_MAX};	///< ID of the EC of a root, i.e., the node keeping its points-to set
+        NodeID next{UINT_MAX};	///< next member of the same EC (circular list)
+        u8_t rank{0};	///< upper bound of the height of the tree of a root
+    };
+    mutable DenseIDMap<ECNode> ecNodes;
 };
 
 } // namespace SVF
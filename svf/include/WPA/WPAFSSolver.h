@@ -68,6 +68,7 @@ protected:
     {
         /// SCC detection
         this->getSCCDetector()->find();
+        this->rankWorklistNodes();
 
         assert(nodeStack.empty() && "node stack is not empty, some nodes are not popped properly.");
 
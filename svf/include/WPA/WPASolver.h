@@ -52,12 +52,12 @@ public:
 
     typedef SCCDetection<GraphType> SCC;
 
-    typedef FIFOWorkList<NodeID> WorkList;
+    typedef PolicyWorkList WorkList;
 
 protected:
 
     /// Constructor
-    WPASolver(): reanalyze(false), iterationForPrintStat(1000), _graph(nullptr), numOfIteration(0)
+    WPASolver(): reanalyze(false), iterationForPrintStat(1000), _graph(nullptr), numOfIteration(0), numOfNodeVisits(0)
     {
     }
     /// Destructor
@@ -86,14 +86,41 @@ protected:
     virtual inline NodeStack& SCCDetect()
     {
         getSCCDetector()->find();
+        rankWorklistNodes();
         return getSCCDetector()->topoNodeStack();
     }
     virtual inline NodeStack& SCCDetect(NodeSet& candidates)
     {
         getSCCDetector()->find(candidates);
+        rankWorklistNodes();
         return getSCCDetector()->topoNodeStack();
     }
 
+    /// Order in which the worklist is processed, to be set before solving
+    inline void setWorklistPolicy(WorkList::Policy policy)
+    {
+        worklist.setPolicy(policy);
+    }
+
+    /// Rank nodes by the topological order found by the last SCC detection,
+    /// if the worklist policy is rank based
+    inline void rankWorklistNodes()
+    {
+        if (!worklist.usesRanks())
+            return;
+
+        NodeStack topoOrder = getSCCDetector()->topoNodeStack();
+        u32_t rank = 0;
+        while (!topoOrder.empty())
+        {
+            NodeID rep = topoOrder.top();
+            topoOrder.pop();
+            for (NodeID subNode : getSCCDetector()->subNodes(rep))
+                worklist.setRank(subNode, rank);
+            ++rank;
+        }
+    }
+
     virtual inline void initWorklist()
     {
         NodeStack& nodeStack = SCCDetect();
@@ -150,6 +177,7 @@ protected:
     //@{
     inline NodeID popFromWorklist()
     {
+        ++numOfNodeVisits;
         return sccRepNode(worklist.pop());
     }
 
@@ -198,6 +226,8 @@ protected:
 public:
     /// num of iterations during constraint solving
     u32_t numOfIteration;
+    /// num of nodes popped from the worklist during constraint solving
+    u64_t numOfNodeVisits;
 };
 
 } // End namespace SVF
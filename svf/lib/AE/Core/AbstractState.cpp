@@ -60,97 +60,52 @@ AbstractState AbstractState::widening(const AbstractState& other)
 {
     // widen interval
     AbstractState es = *this;
-    for (auto it = es._varToAbsVal.begin(); it != es._varToAbsVal.end(); ++it)
+    auto widen = [](AbstractValue& lhs, const AbstractValue& rhs)
     {
-        auto key = it->first;
-        if (other._varToAbsVal.find(key) != other._varToAbsVal.end())
-            if (it->second.isInterval() && other._varToAbsVal.at(key).isInterval())
-                it->second.getInterval().widen_with(other._varToAbsVal.at(key).getInterval());
-    }
-    for (auto it = es._addrToAbsVal.begin(); it != es._addrToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        if (other._addrToAbsVal.find(key) != other._addrToAbsVal.end())
-            if (it->second.isInterval() && other._addrToAbsVal.at(key).isInterval())
-                it->second.getInterval().widen_with(other._addrToAbsVal.at(key).getInterval());
-    }
+        if (lhs.isInterval() && rhs.isInterval())
+            lhs.getInterval().widen_with(rhs.getInterval());
+    };
+    es._varToAbsVal.mergeWith(other._varToAbsVal, widen, false);
+    es._addrToAbsVal.mergeWith(other._addrToAbsVal, widen, false);
     return es;
 }
 
 AbstractState AbstractState::narrowing(const AbstractState& other)
 {
     AbstractState es = *this;
-    for (auto it = es._varToAbsVal.begin(); it != es._varToAbsVal.end(); ++it)
+    auto narrow = [](AbstractValue& lhs, const AbstractValue& rhs)
     {
-        auto key = it->first;
-        if (other._varToAbsVal.find(key) != other._varToAbsVal.end())
-            if (it->second.isInterval() && other._varToAbsVal.at(key).isInterval())
-                it->second.getInterval().narrow_with(other._varToAbsVal.at(key).getInterval());
-    }
-    for (auto it = es._addrToAbsVal.begin(); it != es._addrToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        if (other._addrToAbsVal.find(key) != other._addrToAbsVal.end())
-            if (it->second.isInterval() && other._addrToAbsVal.at(key).isInterval())
-                it->second.getInterval().narrow_with(other._addrToAbsVal.at(key).getInterval());
-    }
+        if (lhs.isInterval() && rhs.isInterval())
+            lhs.getInterval().narrow_with(rhs.getInterval());
+    };
+    es._varToAbsVal.mergeWith(other._varToAbsVal, narrow, false);
+    es._addrToAbsVal.mergeWith(other._addrToAbsVal, narrow, false);
     return es;
 
 }
 
 /// domain join with other, important! other widen this.
+/// Values shared with other (e.g. both states stem from the same one) are skipped.
 void AbstractState::joinWith(const AbstractState& other)
 {
-    for (auto it = other._varToAbsVal.begin(); it != other._varToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        auto oit = _varToAbsVal.find(key);
-        if (oit != _varToAbsVal.end())
-        {
-            oit->second.join_with(it->second);
-        }
-        else
-        {
-            _varToAbsVal.emplace(key, it->second);
-        }
-    }
-    for (auto it = other._addrToAbsVal.begin(); it != other._addrToAbsVal.end(); ++it)
+    auto join = [](AbstractValue& lhs, const AbstractValue& rhs)
     {
-        auto key = it->first;
-        auto oit = _addrToAbsVal.find(key);
-        if (oit != _addrToAbsVal.end())
-        {
-            oit->second.join_with(it->second);
-        }
-        else
-        {
-            _addrToAbsVal.emplace(key, it->second);
-        }
-    }
+        lhs.join_with(rhs);
+    };
+    _varToAbsVal.mergeWith(other._varToAbsVal, join, true);
+    _addrToAbsVal.mergeWith(other._addrToAbsVal, join, true);
     _freedAddrs.insert(other._freedAddrs.begin(), other._freedAddrs.end());
 }
 
 /// domain meet with other, important! other widen this.
 void AbstractState::meetWith(const AbstractState& other)
 {
-    for (auto it = other._varToAbsVal.begin(); it != other._varToAbsVal.end(); ++it)
+    auto meet = [](AbstractValue& lhs, const AbstractValue& rhs)
     {
-        auto key = it->first;
-        auto oit = _varToAbsVal.find(key);
-        if (oit != _varToAbsVal.end())
-        {
-            oit->second.meet_with(it->second);
-        }
-    }
-    for (auto it = other._addrToAbsVal.begin(); it != other._addrToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        auto oit = _addrToAbsVal.find(key);
-        if (oit != _addrToAbsVal.end())
-        {
-            oit->second.meet_with(it->second);
-        }
-    }
+        lhs.meet_with(rhs);
+    };
+    _varToAbsVal.mergeWith(other._varToAbsVal, meet, false);
+    _addrToAbsVal.mergeWith(other._addrToAbsVal, meet, false);
     Set<NodeID> intersection;
     std::set_intersection(_freedAddrs.begin(), _freedAddrs.end(),
                           other._freedAddrs.begin(), other._freedAddrs.end(),
@@ -168,7 +123,7 @@ AddressValue AbstractState::getGepObjAddrs(u32_t pointer, IntervalValue offset)
                   : Options::MaxFieldLimit();
     for (APOffset i = lb; i <= ub; i++)
     {
-        AbstractValue addrs = (*this)[pointer];
+        AbstractValue addrs = at(pointer);
         for (const auto& addr : addrs.getAddrs())
         {
             s64_t baseObj = getIDFromAddr(addr);
@@ -251,7 +206,7 @@ IntervalValue AbstractState::getElementIndex(const GepStmt* gep)
             idxLb = idxUb = constInt->getSExtValue();
         else
         {
-            IntervalValue idxItv = (*this)[var->getId()].getInterval();
+            IntervalValue idxItv = at(var->getId()).getInterval();
             if (idxItv.isBottom())
                 idxLb = idxUb = 0;
             else
@@ -336,7 +291,7 @@ IntervalValue AbstractState::getByteOffset(const GepStmt* gep)
             }
             else
             {
-                IntervalValue idxVal = (*this)[idxOperandVar->getId()].getInterval();
+                IntervalValue idxVal = at(idxOperandVar->getId()).getInterval();
 
                 if (idxVal.isBottom())
                     res = res + IntervalValue(0, 0);
@@ -371,16 +326,16 @@ IntervalValue AbstractState::getByteOffset(const GepStmt* gep)
 AbstractValue AbstractState::loadValue(NodeID varId)
 {
     AbstractValue res;
-    for (auto addr : (*this)[varId].getAddrs())
+    for (auto addr : at(varId).getAddrs())
     {
-        res.join_with(load(addr)); // q = *p
+        res.join_with(loadAt(addr)); // q = *p
     }
     return res;
 }
 // storeValue
 void AbstractState::storeValue(NodeID varId, AbstractValue val)
 {
-    for (auto addr : (*this)[varId].getAddrs())
+    for (auto addr : at(varId).getAddrs())
     {
         store(addr, val); // *p = q
     }
@@ -473,7 +428,7 @@ const SVFType* AbstractState::getPointeeElement(NodeID id)
     SVFIR* svfir = PAG::getPAG();
     if (inVarToAddrsTable(id))
     {
-        const AbstractValue& addrs = (*this)[id];
+        const AbstractValue& addrs = at(id);
         for (auto addr: addrs.getAddrs())
         {
             NodeID addr_id = getIDFromAddr(addr);
@@ -512,7 +467,7 @@ u32_t AbstractState::getAllocaInstByteSize(const AddrStmt *addr)
                     (*this)[value->getId()] = IntervalValue(Options::MaxFieldLimit());
                 }
                 IntervalValue itv =
-                    (*this)[value->getId()].getInterval();
+                    at(value->getId()).getInterval();
                 res = res * itv.ub().getIntNumeral() > Options::MaxFieldLimit()? Options::MaxFieldLimit(): res * itv.ub().getIntNumeral();
             }
             return (u32_t)res;
@@ -55,9 +55,9 @@ void BufOverflowDetector::checkStatement(const SVFStmt* stmt, AbstractState& as)
         NodeID rhs = gep->getRHSVarID();
 
         // Update the GEP object offset from its base (same as Python version)
-        updateGepObjOffsetFromBase(as, as[lhs].getAddrs(), as[rhs].getAddrs(), as.getByteOffset(gep));
+        updateGepObjOffsetFromBase(as, as.at(lhs).getAddrs(), as.at(rhs).getAddrs(), as.getByteOffset(gep));
 
-        AddressValue objAddrs = as[rhs].getAddrs();
+        AddressValue objAddrs = as.at(rhs).getAddrs();
         for (const auto& addr : objAddrs)
         {
             NodeID objId = as.getIDFromAddr(addr);
@@ -209,7 +209,7 @@ void BufOverflowDetector::handleStubFunctions(const SVF::CallICFGNode* callNode)
             AbstractInterpretation::getAEInstance().getAbsStateFromTrace(
                 callNode);
         u32_t size_id = callNode->getArgument(1)->getId();
-        IntervalValue val = as[size_id].getInterval();
+        IntervalValue val = as.at(size_id).getInterval();
         if (val.isBottom())
         {
             val = IntervalValue(0);
@@ -237,7 +237,7 @@ void BufOverflowDetector::handleStubFunctions(const SVF::CallICFGNode* callNode)
         if (callNode->arg_size() < 2) return;
         AbstractState& as = AbstractInterpretation::getAEInstance().getAbsStateFromTrace(callNode);
         u32_t size_id = callNode->getArgument(1)->getId();
-        IntervalValue val = as[size_id].getInterval();
+        IntervalValue val = as.at(size_id).getInterval();
         if (val.isBottom())
         {
             assert(false && "UNSAFE_BUFACCESS size is bottom");
@@ -331,7 +331,7 @@ void BufOverflowDetector::detectExtAPI(AbstractState& as,
                                               extAPIBufOverflowCheckRules.at(call->getCalledFunction()->getName());
         for (auto arg : args)
         {
-            IntervalValue offset = as[call->getArgument(arg.second)->getId()].getInterval() - IntervalValue(1);
+            IntervalValue offset = as.at(call->getArgument(arg.second)->getId()).getInterval() - IntervalValue(1);
             const SVFVar* argVar = call->getArgument(arg.first);
             if (!canSafelyAccessMemory(as, argVar, offset))
             {
@@ -351,7 +351,7 @@ void BufOverflowDetector::detectExtAPI(AbstractState& as,
                                               extAPIBufOverflowCheckRules.at(call->getCalledFunction()->getName());
         for (auto arg : args)
         {
-            IntervalValue offset = as[call->getArgument(arg.second)->getId()].getInterval() - IntervalValue(1);
+            IntervalValue offset = as.at(call->getArgument(arg.second)->getId()).getInterval() - IntervalValue(1);
             const SVFVar* argVar = call->getArgument(arg.first);
             if (!canSafelyAccessMemory(as, argVar, offset))
             {
@@ -467,7 +467,7 @@ bool BufOverflowDetector::detectStrcat(AbstractState& as, const CallICFGNode *ca
     {
         const SVFVar* arg0Val = call->getArgument(0);
         const SVFVar* arg2Val = call->getArgument(2);
-        IntervalValue arg2Num = as[arg2Val->getId()].getInterval();
+        IntervalValue arg2Num = as.at(arg2Val->getId()).getInterval();
         IntervalValue strLen0 = AbstractInterpretation::getAEInstance().getUtils()->getStrlen(as, arg0Val);
         IntervalValue totalLen = strLen0 + arg2Num;
         return canSafelyAccessMemory(as, arg0Val, totalLen);
@@ -496,8 +496,8 @@ bool BufOverflowDetector::canSafelyAccessMemory(AbstractState& as, const SVF::SV
     SVFIR* svfir = PAG::getPAG();
     NodeID value_id = value->getId();
 
-    assert(as[value_id].isAddr());
-    for (const auto& addr : as[value_id].getAddrs())
+    assert(as.at(value_id).isAddr());
+    for (const auto& addr : as.at(value_id).getAddrs())
     {
         NodeID objId = as.getIDFromAddr(addr);
         u32_t size = 0;
@@ -699,7 +699,7 @@ void NullptrDerefDetector::detectExtAPI(AbstractState& as, const CallICFGNode* c
 bool NullptrDerefDetector::canSafelyDerefPtr(AbstractState& as, const SVFVar* value)
 {
     NodeID value_id = value->getId();
-    AbstractValue AbsVal = as[value_id];
+    AbstractValue AbsVal = as.at(value_id);
     // uninit value cannot be dereferenced, return unsafe
     if (isUninit(AbsVal)) return false;
     // Interval Value (non-addr) is not the checkpoint of nullptr dereference, return safe
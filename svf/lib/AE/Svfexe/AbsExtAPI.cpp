@@ -47,7 +47,7 @@ void AbsExtAPI::initExtFunMap()
         AbstractState& as = getAbsStateFromTrace(callNode); \
         u32_t rhs_id = callNode->getArgument(0)->getId(); \
         if (!as.inVarToValTable(rhs_id)) return; \
-        u32_t rhs = as[rhs_id].getInterval().lb().getIntNumeral(); \
+        u32_t rhs = as.at(rhs_id).getInterval().lb().getIntNumeral(); \
         s32_t res = FUNC_NAME(rhs);            \
         u32_t lhsId = callNode->getRetICFGNode()->getActualRet()->getId();               \
         as[lhsId] = IntervalValue(res);           \
@@ -79,7 +79,7 @@ void AbsExtAPI::initExtFunMap()
         AbstractInterpretation::getAEInstance().checkpoints.erase(callNode);
         u32_t arg0 = callNode->getArgument(0)->getId();
         AbstractState&as = getAbsStateFromTrace(callNode);
-        if (as[arg0].getInterval().equals(IntervalValue(1, 1)))
+        if (as.at(arg0).getInterval().equals(IntervalValue(1, 1)))
         {
             SVFUtil::errs() << SVFUtil::sucMsg("The assertion is successfully verified!!\n");
         }
@@ -97,7 +97,7 @@ void AbsExtAPI::initExtFunMap()
         u32_t arg0 = callNode->getArgument(0)->getId();
         u32_t arg1 = callNode->getArgument(1)->getId();
         AbstractState&as = getAbsStateFromTrace(callNode);
-        if (as[arg0].getInterval().equals(as[arg1].getInterval()))
+        if (as.at(arg0).getInterval().equals(as.at(arg1).getInterval()))
         {
             SVFUtil::errs() << SVFUtil::sucMsg("The assertion is successfully verified!!\n");
         }
@@ -117,7 +117,7 @@ void AbsExtAPI::initExtFunMap()
         u32_t num_id = callNode->getArgument(0)->getId();
         std::string text = strRead(as, callNode->getArgument(1));
         assert(as.inVarToValTable(num_id) && "print() should pass integer");
-        IntervalValue itv = as[num_id].getInterval();
+        IntervalValue itv = as.at(num_id).getInterval();
         std::cout << "Text: " << text <<", Value: " << callNode->getArgument(0)->toString()
                   << ", PrintVal: " << itv.toString() << ", Loc:" << callNode->getSourceLoc() << std::endl;
         return;
@@ -129,8 +129,8 @@ void AbsExtAPI::initExtFunMap()
         if (callNode->arg_size() < 2) return;
         AbstractState&as = getAbsStateFromTrace(callNode);
         AbstractValue& num = as[callNode->getArgument(0)->getId()];
-        AbstractValue& lb = as[callNode->getArgument(1)->getId()];
-        AbstractValue& ub = as[callNode->getArgument(2)->getId()];
+        const AbstractValue& lb = as.at(callNode->getArgument(1)->getId());
+        const AbstractValue& ub = as.at(callNode->getArgument(2)->getId());
         assert(lb.getInterval().is_numeral() && ub.getInterval().is_numeral());
         num.getInterval().set_to_top();
         num.getInterval().meet_with(IntervalValue(lb.getInterval().lb(), ub.getInterval().ub()));
@@ -161,7 +161,7 @@ void AbsExtAPI::initExtFunMap()
         }
         else
         {
-            AbstractValue Addrs = as[dst_id];
+            AbstractValue Addrs = as.at(dst_id);
             for (auto vaddr: Addrs.getAddrs())
             {
                 u32_t objId = as.getIDFromAddr(vaddr);
@@ -181,7 +181,7 @@ void AbsExtAPI::initExtFunMap()
         }
         else
         {
-            AbstractValue Addrs = as[dst_id];
+            AbstractValue Addrs = as.at(dst_id);
             for (auto vaddr: Addrs.getAddrs())
             {
                 u32_t objId = as.getIDFromAddr(vaddr);
@@ -206,8 +206,8 @@ void AbsExtAPI::initExtFunMap()
         AbstractState&as = getAbsStateFromTrace(callNode);
         u32_t block_count_id = callNode->getArgument(2)->getId();
         u32_t block_size_id = callNode->getArgument(1)->getId();
-        IntervalValue block_count = as[block_count_id].getInterval();
-        IntervalValue block_size = as[block_size_id].getInterval();
+        IntervalValue block_count = as.at(block_count_id).getInterval();
+        IntervalValue block_size = as.at(block_size_id).getInterval();
         IntervalValue block_byte = block_count * block_size;
     };
     func_map["fread"] = sse_fread;
@@ -239,7 +239,7 @@ void AbsExtAPI::initExtFunMap()
             return;
             // assert(false && "we cannot support this type");
         }
-        IntervalValue size = as[size_id].getInterval() * IntervalValue(elemSize) - IntervalValue(1);
+        IntervalValue size = as.at(size_id).getInterval() * IntervalValue(elemSize) - IntervalValue(1);
         if (!as.inVarToAddrsTable(dst_id))
         {
         }
@@ -264,7 +264,7 @@ void AbsExtAPI::initExtFunMap()
         AbstractState&as = getAbsStateFromTrace(callNode);
         u32_t num_id = callNode->getArgument(0)->getId();
 
-        u32_t num = (u32_t) as[num_id].getInterval().getNumeral();
+        u32_t num = (u32_t) as.at(num_id).getInterval().getNumeral();
         std::string snum = std::to_string(num);
     };
     func_map["itoa"] = sse_itoa;
@@ -279,7 +279,7 @@ void AbsExtAPI::initExtFunMap()
         NodeID value_id = strValue->getId();
         u32_t lhsId = callNode->getRetICFGNode()->getActualRet()->getId();
         u32_t dst_size = 0;
-        for (const auto& addr : as[value_id].getAddrs())
+        for (const auto& addr : as.at(value_id).getAddrs())
         {
             NodeID objId = as.getIDFromAddr(addr);
             if (svfir->getBaseObject(objId)->isConstantByteSize())
@@ -309,7 +309,7 @@ void AbsExtAPI::initExtFunMap()
                 AbstractValue val;
                 for (const auto &addr: expr0.getAddrs())
                 {
-                    val.join_with(as.load(addr));
+                    val.join_with(as.loadAt(addr));
                 }
                 if (val.getInterval().is_numeral() && (char) val.getInterval().getIntNumeral() == '\0')
                 {
@@ -336,7 +336,7 @@ void AbsExtAPI::initExtFunMap()
         if (callNode->arg_size() < 4) return;
         AbstractState&as = getAbsStateFromTrace(callNode);
         u32_t len_id = callNode->getArgument(2)->getId();
-        IntervalValue len = as[len_id].getInterval() - IntervalValue(1);
+        IntervalValue len = as.at(len_id).getInterval() - IntervalValue(1);
         u32_t lhsId = callNode->getRetICFGNode()->getActualRet()->getId();
         as[lhsId] = len;
     };
@@ -348,7 +348,7 @@ void AbsExtAPI::initExtFunMap()
         if (callNode->arg_size() < 1) return;
         AbstractState& as = getAbsStateFromTrace(callNode);
         const u32_t freePtr = callNode->getArgument(0)->getId();
-        for (auto addr: as[freePtr].getAddrs())
+        for (auto addr: as.at(freePtr).getAddrs())
         {
             if (AbstractState::isInvalidMem(addr))
             {
@@ -404,7 +404,7 @@ std::string AbsExtAPI::strRead(AbstractState& as, const SVFVar* rhs)
         AbstractValue val;
         for (const auto &addr: expr0.getAddrs())
         {
-            val.join_with(as.load(addr));
+            val.join_with(as.loadAt(addr));
         }
         if (!val.getInterval().is_numeral())
         {
@@ -463,15 +463,15 @@ void AbsExtAPI::handleExtAPI(const CallICFGNode *call)
     // 1. memcpy functions like memcpy_chk, strncpy, annotate("MEMCPY"), annotate("BUF_CHECK:Arg0, Arg2"), annotate("BUF_CHECK:Arg1, Arg2")
     else if (extType == MEMCPY)
     {
-        IntervalValue len = as[call->getArgument(2)->getId()].getInterval();
+        IntervalValue len = as.at(call->getArgument(2)->getId()).getInterval();
         svfir->getGNode(call->getArgument(0)->getId());
         handleMemcpy(as, call->getArgument(0), call->getArgument(1), len, 0);
     }
     else if (extType == MEMSET)
     {
         // memset dst is arg0, elem is arg1, size is arg2
-        IntervalValue len = as[call->getArgument(2)->getId()].getInterval();
-        IntervalValue elem = as[call->getArgument(1)->getId()].getInterval();
+        IntervalValue len = as.at(call->getArgument(2)->getId()).getInterval();
+        IntervalValue elem = as.at(call->getArgument(1)->getId()).getInterval();
         handleMemset(as, call->getArgument(0), elem, len);
     }
     else if (extType == STRCPY)
@@ -505,7 +505,7 @@ IntervalValue AbsExtAPI::getStrlen(AbstractState& as, const SVF::SVFVar *strValu
 {
     NodeID value_id = strValue->getId();
     u32_t dst_size = 0;
-    for (const auto& addr : as[value_id].getAddrs())
+    for (const auto& addr : as.at(value_id).getAddrs())
     {
         NodeID objId = as.getIDFromAddr(addr);
         if (svfir->getBaseObject(objId)->isConstantByteSize())
@@ -535,7 +535,7 @@ IntervalValue AbsExtAPI::getStrlen(AbstractState& as, const SVF::SVFVar *strValu
             AbstractValue val;
             for (const auto &addr: expr0.getAddrs())
             {
-                val.join_with(as.load(addr));
+                val.join_with(as.loadAt(addr));
             }
             if (val.getInterval().is_numeral() && (char) val.getInterval().getIntNumeral() == '\0')
             {
@@ -600,7 +600,7 @@ void AbsExtAPI::handleStrcat(const SVF::CallICFGNode *call)
         const SVFVar* arg0Val = call->getArgument(0);
         const SVFVar* arg1Val = call->getArgument(1);
         const SVFVar* arg2Val = call->getArgument(2);
-        IntervalValue arg2Num = as[arg2Val->getId()].getInterval();
+        IntervalValue arg2Num = as.at(arg2Val->getId()).getInterval();
         IntervalValue strLen0 = getStrlen(as, arg0Val);
         IntervalValue totalLen = strLen0 + arg2Num;
         handleMemcpy(as, arg0Val, arg1Val, arg2Num, strLen0.lb().getIntNumeral());
@@ -707,7 +707,7 @@ void AbsExtAPI::handleMemset(AbstractState& as, const SVF::SVFVar *dst, Interval
                 u32_t objId = as.getIDFromAddr(addr);
                 if (as.inAddrToValTable(objId))
                 {
-                    AbstractValue tmp = as.load(addr);
+                    AbstractValue tmp = as.loadAt(addr);
                     tmp.join_with(elem);
                     as.store(addr, tmp);
                 }
@@ -33,6 +33,7 @@
 #include "Util/WorkList.h"
 #include "Graphs/CallGraph.h"
 #include "WPA/Andersen.h"
+#include <algorithm>
 #include <cmath>
 
 using namespace SVF;
@@ -46,6 +47,14 @@ void AbstractInterpretation::runOnModule(ICFG *_icfg)
     icfg = _icfg;
     svfir = PAG::getPAG();
     utils = new AbsExtAPI(abstractTrace);
+    if (Options::AESummaryLimit() != 0)
+    {
+        for (const SVFStmt* stmt : icfg->getGlobalICFGNode()->getSVFStmts())
+        {
+            if (const AddrStmt* addr = SVFUtil::dyn_cast<AddrStmt>(stmt))
+                globalObjs.push_back(addr->getRHSVarID());
+        }
+    }
 
     /// collect checkpoint
     collectCheckPoint();
@@ -89,6 +98,10 @@ void AbstractInterpretation::initWTO()
     callGraphScc->find();
     CallGraph* callGraph = ander->getCallGraph();
 
+    // The ICFG is only traversed by the WTO construction below
+    if (Options::CompactGraphs())
+        icfg->freeze();
+
     // Iterate through the call graph
     for (auto it = callGraph->begin(); it != callGraph->end(); it++)
     {
@@ -142,6 +155,11 @@ void AbstractInterpretation::initWTO()
             funcToWTO[it->second->getFunction()] = iwto;
         }
     }
+
+    icfg->thaw();
+
+    for (const auto& it : funcToWTO)
+        collectStateReaders(it.second);
 }
 
 /// Program entry
@@ -165,11 +183,14 @@ void AbstractInterpretation::handleGlobalNode()
     const ICFGNode* node = icfg->getGlobalICFGNode();
     abstractTrace[node] = AbstractState();
     abstractTrace[node][IRGraph::NullPtr] = AddressValue();
+    AbstractState sparseIn = abstractTrace[node];
     // Global Node, we just need to handle addr, load, store, copy and gep
     for (const SVFStmt *stmt: node->getSVFStmts())
     {
         handleSVFStatement(stmt);
     }
+    if (Options::UseSparseState())
+        storeSparseState(abstractTrace[node], sparseIn, AbstractState::VarToAbsValMap());
 }
 
 /// get execution state by merging states of predecessor blocks
@@ -188,6 +209,8 @@ bool AbstractInterpretation::mergeStatesFromPredecessors(const ICFGNode * icfgNo
                         SVFUtil::dyn_cast<IntraCFGEdge>(edge))
             {
                 AbstractState tmpEs = abstractTrace[edge->getSrcNode()];
+                if (Options::UseSparseState())
+                    tmpEs.overlayOn(defValues);
                 if (intraCfgEdge->getCondition())
                 {
                     if (isBranchFeasible(intraCfgEdge, tmpEs))
@@ -244,12 +267,17 @@ bool AbstractInterpretation::mergeStatesFromPredecessors(const ICFGNode * icfgNo
     {
         while (!workList.empty())
         {
+            // Values left out by a sparse state are joined as found at their definitions.
+            if (Options::UseSparseState())
+                workList.back().overlayOn(defValues);
             preAs.joinWith(workList.back());
             workList.pop_back();
         }
+        if (Options::UseSparseState())
+            preAs.leaveOut(defValues);
         // Has ES on the in edges - Feasible block
         // update post as
-        abstractTrace[icfgNode] = preAs;
+        abstractTrace[icfgNode] = std::move(preAs);
         return true;
     }
 }
@@ -325,7 +353,7 @@ bool AbstractInterpretation::isCmpBranchFeasible(const CmpStmt* cmpStmt, s64_t s
     }
     // for const X const, we may get concrete resVal instantly
     // for var X const, we may get [0,1] if the intersection of var and const is not empty set
-    IntervalValue resVal = new_es[res_id].getInterval();
+    IntervalValue resVal = new_es.at(res_id).getInterval();
     resVal.meet_with(IntervalValue((s64_t) succ, succ));
     // If Var X const generates bottom value, it means this branch path is not feasible.
     if (resVal.isBottom())
@@ -333,8 +361,8 @@ bool AbstractInterpretation::isCmpBranchFeasible(const CmpStmt* cmpStmt, s64_t s
         return false;
     }
 
-    bool b0 = new_es[op0].getInterval().is_numeral();
-    bool b1 = new_es[op1].getInterval().is_numeral();
+    bool b0 = new_es.at(op0).getInterval().is_numeral();
+    bool b1 = new_es.at(op1).getInterval().is_numeral();
 
     // if const X var, we should reverse op0 and op1.
     if (b0 && !b1)
@@ -368,7 +396,7 @@ bool AbstractInterpretation::isCmpBranchFeasible(const CmpStmt* cmpStmt, s64_t s
     // change interval range according to the compare predicate
     AddressValue addrs;
     if(load_op0 && new_es.inVarToAddrsTable(load_op0->getRHSVarID()))
-        addrs = new_es[load_op0->getRHSVarID()].getAddrs();
+        addrs = new_es.at(load_op0->getRHSVarID()).getAddrs();
 
     IntervalValue &lhs = new_es[op0].getInterval(), &rhs = new_es[op1].getInterval();
     switch (predicate)
@@ -557,11 +585,23 @@ void AbstractInterpretation::handleSingletonWTO(const ICFGSingletonWTO *icfgSing
 {
     const ICFGNode* node = icfgSingletonWto->getICFGNode();
     stat->getBlockTrace()++;
+    recordNodeVisit(node);
 
     std::deque<const ICFGNode*> worklist;
 
     stat->getICFGNodeTrace()++;
 
+    // Fill in a sparse state so that statements and detectors see every value.
+    AbstractState sparseIn;
+    AbstractState::VarToAbsValMap defs;
+    if (Options::UseSparseState())
+    {
+        AbstractState& as = getAbsStateFromTrace(node);
+        sparseIn = as;
+        defs = defValues;
+        as.overlayOn(defs);
+    }
+
     // SINGLE TRAVERSAL: Update state and detect together!
     // This eliminates redundant statement traversals that were previously
     // happening in both the main loop and each detector's detect() method.
@@ -590,7 +630,10 @@ void AbstractInterpretation::handleSingletonWTO(const ICFGSingletonWTO *icfgSing
     for (auto& detector: detectors)
         detector->detect(getAbsStateFromTrace(node), node);
 
-    stat->countStateSize();
+    if (Options::UseSparseState())
+        storeSparseState(getAbsStateFromTrace(node), sparseIn, defs);
+
+    stat->countStateSize(getAbsStateFromTrace(node));
 }
 
 /**
@@ -609,7 +652,10 @@ void AbstractInterpretation::handleWTOComponent(const ICFGWTOComp* wtoNode)
     if (const ICFGSingletonWTO* node = SVFUtil::dyn_cast<ICFGSingletonWTO>(wtoNode))
     {
         if (mergeStatesFromPredecessors(node->getICFGNode()))
+        {
             handleSingletonWTO(node);
+            watchStateReaders(node);
+        }
     }
     // Handle WTO cycles
     else if (const ICFGCycleWTO* cycle = SVFUtil::dyn_cast<ICFGCycleWTO>(wtoNode))
@@ -620,6 +666,7 @@ void AbstractInterpretation::handleWTOComponent(const ICFGWTOComp* wtoNode)
     // Assert false for unknown WTO types
     else
         assert(false && "unknown WTO type!");
+    evictDeadStates(wtoNode);
 }
 
 void AbstractInterpretation::handleCallSite(const ICFGNode* node)
@@ -738,8 +785,12 @@ void AbstractInterpretation::directCallFunPass(const CallICFGNode *callNode)
 
     callSiteStack.push_back(callNode);
 
-    const ICFGWTO* wto = funcToWTO[calleeFun];
-    handleWTOComponents(wto->getWTOComponents());
+    if (!applyCalleeSummary(calleeFun))
+    {
+        const ICFGWTO* wto = funcToWTO[calleeFun];
+        handleWTOComponents(wto->getWTOComponents());
+        endCalleeSummary(calleeFun);
+    }
 
     callSiteStack.pop_back();
     // handle Ret node
@@ -763,7 +814,7 @@ void AbstractInterpretation::indirectCallFunPass(const CallICFGNode *callNode)
     {
         return;
     }
-    AbstractValue Addrs = as[call_id];
+    AbstractValue Addrs = as.at(call_id);
     NodeID addr = *Addrs.getAddrs().begin();
     SVFVar *func_var = svfir->getGNode(as.getIDFromAddr(addr));
 
@@ -779,8 +830,12 @@ void AbstractInterpretation::indirectCallFunPass(const CallICFGNode *callNode)
         callSiteStack.push_back(callNode);
         abstractTrace[callNode] = as;
 
-        const ICFGWTO* wto = funcToWTO[callfun];
-        handleWTOComponents(wto->getWTOComponents());
+        if (!applyCalleeSummary(callfun))
+        {
+            const ICFGWTO* wto = funcToWTO[callfun];
+            handleWTOComponents(wto->getWTOComponents());
+            endCalleeSummary(callfun);
+        }
         callSiteStack.pop_back();
         // handle Ret node
         const RetICFGNode* retNode = callNode->getRetICFGNode();
@@ -788,12 +843,480 @@ void AbstractInterpretation::indirectCallFunPass(const CallICFGNode *callNode)
     }
 }
 
+/*!
+ * Apply the summary of the last analysis of callee if its entry values are
+ * unchanged. The summarised changes are made to the current entry state, whose
+ * values of the own variables and objects of the callee (left over from earlier
+ * analyses) are those the summarised entry state had.
+ */
+bool AbstractInterpretation::applyCalleeSummary(const FunObjVar* callee)
+{
+    // Summaries do not record the definitions kept out of sparse states.
+    if (Options::AESummaryLimit() == 0 || Options::UseSparseState())
+        return false;
+
+    SummaryRecord record;
+    record.overflow = !collectCalleeEntry(callee, record.entry, record.args, record.objs);
+    auto it = calleeSummaries.find(callee);
+    bool hit = !record.overflow && it != calleeSummaries.end() &&
+               it->second.args == record.args && it->second.objs == record.objs;
+    if (hit)
+    {
+        const CalleeSummary& summary = it->second;
+        auto sameValue = [](const AbstractValue* lhs, const AbstractValue* rhs)
+        {
+            return lhs == rhs || (lhs && rhs && lhs->equals(*rhs));
+        };
+        for (NodeID arg : record.args)
+            hit = hit && sameValue(record.entry.getVarToVal().lookup(arg), summary.entry.getVarToVal().lookup(arg));
+        for (NodeID obj : record.objs)
+        {
+            u32_t addr = AbstractState::getVirtualMemAddress(obj);
+            hit = hit && sameValue(record.entry.getLocToVal().lookup(obj), summary.entry.getLocToVal().lookup(obj)) &&
+                  record.entry.isFreedMem(addr) == summary.entry.isFreedMem(addr);
+        }
+    }
+    if (!hit)
+    {
+        stat->getCalleeSummaryMisses()++;
+        summaryRecords.push_back(std::move(record));
+        return false;
+    }
+    stat->getCalleeSummaryHits()++;
+
+    const CalleeSummary& summary = it->second;
+    AbstractState::VarToAbsValMap ownVars;
+    AbstractState::AddrToAbsValMap ownLocs;
+    auto takeOwn = [&](const AbstractState::VarToAbsValMap& diff, const AbstractState::VarToAbsValMap& from,
+                       AbstractState::VarToAbsValMap& own)
+    {
+        for (const auto& item : diff)
+        {
+            const AbstractValue* val = from.lookup(item.first);
+            if (val && isOwnedBy(item.first, summary.funs))
+                own[item.first] = *val;
+        }
+    };
+    takeOwn(record.entry.getVarToVal().difference(summary.entry.getVarToVal()), summary.entry.getVarToVal(), ownVars);
+    takeOwn(summary.entry.getVarToVal().difference(record.entry.getVarToVal()), summary.entry.getVarToVal(), ownVars);
+    takeOwn(record.entry.getLocToVal().difference(summary.entry.getLocToVal()), summary.entry.getLocToVal(), ownLocs);
+    takeOwn(summary.entry.getLocToVal().difference(record.entry.getLocToVal()), summary.entry.getLocToVal(), ownLocs);
+    AbstractState base = std::move(record.entry);
+    base.updateWith(ownVars, ownLocs);
+
+    for (const StateChange& change : summary.changes)
+    {
+        AbstractState state = base;
+        state.updateWith(change.vars, change.locs);
+        for (NodeID addr : change.freedAddrs)
+            state.addToFreedAddrs(addr);
+        abstractTrace[change.node] = std::move(state);
+    }
+    for (const ICFGNode* node : summary.visits)
+    {
+        recordNodeVisit(node);
+        replayDetectors(node);
+    }
+    for (const ICFGNode* node : summary.evictions)
+        evictState(node);
+    return true;
+}
+
+/*!
+ * Summarise the callee analysis which just finished, and pass the nodes it
+ * visited on to the enclosing callee analysis being summarised. A summary
+ * keeps the values of the visited node states which differ from the entry
+ * state and belong to the callee, or to the memory reachable at its entry.
+ */
+void AbstractInterpretation::endCalleeSummary(const FunObjVar* callee)
+{
+    if (Options::AESummaryLimit() == 0 || Options::UseSparseState())
+        return;
+
+    SummaryRecord record = std::move(summaryRecords.back());
+    summaryRecords.pop_back();
+
+    std::vector<std::pair<u32_t, const ICFGNode*>> visits;
+    for (const auto& visit : record.lastVisit)
+        visits.emplace_back(visit.second, visit.first);
+    std::sort(visits.begin(), visits.end());
+
+    if (!summaryRecords.empty())
+    {
+        SummaryRecord& parent = summaryRecords.back();
+        // the visits of an unrecorded callee analysis are unknown
+        parent.overflow = parent.overflow || record.overflow;
+        for (const auto& visit : visits)
+            parent.lastVisit[visit.second] = parent.numVisits++;
+        for (const auto& item : record.evicted)
+        {
+            if (!abstractTrace.count(item.first))
+                parent.evicted[item.first] = item.second;
+        }
+    }
+
+    if (record.overflow)
+    {
+        calleeSummaries.erase(callee);
+        return;
+    }
+
+    CalleeSummary& summary = calleeSummaries[callee];
+    summary.entry = std::move(record.entry);
+    summary.args = std::move(record.args);
+    summary.objs = std::move(record.objs);
+    summary.funs.clear();
+    summary.changes.clear();
+    summary.evictions.clear();
+    summary.visits.clear();
+    for (const auto& visit : visits)
+    {
+        summary.visits.push_back(visit.second);
+        if (const FunObjVar* fun = visit.second->getFun())
+            summary.funs.insert(fun);
+    }
+
+    auto isReachable = [&](NodeID id)
+    {
+        if (std::binary_search(summary.objs.begin(), summary.objs.end(), id))
+            return true;
+        // fields of reachable objects first accessed by the callee
+        const BaseObjVar* base = svfir->hasGNode(id) ? svfir->getBaseObject(id) : nullptr;
+        return base && std::binary_search(summary.objs.begin(), summary.objs.end(), base->getId());
+    };
+    for (const ICFGNode* node : summary.visits)
+    {
+        auto traceIt = abstractTrace.find(node);
+        const AbstractState* last = traceIt != abstractTrace.end() ? &traceIt->second : nullptr;
+        if (!last)
+        {
+            // evicted: the state is written for the detectors, and evicted again
+            auto evictedIt = record.evicted.find(node);
+            if (evictedIt == record.evicted.end())
+            {
+                calleeSummaries.erase(callee);
+                return;
+            }
+            last = &evictedIt->second;
+            summary.evictions.push_back(node);
+        }
+        const AbstractState& state = *last;
+        StateChange change{node, {}, {}, {}};
+        for (const auto& item : state.getVarToVal().difference(summary.entry.getVarToVal()))
+        {
+            if (isOwnedBy(item.first, summary.funs))
+                change.vars[item.first] = item.second;
+        }
+        for (const auto& item : state.getLocToVal().difference(summary.entry.getLocToVal()))
+        {
+            if (isReachable(item.first) || isOwnedBy(item.first, summary.funs))
+                change.locs[item.first] = item.second;
+        }
+        for (NodeID addr : state._freedAddrs)
+        {
+            if (!summary.entry.isFreedMem(addr))
+                change.freedAddrs.insert(addr);
+        }
+        summary.changes.push_back(std::move(change));
+    }
+}
+
+bool AbstractInterpretation::collectCalleeEntry(const FunObjVar* callee, AbstractState& entry,
+        std::vector<NodeID>& args, std::vector<NodeID>& objs)
+{
+    std::vector<NodeID> worklist = globalObjs;
+    worklist.push_back(entry.getIDFromAddr(InvalidMemAddr));
+    for (const ICFGEdge* edge : icfg->getFunEntryICFGNode(callee)->getInEdges())
+    {
+        auto traceIt = abstractTrace.find(edge->getSrcNode());
+        if (traceIt != abstractTrace.end())
+            entry.joinWith(traceIt->second);
+        if (const CallCFGEdge* callEdge = SVFUtil::dyn_cast<CallCFGEdge>(edge))
+        {
+            for (const CallPE* callPE : callEdge->getCallPEs())
+                args.push_back(callPE->getLHSVarID());
+        }
+    }
+    std::sort(args.begin(), args.end());
+    args.erase(std::unique(args.begin(), args.end()), args.end());
+    for (NodeID arg : args)
+    {
+        const AbstractValue* val = entry.getVarToVal().lookup(arg);
+        if (val && val->isAddr())
+        {
+            for (u32_t addr : val->getAddrs())
+                worklist.push_back(entry.getIDFromAddr(addr));
+        }
+    }
+
+    Set<NodeID> reached;
+    while (!worklist.empty())
+    {
+        NodeID id = worklist.back();
+        worklist.pop_back();
+        if (!reached.insert(id).second)
+            continue;
+        if (args.size() + reached.size() > Options::AESummaryLimit())
+            return false;
+        if (const BaseObjVar* base = svfir->hasGNode(id) ? svfir->getBaseObject(id) : nullptr)
+        {
+            worklist.push_back(base->getId());
+            for (NodeID field : svfir->getAllFieldsObjVars(base))
+                worklist.push_back(field);
+        }
+        const AbstractValue* val = entry.getLocToVal().lookup(id);
+        if (val && val->isAddr())
+        {
+            for (u32_t addr : val->getAddrs())
+                worklist.push_back(entry.getIDFromAddr(addr));
+        }
+    }
+    objs.assign(reached.begin(), reached.end());
+    std::sort(objs.begin(), objs.end());
+    return true;
+}
+
+bool AbstractInterpretation::isOwnedBy(NodeID id, const Set<const FunObjVar*>& funs) const
+{
+    return svfir->hasGNode(id) && funs.count(svfir->getGNode(id)->getFunction());
+}
+
+void AbstractInterpretation::replayDetectors(const ICFGNode* node)
+{
+    AbstractState& as = getAbsStateFromTrace(node);
+    for (const SVFStmt *stmt: node->getSVFStmts())
+    {
+        for (auto& detector: detectors)
+            detector->checkStatement(stmt, as);
+    }
+    if (const CallICFGNode* callnode = SVFUtil::dyn_cast<CallICFGNode>(node))
+    {
+        for (auto& detector : detectors)
+            detector->handleStubFunctions(callnode);
+    }
+    for (auto& detector: detectors)
+        detector->detect(as, node);
+}
+
+/*!
+ * A top-level variable defined by a single statement has the value of its
+ * last definition wherever it is used (apart from branch refinements, kept in
+ * the states). Objects only ever hold their own address or constant value.
+ */
+bool AbstractInterpretation::isSparseVar(NodeID id) const
+{
+    if (!svfir->hasGNode(id))
+        return false;
+    const SVFVar* var = svfir->getGNode(id);
+    if (SVFUtil::isa<ObjVar>(var))
+        return true;
+    u32_t numDefs = 0;
+    for (const SVFStmt* stmt : var->getInEdges())
+    {
+        if (!SVFUtil::isa<StoreStmt>(stmt))
+            ++numDefs;
+    }
+    return numDefs == 1;
+}
+
+/*!
+ * The sparse variables changed since the state was filled in, and not kept
+ * in sparseIn (refined), were defined at its node: they go to defValues.
+ * The state then keeps the values differing from the definitions it was
+ * filled in with, updated with those, so values left stale by definitions
+ * made meanwhile (in a callee) are dropped as well.
+ */
+void AbstractInterpretation::storeSparseState(AbstractState& as, const AbstractState& sparseIn,
+        const AbstractState::VarToAbsValMap& defs)
+{
+    AbstractState::VarToAbsValMap base = defs;
+    AbstractState denseIn = sparseIn;
+    denseIn.overlayOn(defs);
+    for (const auto& item : as.getVarToVal().difference(denseIn.getVarToVal()))
+    {
+        if (isSparseVar(item.first) && !sparseIn.getVarToVal().count(item.first))
+        {
+            defValues[item.first] = item.second;
+            base[item.first] = item.second;
+        }
+    }
+    as.leaveOut(base);
+}
+
+/*!
+ * The reader of the state of a node for one of its successors (or phis) is
+ * the successor itself, or the outermost cycle containing the successor but
+ * not the node, whose last iteration reads the state last. Nesting is
+ * given by the cycles a node is in (including the one it is the head of).
+ */
+void AbstractInterpretation::collectStateReaders(const ICFGWTO* wto)
+{
+    if (!Options::AEEvictStates())
+        return;
+
+    typedef std::vector<const ICFGCycleWTO*> CycleNest;
+    Map<const ICFGNode*, std::pair<const ICFGSingletonWTO*, CycleNest>> nodeToComp;
+    CycleNest nest;
+    std::function<void(const std::list<const ICFGWTOComp*>&)> collectNests =
+        [&](const std::list<const ICFGWTOComp*>& comps)
+    {
+        for (const ICFGWTOComp* comp : comps)
+        {
+            if (const ICFGSingletonWTO* singleton = SVFUtil::dyn_cast<ICFGSingletonWTO>(comp))
+                nodeToComp[singleton->getICFGNode()] = {singleton, nest};
+            else if (const ICFGCycleWTO* cycle = SVFUtil::dyn_cast<ICFGCycleWTO>(comp))
+            {
+                nest.push_back(cycle);
+                nodeToComp[cycle->head()->getICFGNode()] = {cycle->head(), nest};
+                collectNests(cycle->getWTOComponents());
+                nest.pop_back();
+            }
+        }
+    };
+    collectNests(wto->getWTOComponents());
+
+    // a phi reads the states of the last nodes of its incoming blocks, which
+    // are not the predecessors of the phis after the first one of a block
+    Map<const ICFGNode*, std::vector<const ICFGNode*>> phiReaders;
+    for (const auto& item : nodeToComp)
+    {
+        for (const SVFStmt* stmt : item.first->getSVFStmts())
+        {
+            if (const PhiStmt* phi = SVFUtil::dyn_cast<PhiStmt>(stmt))
+            {
+                for (u32_t i = 0; i < phi->getOpVarNum(); i++)
+                    phiReaders[phi->getOpICFGNode(i)].push_back(item.first);
+            }
+        }
+    }
+
+    for (const auto& item : nodeToComp)
+    {
+        const ICFGNode* node = item.first;
+        const CycleNest& nodeNest = item.second.second;
+        if (SVFUtil::isa<CallICFGNode, FunExitICFGNode>(node) || wto->isHead(node))
+            continue;
+
+        std::vector<const ICFGNode*> readerNodes;
+        bool evictable = true;
+        for (const ICFGEdge* edge : node->getOutEdges())
+        {
+            if (!SVFUtil::isa<IntraCFGEdge>(edge))
+                evictable = false;
+            readerNodes.push_back(edge->getDstNode());
+        }
+        auto phiIt = phiReaders.find(node);
+        if (phiIt != phiReaders.end())
+            readerNodes.insert(readerNodes.end(), phiIt->second.begin(), phiIt->second.end());
+
+        std::vector<const ICFGWTOComp*> readers;
+        for (const ICFGNode* readerNode : readerNodes)
+        {
+            auto succIt = nodeToComp.find(readerNode);
+            if (succIt == nodeToComp.end())
+            {
+                evictable = false;
+                break;
+            }
+            const CycleNest& succNest = succIt->second.second;
+            u32_t common = 0;
+            while (common < nodeNest.size() && common < succNest.size() &&
+                    nodeNest[common] == succNest[common])
+                ++common;
+            const ICFGWTOComp* reader = common < succNest.size()
+                                        ? static_cast<const ICFGWTOComp*>(succNest[common])
+                                        : succIt->second.first;
+            // the head is handled again, without the body, once widening is done
+            if (reader == succIt->second.first && wto->isHead(readerNode))
+            {
+                evictable = false;
+                break;
+            }
+            if (std::find(readers.begin(), readers.end(), reader) == readers.end())
+                readers.push_back(reader);
+        }
+        if (!evictable)
+            continue;
+        for (const ICFGWTOComp* reader : readers)
+            readStates[reader].push_back(node);
+        stateReaders[item.second.first] = std::move(readers);
+    }
+}
+
+void AbstractInterpretation::watchStateReaders(const ICFGSingletonWTO* singleton)
+{
+    auto it = stateReaders.find(singleton);
+    if (it == stateReaders.end())
+        return;
+    const ICFGNode* node = singleton->getICFGNode();
+    if (it->second.empty())
+    {
+        // nothing reads the state once the detectors have
+        evictState(node);
+    }
+    else
+        pendingStateReaders[node] = it->second;
+}
+
+void AbstractInterpretation::evictDeadStates(const ICFGWTOComp* comp)
+{
+    auto it = readStates.find(comp);
+    if (it == readStates.end())
+        return;
+    for (const ICFGNode* node : it->second)
+    {
+        auto pendingIt = pendingStateReaders.find(node);
+        if (pendingIt == pendingStateReaders.end())
+            continue;
+        std::vector<const ICFGWTOComp*>& readers = pendingIt->second;
+        auto readerIt = std::find(readers.begin(), readers.end(), comp);
+        if (readerIt == readers.end())
+            continue;
+        readers.erase(readerIt);
+        if (readers.empty())
+        {
+            pendingStateReaders.erase(pendingIt);
+            evictState(node);
+        }
+    }
+}
+
+void AbstractInterpretation::evictState(const ICFGNode* node)
+{
+    auto it = abstractTrace.find(node);
+    if (it == abstractTrace.end())
+        return;
+    // the summary replays the detectors on the state
+    if (!summaryRecords.empty() && !summaryRecords.back().overflow)
+        summaryRecords.back().evicted[node] = std::move(it->second);
+    abstractTrace.erase(it);
+    stat->getEvictedStates()++;
+}
+
 /// handle wto cycle (loop)
 void AbstractInterpretation::handleCycleWTO(const ICFGCycleWTO*cycle)
 {
     const ICFGNode* cycle_head = cycle->head()->getICFGNode();
     // Flag to indicate if we are in the increasing phase
     bool increasing = true;
+    // Definitions the sparse head state was stored against: the body overwrites the
+    // definitions of loop-carried variables in defValues, so the previous head state
+    // has to be filled in from these instead
+    AbstractState::VarToAbsValMap headDefs = defValues;
+    // Definitions the head made when last handled. The widened (or narrowed) values of
+    // other variables are kept in the head state, like refinements, as overwriting their
+    // definitions would change the states of the body reading them
+    AbstractState::VarToAbsValMap headDefined;
+    auto storeHeadState = [&](const AbstractState& sparse_head_state, const AbstractState& cur_head_state)
+    {
+        AbstractState sparseIn = sparse_head_state;
+        for (const auto& item : abstractTrace[cycle_head].getVarToVal().difference(cur_head_state.getVarToVal()))
+        {
+            if (!headDefined.count(item.first))
+                sparseIn[item.first] = item.second;
+        }
+        storeSparseState(abstractTrace[cycle_head], sparseIn, defValues);
+    };
     // Infinite loop until a fixpoint is reached,
     for (u32_t cur_iter = 0;; cur_iter++)
     {
@@ -801,9 +1324,19 @@ void AbstractInterpretation::handleCycleWTO(const ICFGCycleWTO*cycle)
         if (cur_iter >= Options::WidenDelay())
         {
             // Widen or narrow after processing cycle head node
+            // (sparse head states are filled in to be compared, then stored sparse again)
             AbstractState prev_head_state = abstractTrace[cycle_head];
+            if (Options::UseSparseState())
+                prev_head_state.overlayOn(headDefs);
+            AbstractState::VarToAbsValMap preHeadDefs = defValues;
             handleWTOComponent(cycle->head());
-            AbstractState cur_head_state = abstractTrace[cycle_head];
+            AbstractState sparse_head_state = abstractTrace[cycle_head];
+            AbstractState cur_head_state = sparse_head_state;
+            if (Options::UseSparseState())
+            {
+                cur_head_state.overlayOn(defValues);
+                headDefined = defValues.difference(preHeadDefs);
+            }
             if (increasing)
             {
 
@@ -818,10 +1351,14 @@ void AbstractInterpretation::handleCycleWTO(const ICFGCycleWTO*cycle)
 
                 // Widening
                 abstractTrace[cycle_head] = prev_head_state.widening(cur_head_state);
+                bool fixpoint = abstractTrace[cycle_head] == prev_head_state;
+                if (Options::UseSparseState())
+                    storeHeadState(sparse_head_state, cur_head_state);
 
-                if (abstractTrace[cycle_head] == prev_head_state)
+                if (fixpoint)
                 {
                     increasing = false;
+                    headDefs = defValues;
                     continue;
                 }
             }
@@ -840,7 +1377,10 @@ void AbstractInterpretation::handleCycleWTO(const ICFGCycleWTO*cycle)
                     {
                         // Widening's fixpoint reached in the widening phase, switch to narrowing
                         abstractTrace[cycle_head] = prev_head_state.narrowing(cur_head_state);
-                        if (abstractTrace[cycle_head] == prev_head_state)
+                        bool fixpoint = abstractTrace[cycle_head] == prev_head_state;
+                        if (Options::UseSparseState())
+                            storeHeadState(sparse_head_state, cur_head_state);
+                        if (fixpoint)
                         {
                             // Narrowing's fixpoint reached in the narrowing phase, exit loop
                             break;
@@ -858,7 +1398,10 @@ void AbstractInterpretation::handleCycleWTO(const ICFGCycleWTO*cycle)
                 {
                     // Widening's fixpoint reached in the widening phase, switch to narrowing
                     abstractTrace[cycle_head] = prev_head_state.narrowing(cur_head_state);
-                    if (abstractTrace[cycle_head] == prev_head_state)
+                    bool fixpoint = abstractTrace[cycle_head] == prev_head_state;
+                    if (Options::UseSparseState())
+                        storeHeadState(sparse_head_state, cur_head_state);
+                    if (fixpoint)
                     {
                         // Narrowing's fixpoint reached in the narrowing phase, exit loop
                         break;
@@ -872,6 +1415,7 @@ void AbstractInterpretation::handleCycleWTO(const ICFGCycleWTO*cycle)
             handleWTOComponent(cycle->head());
         }
         // Handle the cycle body
+        headDefs = defValues;
         handleWTOComponents(cycle->getWTOComponents());
     }
 }
@@ -977,7 +1521,7 @@ void AbstractInterpretation::SkipRecursiveCall(const CallICFGNode *callNode)
                     {
                         if (!rhsVar->isPointer() && !rhsVar->isConstDataOrAggDataButNotNullPtr())
                         {
-                            const AbstractValue &addrs = as[lhs];
+                            const AbstractValue &addrs = as.at(lhs);
                             for (const auto &addr: addrs.getAddrs())
                             {
                                 as.store(addr, IntervalValue::top());
@@ -991,7 +1535,7 @@ void AbstractInterpretation::SkipRecursiveCall(const CallICFGNode *callNode)
 }
 
 // count the size of memory map
-void AEStat::countStateSize()
+void AEStat::countStateSize(const AbstractState& as)
 {
     if (count == 0)
     {
@@ -1000,7 +1544,20 @@ void AEStat::countStateSize()
         generalNumMap["ES_Var_Addr_AVG_Num"] = 0;
         generalNumMap["ES_Loc_Addr_AVG_Num"] = 0;
     }
+    // values stored in the trace for the node just handled
+    generalNumMap["ES_Var_AVG_Num"] += as.getVarToVal().size();
+    generalNumMap["ES_Loc_AVG_Num"] += as.getLocToVal().size();
     ++count;
+
+    // peaks of the trace, and of the resident memory (sampled, as reading it is slow)
+    u32_t& peakStates = generalNumMap["Peak_Trace_States"];
+    peakStates = std::max(peakStates, (u32_t)_ae->abstractTrace.size());
+    u32_t vmrss, vmsize;
+    if (count % 1024 == 1 && SVFUtil::getMemoryUsageKB(&vmrss, &vmsize))
+    {
+        u32_t& peakRSS = generalNumMap["Peak_RSS(KB)"];
+        peakRSS = std::max(peakRSS, vmrss);
+    }
 }
 
 void AEStat::finializeStat()
@@ -1015,6 +1572,11 @@ void AEStat::finializeStat()
     }
     generalNumMap["SVF_STMT_NUM"] = count;
     generalNumMap["ICFG_Node_Num"] = _ae->svfir->getICFG()->nodeNum;
+    if (Options::CompactGraphs())
+    {
+        generalNumMap["ICFG_Edge_KB_Before_Freeze"] = _ae->svfir->getICFG()->getEdgeMemBeforeFreeze() / 1024;
+        generalNumMap["ICFG_Edge_KB_After_Freeze"] = _ae->svfir->getICFG()->getEdgeMemAfterFreeze() / 1024;
+    }
     u32_t callSiteNum = 0;
     u32_t extCallSiteNum = 0;
     Set<const FunObjVar *> funs;
@@ -1039,6 +1601,14 @@ void AEStat::finializeStat()
     generalNumMap["Func_Num"] = funs.size();
     generalNumMap["EXT_CallSite_Num"] = extCallSiteNum;
     generalNumMap["NonEXT_CallSite_Num"] = callSiteNum;
+    if (Options::UseSparseState())
+        generalNumMap["Sparse_Def_Num"] = _ae->defValues.size();
+    if (Options::AESummaryLimit() != 0 && !Options::UseSparseState())
+    {
+        u32_t summaryLookups = getCalleeSummaryHits() + getCalleeSummaryMisses();
+        if (summaryLookups > 0)
+            generalNumMap["Callee_Summary_Hit_Rate(%)"] = getCalleeSummaryHits() * 100 / summaryLookups;
+    }
     timeStatMap["Total_Time(sec)"] = (double)(endTime - startTime) / TIMEINTERVAL;
 
 }
@@ -1159,14 +1729,14 @@ void AbstractInterpretation::updateStateOnSelect(const SelectStmt *select)
     u32_t tval = select->getTrueValue()->getId();
     u32_t fval = select->getFalseValue()->getId();
     u32_t cond = select->getCondition()->getId();
-    if (as[cond].getInterval().is_numeral())
+    if (as.at(cond).getInterval().is_numeral())
     {
-        as[res] = as[cond].getInterval().is_zero() ? as[fval] : as[tval];
+        as[res] = as.at(cond).getInterval().is_zero() ? as.at(fval) : as.at(tval);
     }
     else
     {
-        as[res] = as[tval];
-        as[res].join_with(as[fval]);
+        as[res] = as.at(tval);
+        as[res].join_with(as.at(fval));
     }
 }
 
@@ -1183,7 +1753,8 @@ void AbstractInterpretation::updateStateOnPhi(const PhiStmt *phi)
         if (hasAbsStateFromTrace(opICFGNode))
         {
             AbstractState tmpEs = abstractTrace[opICFGNode];
-            AbstractState& opAs = getAbsStateFromTrace(opICFGNode);
+            if (Options::UseSparseState())
+                tmpEs.overlayOn(defValues);
             const ICFGEdge* edge =  icfg->getICFGEdge(opICFGNode, icfgNode, ICFGEdge::IntraCF);
             // if IntraEdge, check the condition, if it is feasible, join the value
             // if IntraEdge but not conditional edge, join the value
@@ -1194,14 +1765,14 @@ void AbstractInterpretation::updateStateOnPhi(const PhiStmt *phi)
                 if (intraEdge->getCondition())
                 {
                     if (isBranchFeasible(intraEdge, tmpEs))
-                        rhs.join_with(opAs[curId]);
+                        rhs.join_with(getAbstractValueFromTrace(opICFGNode, curId));
                 }
                 else
-                    rhs.join_with(opAs[curId]);
+                    rhs.join_with(getAbstractValueFromTrace(opICFGNode, curId));
             }
             else
             {
-                rhs.join_with(opAs[curId]);
+                rhs.join_with(getAbstractValueFromTrace(opICFGNode, curId));
             }
         }
     }
@@ -1214,7 +1785,7 @@ void AbstractInterpretation::updateStateOnCall(const CallPE *callPE)
     AbstractState& as = getAbsStateFromTrace(callPE->getICFGNode());
     NodeID lhs = callPE->getLHSVarID();
     NodeID rhs = callPE->getRHSVarID();
-    as[lhs] = as[rhs];
+    as[lhs] = as.at(rhs);
 }
 
 void AbstractInterpretation::updateStateOnRet(const RetPE *retPE)
@@ -1222,7 +1793,7 @@ void AbstractInterpretation::updateStateOnRet(const RetPE *retPE)
     AbstractState& as = getAbsStateFromTrace(retPE->getICFGNode());
     NodeID lhs = retPE->getLHSVarID();
     NodeID rhs = retPE->getRHSVarID();
-    as[lhs] = as[rhs];
+    as[lhs] = as.at(rhs);
 }
 
 
@@ -1232,7 +1803,7 @@ void AbstractInterpretation::updateStateOnAddr(const AddrStmt *addr)
     as.initObjVar(SVFUtil::cast<ObjVar>(addr->getRHSVar()));
     if (addr->getRHSVar()->getType()->getKind() == SVFType::SVFIntegerTy)
         as[addr->getRHSVarID()].getInterval().meet_with(utils->getRangeLimitFromType(addr->getRHSVar()->getType()));
-    as[addr->getLHSVarID()] = as[addr->getRHSVarID()];
+    as[addr->getLHSVarID()] = as.at(addr->getRHSVarID());
 }
 
 
@@ -1307,8 +1878,8 @@ void AbstractInterpretation::updateStateOnCmp(const CmpStmt *cmp)
     if (as.inVarToAddrsTable(op0) && as.inVarToAddrsTable(op1))
     {
         IntervalValue resVal;
-        AddressValue addrOp0 = as[op0].getAddrs();
-        AddressValue addrOp1 = as[op1].getAddrs();
+        AddressValue addrOp0 = as.at(op0).getAddrs();
+        AddressValue addrOp1 = as.at(op1).getAddrs();
         u32_t res = cmp->getResID();
         if (addrOp0.equals(addrOp1))
         {
@@ -1328,7 +1899,7 @@ void AbstractInterpretation::updateStateOnCmp(const CmpStmt *cmp)
     else if (op0 == IRGraph::NullPtr || op1 == IRGraph::NullPtr)
     {
         u32_t res = cmp->getResID();
-        IntervalValue resVal = (as[op0].equals(as[op1])) ? IntervalValue(1, 1) : IntervalValue(0, 0);
+        IntervalValue resVal = (as.at(op0).equals(as.at(op1))) ? IntervalValue(1, 1) : IntervalValue(0, 0);
         as[res] = resVal;
     }
     else
@@ -1341,7 +1912,7 @@ void AbstractInterpretation::updateStateOnCmp(const CmpStmt *cmp)
         if (as.inVarToValTable(op0) && as.inVarToValTable(op1))
         {
             IntervalValue resVal;
-            if (as[op0].isInterval() && as[op1].isInterval())
+            if (as.at(op0).isInterval() && as.at(op1).isInterval())
             {
                 IntervalValue &lhs = as[op0].getInterval(),
                                &rhs = as[op1].getInterval();
@@ -1395,7 +1966,7 @@ void AbstractInterpretation::updateStateOnCmp(const CmpStmt *cmp)
                 }
                 as[res] = resVal;
             }
-            else if (as[op0].isAddr() && as[op1].isAddr())
+            else if (as.at(op0).isAddr() && as.at(op1).isAddr())
             {
                 AddressValue &lhs = as[op0].getAddrs(),
                               &rhs = as[op1].getAddrs();
@@ -1526,7 +2097,7 @@ void AbstractInterpretation::updateStateOnStore(const StoreStmt *store)
     AbstractState& as = getAbsStateFromTrace(store->getICFGNode());
     u32_t rhs = store->getRHSVarID();
     u32_t lhs = store->getLHSVarID();
-    as.storeValue(lhs, as[rhs]);
+    as.storeValue(lhs, as.at(rhs));
 }
 
 void AbstractInterpretation::updateStateOnCopy(const CopyStmt *copy)
@@ -1537,29 +2108,29 @@ void AbstractInterpretation::updateStateOnCopy(const CopyStmt *copy)
         if (SVFUtil::isa<SVFIntegerType>(type))
         {
             u32_t bits = type->getByteSize() * 8;
-            if (as[var->getId()].getInterval().is_numeral())
+            if (as.at(var->getId()).getInterval().is_numeral())
             {
                 if (bits == 8)
                 {
-                    int8_t signed_i8_value = as[var->getId()].getInterval().getIntNumeral();
+                    int8_t signed_i8_value = as.at(var->getId()).getInterval().getIntNumeral();
                     u32_t unsigned_value = static_cast<uint8_t>(signed_i8_value);
                     return IntervalValue(unsigned_value, unsigned_value);
                 }
                 else if (bits == 16)
                 {
-                    s16_t signed_i16_value = as[var->getId()].getInterval().getIntNumeral();
+                    s16_t signed_i16_value = as.at(var->getId()).getInterval().getIntNumeral();
                     u32_t unsigned_value = static_cast<u16_t>(signed_i16_value);
                     return IntervalValue(unsigned_value, unsigned_value);
                 }
                 else if (bits == 32)
                 {
-                    s32_t signed_i32_value = as[var->getId()].getInterval().getIntNumeral();
+                    s32_t signed_i32_value = as.at(var->getId()).getInterval().getIntNumeral();
                     u32_t unsigned_value = static_cast<u32_t>(signed_i32_value);
                     return IntervalValue(unsigned_value, unsigned_value);
                 }
                 else if (bits == 64)
                 {
-                    s64_t signed_i64_value = as[var->getId()].getInterval().getIntNumeral();
+                    s64_t signed_i64_value = as.at(var->getId()).getInterval().getIntNumeral();
                     return IntervalValue((s64_t)signed_i64_value, (s64_t)signed_i64_value);
                     // we only support i64 at most
                 }
@@ -1577,7 +2148,7 @@ void AbstractInterpretation::updateStateOnCopy(const CopyStmt *copy)
     auto getTruncValue = [&](const AbstractState& as, const SVFVar* var,
                              const SVFType* dstType)
     {
-        const IntervalValue& itv = as[var->getId()].getInterval();
+        const IntervalValue& itv = as.at(var->getId()).getInterval();
         if(itv.isBottom()) return itv;
         // get the value of ub and lb
         s64_t int_lb = itv.lb().getIntNumeral();
@@ -1633,7 +2204,7 @@ void AbstractInterpretation::updateStateOnCopy(const CopyStmt *copy)
 
     if (copy->getCopyKind() == CopyStmt::COPYVAL)
     {
-        as[lhs] = as[rhs];
+        as[lhs] = as.at(rhs);
     }
     else if (copy->getCopyKind() == CopyStmt::ZEXT)
     {
@@ -1641,23 +2212,23 @@ void AbstractInterpretation::updateStateOnCopy(const CopyStmt *copy)
     }
     else if (copy->getCopyKind() == CopyStmt::SEXT)
     {
-        as[lhs] = as[rhs].getInterval();
+        as[lhs] = as.at(rhs).getInterval();
     }
     else if (copy->getCopyKind() == CopyStmt::FPTOSI)
     {
-        as[lhs] = as[rhs].getInterval();
+        as[lhs] = as.at(rhs).getInterval();
     }
     else if (copy->getCopyKind() == CopyStmt::FPTOUI)
     {
-        as[lhs] = as[rhs].getInterval();
+        as[lhs] = as.at(rhs).getInterval();
     }
     else if (copy->getCopyKind() == CopyStmt::SITOFP)
     {
-        as[lhs] = as[rhs].getInterval();
+        as[lhs] = as.at(rhs).getInterval();
     }
     else if (copy->getCopyKind() == CopyStmt::UITOFP)
     {
-        as[lhs] = as[rhs].getInterval();
+        as[lhs] = as.at(rhs).getInterval();
     }
     else if (copy->getCopyKind() == CopyStmt::TRUNC)
     {
@@ -1665,7 +2236,7 @@ void AbstractInterpretation::updateStateOnCopy(const CopyStmt *copy)
     }
     else if (copy->getCopyKind() == CopyStmt::FPTRUNC)
     {
-        as[lhs] = as[rhs].getInterval();
+        as[lhs] = as.at(rhs).getInterval();
     }
     else if (copy->getCopyKind() == CopyStmt::INTTOPTR)
     {
@@ -1677,9 +2248,9 @@ void AbstractInterpretation::updateStateOnCopy(const CopyStmt *copy)
     }
     else if (copy->getCopyKind() == CopyStmt::BITCAST)
     {
-        if (as[rhs].isAddr())
+        if (as.at(rhs).isAddr())
         {
-            as[lhs] = as[rhs];
+            as[lhs] = as.at(rhs);
         }
         else
         {
@@ -54,20 +54,26 @@ void DDAClient::answerQueries(PointerAnalysis* pta)
 
     collectCandidateQueries(pta->getPAG());
 
-    u32_t count = 0;
-    for (OrderedNodeSet::iterator nIter = candidateQueries.begin();
-            nIter != candidateQueries.end(); ++nIter,++count)
+    std::vector<NodeID> queries;
+    for (NodeID ptr : candidateQueries)
     {
-        PAGNode* node = pta->getPAG()->getGNode(*nIter);
-        if(pta->getPAG()->isValidTopLevelPtr(node))
-        {
-            DBOUT(DGENERAL,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
-                  " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
-            DBOUT(DDDA,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
-                  " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
-            setCurrentQueryPtr(node->getId());
-            pta->computeDDAPts(node->getId());
-        }
+        if (pta->getPAG()->isValidTopLevelPtr(pta->getPAG()->getGNode(ptr)))
+            queries.push_back(ptr);
+    }
+    /// In batch mode, let the analysis order the queries so that later ones hit
+    /// the points-to cached by earlier ones.
+    if (Options::DDABatch())
+        pta->orderDDAQueries(queries);
+
+    for (u32_t count = 0; count < queries.size(); ++count)
+    {
+        NodeID ptr = queries[count];
+        DBOUT(DGENERAL,outs() << "\n@@Computing PointsTo for :" << ptr <<
+              " [" << count + 1<< "/" << queries.size() << "]" << " \n");
+        DBOUT(DDDA,outs() << "\n@@Computing PointsTo for :" << ptr <<
+              " [" << count + 1<< "/" << queries.size() << "]" << " \n");
+        setCurrentQueryPtr(ptr);
+        pta->computeDDAPts(ptr);
     }
 
     vmrss = vmsize = 0;
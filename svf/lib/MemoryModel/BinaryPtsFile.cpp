@@ -0,0 +1,219 @@
+//===- BinaryPtsFile.cpp -- Memory-mappable points-to result file ------------//
+
+/*
+ * BinaryPtsFile.cpp
+ *
+ * Versioned binary format for storing pointer analysis results which can be
+ * memory mapped and queried lazily (implementation).
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <assert.h>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MemoryModel/BinaryPtsFile.h"
+
+using namespace SVF;
+
+const char BinaryPtsFile::Magic[8] = { 'S', 'V', 'F', 'P', 'T', 'S', 'B', '\0' };
+const u32_t BinaryPtsFile::Version = 1;
+
+/// Round up to the alignment of all sections.
+static inline u64_t alignSection(u64_t offset)
+{
+    return (offset + 7) & ~(u64_t)7;
+}
+
+void BinaryPtsFile::Writer::addPts(NodeID var, const PointsTo& pts)
+{
+    if (pts.empty()) return;
+
+    auto it = setToIdx.find(pts);
+    if (it == setToIdx.end())
+    {
+        it = setToIdx.emplace(pts, (u32_t)sets.size()).first;
+        sets.push_back(&it->first);
+    }
+    varToSet.emplace_back(var, it->second);
+}
+
+void BinaryPtsFile::Writer::addGepObj(NodeID base, APOffset offset, NodeID id)
+{
+    gepObjs.push_back({base, id, offset});
+}
+
+void BinaryPtsFile::Writer::setFieldInsensitive(NodeID base)
+{
+    u64_t word = base / 64;
+    if (fiBitmap.size() <= word) fiBitmap.resize(word + 1, 0);
+    fiBitmap[word] |= (u64_t)1 << (base % 64);
+}
+
+bool BinaryPtsFile::Writer::write(const std::string& filename) const
+{
+    std::vector<std::pair<NodeID, u32_t>> sortedVars(varToSet);
+    std::sort(sortedVars.begin(), sortedVars.end());
+
+    // Flatten the unique sets into the pool, elements sorted for binary compatibility
+    // across points-to set implementations (and node mappings).
+    std::vector<u64_t> setOffsets;
+    std::vector<NodeID> pool;
+    setOffsets.reserve(sets.size() + 1);
+    for (const PointsTo* pts : sets)
+    {
+        setOffsets.push_back(pool.size());
+        size_t begin = pool.size();
+        for (NodeID o : *pts) pool.push_back(o);
+        std::sort(pool.begin() + begin, pool.end());
+    }
+    setOffsets.push_back(pool.size());
+
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, Magic, sizeof(h.magic));
+    h.version = Version;
+    h.numVars = sortedVars.size();
+    h.numSets = sets.size();
+    h.numPoolElems = pool.size();
+    h.numGepObjs = gepObjs.size();
+    h.numFIWords = fiBitmap.size();
+    h.nodeTableOffset = alignSection(sizeof(Header));
+    h.varSetOffset = alignSection(h.nodeTableOffset + h.numVars * sizeof(NodeID));
+    h.setOffsetsOffset = alignSection(h.varSetOffset + h.numVars * sizeof(u32_t));
+    h.poolOffset = alignSection(h.setOffsetsOffset + setOffsets.size() * sizeof(u64_t));
+    h.gepTableOffset = alignSection(h.poolOffset + h.numPoolElems * sizeof(NodeID));
+    h.fiBitmapOffset = alignSection(h.gepTableOffset + h.numGepObjs * sizeof(GepObj));
+
+    std::ofstream f(filename.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!f.good()) return false;
+
+    u64_t written = 0;
+    auto pad = [&f, &written](u64_t offset)
+    {
+        static const char zeros[8] = { 0 };
+        assert(offset >= written && offset - written < 8 && "BinaryPtsFile: bad section offset");
+        f.write(zeros, offset - written);
+        written = offset;
+    };
+    auto put = [&f, &written](const void* bytes, u64_t n)
+    {
+        f.write(static_cast<const char*>(bytes), n);
+        written += n;
+    };
+
+    put(&h, sizeof(h));
+
+    pad(h.nodeTableOffset);
+    for (const std::pair<NodeID, u32_t>& vs : sortedVars) put(&vs.first, sizeof(NodeID));
+
+    pad(h.varSetOffset);
+    for (const std::pair<NodeID, u32_t>& vs : sortedVars) put(&vs.second, sizeof(u32_t));
+
+    pad(h.setOffsetsOffset);
+    put(setOffsets.data(), setOffsets.size() * sizeof(u64_t));
+
+    pad(h.poolOffset);
+    put(pool.data(), pool.size() * sizeof(NodeID));
+
+    pad(h.gepTableOffset);
+    put(gepObjs.data(), gepObjs.size() * sizeof(GepObj));
+
+    pad(h.fiBitmapOffset);
+    put(fiBitmap.data(), fiBitmap.size() * sizeof(u64_t));
+
+    f.close();
+    return f.good();
+}
+
+BinaryPtsFile::~BinaryPtsFile()
+{
+    close();
+}
+
+bool BinaryPtsFile::isBinaryPtsFile(const std::string& filename)
+{
+    char magic[sizeof(Magic)];
+    std::ifstream f(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!f.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+bool BinaryPtsFile::open(const std::string& filename)
+{
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (u64_t)st.st_size < sizeof(Header))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    data = static_cast<const char*>(mapped);
+    size = st.st_size;
+
+    const Header* h = header();
+    bool valid = std::memcmp(h->magic, Magic, sizeof(Magic)) == 0 && h->version == Version
+                 && h->nodeTableOffset + h->numVars * sizeof(NodeID) <= size
+                 && h->varSetOffset + h->numVars * sizeof(u32_t) <= size
+                 && h->setOffsetsOffset + (h->numSets + 1) * sizeof(u64_t) <= size
+                 && h->poolOffset + h->numPoolElems * sizeof(NodeID) <= size
+                 && h->gepTableOffset + h->numGepObjs * sizeof(GepObj) <= size
+                 && h->fiBitmapOffset + h->numFIWords * sizeof(u64_t) <= size;
+    if (!valid)
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void BinaryPtsFile::close()
+{
+    if (data != nullptr) munmap(const_cast<char*>(data), size);
+    data = nullptr;
+    size = 0;
+}
+
+bool BinaryPtsFile::getPts(NodeID var, PointsTo& pts) const
+{
+    const NodeID* vars = nodeTable();
+    const NodeID* varsEnd = vars + header()->numVars;
+    const NodeID* it = std::lower_bound(vars, varsEnd, var);
+    if (it == varsEnd || *it != var) return false;
+
+    u32_t setIdx = section<u32_t>(header()->varSetOffset)[it - vars];
+    assert(setIdx < header()->numSets && "BinaryPtsFile::getPts: corrupt var->set index!");
+    const u64_t* setOffsets = section<u64_t>(header()->setOffsetsOffset);
+    const NodeID* pool = section<NodeID>(header()->poolOffset);
+    for (u64_t i = setOffsets[setIdx], e = setOffsets[setIdx + 1]; i < e; ++i)
+        pts.set(pool[i]);
+
+    return true;
+}
+
+void BinaryPtsFile::getFieldInsensitiveObjs(std::vector<NodeID>& objs) const
+{
+    const u64_t* words = section<u64_t>(header()->fiBitmapOffset);
+    for (u64_t w = 0; w < header()->numFIWords; ++w)
+    {
+        for (u64_t word = words[w]; word != 0; word &= word - 1)
+            objs.push_back((NodeID)(w * 64 + __builtin_ctzll(word)));
+    }
+}
@@ -0,0 +1,117 @@
+//===- PTASnapshot.cpp -- Read-only snapshot of pointer analysis results ---//
+
+/*
+ * PTASnapshot.cpp
+ *
+ * Immutable, compact copy of solved points-to sets which client analyses can
+ * query from many threads without synchronisation (implementation).
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+
+#include "MemoryModel/PTASnapshot.h"
+#include "MemoryModel/PointerAnalysisImpl.h"
+
+using namespace SVF;
+
+bool PTASnapshot::PtsRange::test(NodeID n) const
+{
+    return std::binary_search(b, e, n);
+}
+
+bool PTASnapshot::PtsRange::intersects(const PtsRange& rhs) const
+{
+    const NodeID* i = b;
+    const NodeID* j = rhs.b;
+    while (i != e && j != rhs.e)
+    {
+        if (*i < *j) ++i;
+        else if (*j < *i) ++j;
+        else return true;
+    }
+    return false;
+}
+
+/*!
+ * Intern every distinct points-to set of the SVFIR nodes, then their
+ * field-insensitive expansions. All remapping is done while copying, as
+ * PointsTo iterators return node IDs.
+ */
+PTASnapshot::PTASnapshot(BVDataPTAImpl* pta)
+{
+    SVFIR* pag = pta->getPAG();
+    blackHole = pag->getBlackHoleNode();
+
+    // Set 0 is the empty set.
+    Map<PointsTo, u32_t> setToIdx;
+    setOffsets.push_back(0);
+    setOffsets.push_back(0);
+
+    auto intern = [&](const PointsTo& pts) -> u32_t
+    {
+        if (pts.empty()) return 0;
+        auto res = setToIdx.emplace(pts, getNumOfSets());
+        if (res.second)
+        {
+            size_t start = pool.size();
+            pool.insert(pool.end(), pts.begin(), pts.end());
+            std::sort(pool.begin() + start, pool.end());
+            setOffsets.push_back(pool.size());
+        }
+        return res.first->second;
+    };
+
+    // SVFIR nodes are visited in ascending ID order, so ptrIds is sorted.
+    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
+    {
+        if (u32_t set = intern(pta->getPts(it->first)))
+        {
+            ptrIds.push_back(it->first);
+            ptrSets.push_back(set);
+        }
+    }
+    ptrIds.shrink_to_fit();
+    ptrSets.shrink_to_fit();
+    assert(std::is_sorted(ptrIds.begin(), ptrIds.end()) && "pointers not sorted?");
+
+    u32_t numPtrSets = getNumOfSets();
+    expandedSet.resize(numPtrSets);
+    PointsTo pts;
+    PointsTo expanded;
+    for (u32_t set = 0; set < numPtrSets; ++set)
+    {
+        pts.clear();
+        for (NodeID o : getSetRange(set))
+            pts.set(o);
+        pta->expandFIObjs(pts, expanded);
+        expandedSet[set] = intern(expanded);
+    }
+    // Expansions only reached through expandedSet are already expanded.
+    for (u32_t set = numPtrSets; set < getNumOfSets(); ++set)
+        expandedSet.push_back(set);
+
+    pool.shrink_to_fit();
+    setOffsets.shrink_to_fit();
+}
+
+/*!
+ * Return alias results based on the points-to sets of the snapshot
+ */
+AliasResult PTASnapshot::alias(NodeID node1, NodeID node2) const
+{
+    PtsRange pts1 = getSetRange(expandedSet[getSet(node1)]);
+    PtsRange pts2 = getSetRange(expandedSet[getSet(node2)]);
+
+    if (pts1.test(blackHole) || pts2.test(blackHole) || pts1.intersects(pts2))
+        return AliasResult::MayAlias;
+    else
+        return AliasResult::NoAlias;
+}
+
+u64_t PTASnapshot::getMemoryUsage() const
+{
+    return ptrIds.capacity() * sizeof(NodeID) + ptrSets.capacity() * sizeof(u32_t) + setOffsets.capacity() * sizeof(u64_t)
+           + expandedSet.capacity() * sizeof(u32_t) + pool.capacity() * sizeof(NodeID);
+}
@@ -247,6 +247,19 @@ void PointerAnalysis::dumpAllTypes()
     }
 }
 
+/*!
+ * Answer alias queries in batch, one after the other
+ */
+std::vector<AliasResult> PointerAnalysis::batchAlias(const std::vector<NodePair>& queries)
+{
+    std::lock_guard<std::mutex> guard(queryLock);
+    std::vector<AliasResult> results;
+    results.reserve(queries.size());
+    for (const NodePair& query : queries)
+        results.push_back(alias(query.first, query.second));
+    return results;
+}
+
 /*!
  * Dump points-to of top-level pointers (ValVar)
  */
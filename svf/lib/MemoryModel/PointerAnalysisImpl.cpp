@@ -44,17 +44,19 @@ using namespace std;
  * Constructor
  */
 BVDataPTAImpl::BVDataPTAImpl(SVFIR* p, PointerAnalysis::PTATY type, bool alias_check) :
-    PointerAnalysis(p, type, alias_check), ptCache()
+    PointerAnalysis(p, type, alias_check), ptCache(), aliasCache(Options::AliasCacheSize())
 {
     if (type == Andersen_BASE || type == Andersen_WPA || type == AndersenWaveDiff_WPA
             || type == TypeCPP_WPA || type == FlowS_DDA
-            || type == AndersenSCD_WPA || type == AndersenSFR_WPA || type == CFLFICI_WPA || type == CFLFSCS_WPA)
+            || type == AndersenSCD_WPA || type == AndersenSFR_WPA
+            || type == AndersenLCD_WPA || type == AndersenHCD_WPA || type == CFLFICI_WPA || type == CFLFSCS_WPA)
     {
         // Only maintain reverse points-to when the analysis is field-sensitive, as objects turning
         // field-insensitive is all it is used for.
         bool maintainRevPts = Options::MaxFieldLimit() != 0;
         if (Options::ptDataBacking() == PTBackingType::Mutable) ptD = std::make_unique<MutDiffPTDataTy>(maintainRevPts);
         else if (Options::ptDataBacking() == PTBackingType::Persistent) ptD = std::make_unique<PersDiffPTDataTy>(getPtCache(), maintainRevPts);
+        else if (Options::ptDataBacking() == PTBackingType::Hybrid) ptD = std::make_unique<PersDiffPTDataTy>(getPtCache(), maintainRevPts, PTDataTy::PersDiff, true);
         else assert(false && "BVDataPTAImpl::BVDataPTAImpl: unexpected points-to backing type!");
     }
     else if (type == Steensgaard_WPA)
@@ -62,27 +64,30 @@ BVDataPTAImpl::BVDataPTAImpl(SVFIR* p, PointerAnalysis::PTATY type, bool alias_c
         // Steensgaard is only field-insensitive (for now?), so no reverse points-to.
         if (Options::ptDataBacking() == PTBackingType::Mutable) ptD = std::make_unique<MutDiffPTDataTy>(false);
         else if (Options::ptDataBacking() == PTBackingType::Persistent) ptD = std::make_unique<PersDiffPTDataTy>(getPtCache(), false);
+        else if (Options::ptDataBacking() == PTBackingType::Hybrid) ptD = std::make_unique<PersDiffPTDataTy>(getPtCache(), false, PTDataTy::PersDiff, true);
         else assert(false && "BVDataPTAImpl::BVDataPTAImpl: unexpected points-to backing type!");
     }
     else if (type == FSSPARSE_WPA)
     {
+        // The flow-sensitive data structures do not reference count (yet), so the hybrid
+        // backing is the persistent one here (and for VFS).
         if (Options::INCDFPTData())
         {
             if (Options::ptDataBacking() == PTBackingType::Mutable) ptD = std::make_unique<MutIncDFPTDataTy>(false);
-            else if (Options::ptDataBacking() == PTBackingType::Persistent) ptD = std::make_unique<PersIncDFPTDataTy>(getPtCache(), false);
+            else if (Options::ptDataBacking() == PTBackingType::Persistent || Options::ptDataBacking() == PTBackingType::Hybrid) ptD = std::make_unique<PersIncDFPTDataTy>(getPtCache(), false);
             else assert(false && "BVDataPTAImpl::BVDataPTAImpl: unexpected points-to backing type!");
         }
         else
         {
             if (Options::ptDataBacking() == PTBackingType::Mutable) ptD = std::make_unique<MutDFPTDataTy>(false);
-            else if (Options::ptDataBacking() == PTBackingType::Persistent) ptD = std::make_unique<PersDFPTDataTy>(getPtCache(), false);
+            else if (Options::ptDataBacking() == PTBackingType::Persistent || Options::ptDataBacking() == PTBackingType::Hybrid) ptD = std::make_unique<PersDFPTDataTy>(getPtCache(), false);
             else assert(false && "BVDataPTAImpl::BVDataPTAImpl: unexpected points-to backing type!");
         }
     }
     else if (type == VFS_WPA)
     {
         if (Options::ptDataBacking() == PTBackingType::Mutable) ptD = std::make_unique<MutVersionedPTDataTy>(false);
-        else if (Options::ptDataBacking() == PTBackingType::Persistent) ptD = std::make_unique<PersVersionedPTDataTy>(getPtCache(), false);
+        else if (Options::ptDataBacking() == PTBackingType::Persistent || Options::ptDataBacking() == PTBackingType::Hybrid) ptD = std::make_unique<PersVersionedPTDataTy>(getPtCache(), false);
         else assert(false && "BVDataPTAImpl::BVDataPTAImpl: unexpected points-to backing type!");
     }
     else assert(false && "no points-to data available");
@@ -93,9 +98,11 @@ BVDataPTAImpl::BVDataPTAImpl(SVFIR* p, PointerAnalysis::PTATY type, bool alias_c
 void BVDataPTAImpl::finalize()
 {
     normalizePointsTo();
+    // Solvers may also update the points-to data directly.
+    invalidateAliasCache();
     PointerAnalysis::finalize();
 
-    if (Options::ptDataBacking() == PTBackingType::Persistent && print_stat)
+    if (Options::ptDataBacking() != PTBackingType::Mutable && print_stat)
     {
         std::string moduleName(pag->getModuleIdentifier());
         std::vector<std::string> names = SVFUtil::split(moduleName,'/');
@@ -121,6 +128,19 @@ void BVDataPTAImpl::finalize()
         SVFUtil::outs() << "################ (program : " << moduleName << ")###############\n";
         SVFUtil::outs().flags(std::ios::left);
         ptCache.printStats("bitvector");
+        if (Options::ptDataBacking() == PTBackingType::Hybrid)
+        {
+            if (const PersDiffPTDataTy *pd = SVFUtil::dyn_cast<PersDiffPTDataTy>(ptD.get()))
+            {
+                // What a points-to set per pointer would take against what is actually stored.
+                u64_t perPointerBytes = 0, sharedBytes = 0;
+                pd->getMemoryUsage(perPointerBytes, sharedBytes);
+                const unsigned fieldWidth = 25;
+                SVFUtil::outs() << std::setw(fieldWidth) << "PerPointerPtsBytes" << perPointerBytes << "\n";
+                SVFUtil::outs() << std::setw(fieldWidth) << "SharedPtsBytes" << sharedBytes << "\n";
+                SVFUtil::outs() << std::setw(fieldWidth) << "SavedPtsBytes" << perPointerBytes - sharedBytes << "\n";
+            }
+        }
         SVFUtil::outs() << "#######################################################" << std::endl;
         SVFUtil::outs().flush();
     }
@@ -159,6 +179,11 @@ void BVDataPTAImpl::remapPointsToSets(void)
     getPTDataTy()->remapAllPts();
 }
 
+std::unique_ptr<const PTASnapshot> BVDataPTAImpl::snapshot()
+{
+    return std::make_unique<const PTASnapshot>(this);
+}
+
 void BVDataPTAImpl::writeObjVarToFile(const string& filename)
 {
     outs() << "Storing ObjVar to '" << filename << "'...";
@@ -357,29 +382,30 @@ void BVDataPTAImpl::readGepObjVarMapFromFile(std::ifstream& F)
         ss >> base >> offset >>id;
         SVFIR::NodeOffsetMap::const_iterator iter = gepObjVarMap.find(std::make_pair(base, offset));
         if (iter == gepObjVarMap.end())
-        {
-            SVFVar* node = pag->getGNode(base);
-            const BaseObjVar* obj = nullptr;
-            if (GepObjVar* gepObjVar = SVFUtil::dyn_cast<GepObjVar>(node))
-            {
-                obj = gepObjVar->getBaseObj();
-            }
-            else if (BaseObjVar* baseNode = SVFUtil::dyn_cast<BaseObjVar>(node))
-            {
-                obj = baseNode;
-            }
-            else if (DummyObjVar* baseNode = SVFUtil::dyn_cast<DummyObjVar>(node))
-            {
-                obj = baseNode;
-            }
-            else
-                assert(false && "new gep obj node kind?");
-            pag->addGepObjNode( obj, offset, id);
-            NodeIDAllocator::get()->increaseNumOfObjAndNodes();
-        }
-
+            addGepObjVarFromFile(base, offset, id);
+    }
+}
 
+void BVDataPTAImpl::addGepObjVarFromFile(NodeID base, APOffset offset, NodeID id)
+{
+    SVFVar* node = pag->getGNode(base);
+    const BaseObjVar* obj = nullptr;
+    if (GepObjVar* gepObjVar = SVFUtil::dyn_cast<GepObjVar>(node))
+    {
+        obj = gepObjVar->getBaseObj();
     }
+    else if (BaseObjVar* baseNode = SVFUtil::dyn_cast<BaseObjVar>(node))
+    {
+        obj = baseNode;
+    }
+    else if (DummyObjVar* baseNode = SVFUtil::dyn_cast<DummyObjVar>(node))
+    {
+        obj = baseNode;
+    }
+    else
+        assert(false && "new gep obj node kind?");
+    pag->addGepObjNode( obj, offset, id);
+    NodeIDAllocator::get()->increaseNumOfObjAndNodes();
 }
 
 void BVDataPTAImpl::readAndSetObjFieldSensitivity(std::ifstream& F, const std::string& delimiterStr)
@@ -410,6 +436,8 @@ void BVDataPTAImpl::readAndSetObjFieldSensitivity(std::ifstream& F, const std::s
  */
 bool BVDataPTAImpl::readFromFile(const string& filename)
 {
+    if (BinaryPtsFile::isBinaryPtsFile(filename))
+        return readFromBinaryFile(filename);
 
     outs() << "Loading pointer analysis results from '" << filename << "'...";
 
@@ -438,6 +466,100 @@ bool BVDataPTAImpl::readFromFile(const string& filename)
 }
 
 
+/*!
+ * Store pointer analysis result into a binary file (see BinaryPtsFile).
+ * Unlike writeToFile, the whole file is written at once and replaces any
+ * existing file, so writeObjVarToFile is not needed beforehand.
+ */
+void BVDataPTAImpl::writeToBinaryFile(const string& filename)
+{
+    outs() << "Storing pointer analysis results to '" << filename << "' (binary)...";
+
+    BinaryPtsFile::Writer writer;
+    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
+        writer.addPts(it->first, getPts(it->first));
+
+    const SVFIR::NodeOffsetMap &gepObjVarMap = pag->getGepObjNodeMap();
+    for (const auto& gepObj : gepObjVarMap)
+        writer.addGepObj(gepObj.first.first, gepObj.first.second, gepObj.second);
+
+    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
+    {
+        if (!isa<ObjVar>(it->second)) continue;
+        NodeID base = pag->getBaseObjVar(it->first);
+        if (isFieldInsensitive(base))
+            writer.setFieldInsensitive(base);
+    }
+
+    if (!writer.write(filename))
+    {
+        outs() << "  error writing file!\n";
+        return;
+    }
+    outs() << "\n";
+}
+
+/*!
+ * Map a binary pointer analysis result file (see BinaryPtsFile).
+ * Gep objects and field-insensitivity are restored right away, while the
+ * points-to sets are only loaded when first queried through getPts.
+ */
+bool BVDataPTAImpl::readFromBinaryFile(const string& filename)
+{
+    outs() << "Loading pointer analysis results from '" << filename << "' (binary)...";
+
+    std::unique_ptr<BinaryPtsFile> file = std::make_unique<BinaryPtsFile>();
+    if (!file->open(filename))
+    {
+        outs() << "  error opening file for reading!\n";
+        return false;
+    }
+
+    const SVFIR::NodeOffsetMap &gepObjVarMap = pag->getGepObjNodeMap();
+    for (u64_t i = 0; i < file->getNumGepObjs(); ++i)
+    {
+        const BinaryPtsFile::GepObj& gepObj = file->getGepObj(i);
+        if (gepObjVarMap.find(std::make_pair(gepObj.base, gepObj.offset)) == gepObjVarMap.end())
+            addGepObjVarFromFile(gepObj.base, gepObj.offset, gepObj.id);
+    }
+
+    std::vector<NodeID> fiObjs;
+    file->getFieldInsensitiveObjs(fiObjs);
+    for (NodeID base : fiObjs)
+        setObjFieldInsensitive(base);
+
+    mappedPts = std::move(file);
+    mappedPtsLoaded.clear();
+
+    // Update callgraph
+    updateCallGraph(pag->getIndirectCallsites());
+    // Points-to sets are loaded as they are queried, not all at once.
+    assert(mappedPts && "all points-to sets of the binary results loaded while reading them!");
+
+    outs() << "\n";
+
+    return true;
+}
+
+void BVDataPTAImpl::loadMappedPtsFromFile(NodeID id) const
+{
+    PointsTo pts;
+    if (mappedPts->getPts(id, pts))
+        ptD->unionPts(id, pts);
+}
+
+void BVDataPTAImpl::loadAllMappedPtsFromFile() const
+{
+    for (u64_t i = 0; i < mappedPts->getNumVars(); ++i)
+    {
+        NodeID id = mappedPts->getVar(i);
+        if (mappedPtsLoaded.test_and_set(id))
+            loadMappedPtsFromFile(id);
+    }
+    mappedPts.reset();
+    mappedPtsLoaded.clear();
+}
+
 /*!
  * Dump points-to of each pag node
  */
@@ -621,6 +743,53 @@ AliasResult BVDataPTAImpl::alias(NodeID node1, NodeID node2)
     return alias(getPts(node1),getPts(node2));
 }
 
+/*!
+ * Answer alias queries in batch. Looking up points-to sets and computing
+ * uncached results may update the points-to data, so is serialized.
+ * Results cached before points-to sets changed are dropped first.
+ */
+std::vector<AliasResult> BVDataPTAImpl::batchAlias(const std::vector<NodePair>& queries)
+{
+    std::vector<AliasResult> results(queries.size(), AliasResult::MayAlias);
+    std::vector<PtsPair> keys(queries.size());
+    {
+        std::lock_guard<std::mutex> guard(queryLock);
+        u64_t generation = getPtsGeneration();
+        if (generation != aliasCacheGeneration)
+        {
+            aliasCache.clear();
+            aliasCacheGeneration = generation;
+        }
+        for (u32_t i = 0; i < queries.size(); ++i)
+        {
+            const PointsTo* p1 = &getPts(queries[i].first);
+            const PointsTo* p2 = &getPts(queries[i].second);
+            keys[i] = p1 < p2 ? PtsPair(p1, p2) : PtsPair(p2, p1);
+        }
+    }
+
+    std::vector<u32_t> misses;
+    for (u32_t i = 0; i < queries.size(); ++i)
+    {
+        if (!aliasCache.get(keys[i], results[i]))
+            misses.push_back(i);
+    }
+
+    if (misses.empty())
+        return results;
+
+    {
+        std::lock_guard<std::mutex> guard(queryLock);
+        for (u32_t i : misses)
+            results[i] = alias(*keys[i].first, *keys[i].second);
+    }
+
+    for (u32_t i : misses)
+        aliasCache.put(keys[i], results[i]);
+
+    return results;
+}
+
 /*!
  * Return alias results based on our points-to/alias analysis
  */
@@ -65,6 +65,10 @@ void SrcSnkDDA::analyze()
 
     ContextCond::setMaxCxtLen(Options::CxtLimit());
 
+    /// the SVFG is only traversed from here on
+    if (Options::CompactGraphs())
+        svfg->freeze();
+
     for (SVFGNodeSetIter iter = sourcesBegin(), eiter = sourcesEnd();
             iter != eiter; ++iter)
     {
@@ -106,6 +110,7 @@ void SrcSnkDDA::analyze()
 
         reportBug(getCurSlice());
     }
+    svfg->thaw();
     finalize();
 
 }
@@ -1,7 +1,10 @@
 //===- NodeIDAllocator.cpp -- Allocates node IDs on request ------------------------//
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <queue>
 #include <cmath>
 
@@ -177,6 +180,7 @@ const std::string NodeIDAllocator::Clusterer::RegioningTime = "RegioningTime";
 const std::string NodeIDAllocator::Clusterer::DistanceMatrixTime = "DistanceMatrixTime";
 const std::string NodeIDAllocator::Clusterer::FastClusterTime = "FastClusterTime";
 const std::string NodeIDAllocator::Clusterer::DendrogramTraversalTime = "DendrogramTravTime";
+const std::string NodeIDAllocator::Clusterer::MinHashTime = "MinHashTime";
 const std::string NodeIDAllocator::Clusterer::EvalTime = "EvalTime";
 const std::string NodeIDAllocator::Clusterer::TotalTime = "TotalTime";
 const std::string NodeIDAllocator::Clusterer::TheoreticalNumWords = "TheoreticalWords";
@@ -199,6 +203,7 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
     double fastClusterTime = 0.0;
     double distanceMatrixTime = 0.0;
     double dendrogramTraversalTime = 0.0;
+    double minHashTime = 0.0;
     double regioningTime = 0.0;
     double evalTime = 0.0;
 
@@ -317,6 +322,7 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
         methods.push_back(HCLUST_METHOD_SINGLE);
         methods.push_back(HCLUST_METHOD_COMPLETE);
         methods.push_back(HCLUST_METHOD_AVERAGE);
+        methods.push_back(HCLUST_METHOD_SVF_MINHASH);
     }
     else
     {
@@ -355,6 +361,13 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
             ++numGtIntRegions;
             nonTrivialRegionObjects += regionNumObjects;
 
+            if (method == HCLUST_METHOD_SVF_MINHASH)
+            {
+                minHashOrder(regionsPointsTos[region], regionNumObjects, regionReverseMappings[region],
+                             nodeMap, allocCounter, regionMappings[region], minHashTime);
+                continue;
+            }
+
             double *distMatrix = getDistanceMatrix(regionsPointsTos[region], regionNumObjects,
                                                    regionReverseMappings[region], distanceMatrixTime);
 
@@ -391,8 +404,10 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
     overallStats[DistanceMatrixTime] = std::to_string(distanceMatrixTime);
     overallStats[DendrogramTraversalTime] = std::to_string(dendrogramTraversalTime);
     overallStats[FastClusterTime] = std::to_string(fastClusterTime);
+    overallStats[MinHashTime] = std::to_string(minHashTime);
     overallStats[EvalTime] = std::to_string(evalTime);
-    overallStats[TotalTime] = std::to_string(distanceMatrixTime + dendrogramTraversalTime + fastClusterTime + regioningTime + evalTime);
+    overallStats[TotalTime] = std::to_string(distanceMatrixTime + dendrogramTraversalTime + fastClusterTime
+                              + minHashTime + regioningTime + evalTime);
 
     overallStats[BestCandidate] = SVFUtil::hclustMethodToString(bestMapping.first);
     printStats(evalSubtitle + ": overall", overallStats);
@@ -535,6 +550,68 @@ void NodeIDAllocator::Clusterer::traverseDendrogram(std::vector<NodeID> &nodeMap
     }
 }
 
+void NodeIDAllocator::Clusterer::minHashOrder(const std::vector<std::pair<const PointsTo *, unsigned>> &pointsToSets,
+        const size_t numObjects, const Map<NodeID, unsigned> &nodeMap,
+        std::vector<NodeID> &mapping, unsigned &allocCounter,
+        const std::vector<NodeID> &regionNodeMap, double &minHashTime)
+{
+    const double clkStart = PTAStat::getClk(true);
+    const u32_t numHashes = Options::ClusterMinHashes();
+    assert(numHashes > 0 && "Clusterer::minHashOrder: need at least one hash function");
+
+    // signatures[o * numHashes + k] is the minimum of the kth hash over the points-to sets
+    // containing (region object) o. Hashing the sets themselves keeps the result independent
+    // of the order of pointsToSets.
+    std::vector<u64_t> signatures(numObjects * numHashes, std::numeric_limits<u64_t>::max());
+    std::vector<u64_t> ptsHashes(numHashes);
+    for (const std::pair<const PointsTo *, unsigned> &ptsOcc : pointsToSets)
+    {
+        const PointsTo *pts = ptsOcc.first;
+        assert(pts != nullptr);
+        // std::hash<PointsTo> only looks at the count and bounds of some backings,
+        // so distinct sets would share signatures: hash every element instead.
+        u64_t ptsHash = pts->count();
+        for (const NodeID o : *pts) ptsHash = mixHash(ptsHash ^ o);
+        for (u32_t k = 0; k < numHashes; ++k) ptsHashes[k] = mixHash(ptsHash + mixHash(k));
+
+        for (const NodeID o : *pts)
+        {
+            const Map<NodeID, unsigned>::const_iterator mo = nodeMap.find(o);
+            assert(mo != nodeMap.end());
+            u64_t *signature = &signatures[(size_t)mo->second * numHashes];
+            for (u32_t k = 0; k < numHashes; ++k) signature[k] = std::min(signature[k], ptsHashes[k]);
+        }
+    }
+
+    // Sorting the signatures lexicographically puts objects with equal signatures together,
+    // then those sharing a prefix. Ties are broken by the original order.
+    std::vector<unsigned> order(numObjects);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&signatures, numHashes](const unsigned a, const unsigned b)
+    {
+        const u64_t *sigA = &signatures[(size_t)a * numHashes];
+        const u64_t *sigB = &signatures[(size_t)b * numHashes];
+        for (u32_t k = 0; k < numHashes; ++k)
+        {
+            if (sigA[k] != sigB[k]) return sigA[k] < sigB[k];
+        }
+        return a < b;
+    });
+
+    for (const unsigned o : order) mapping[regionNodeMap[o]] = allocCounter++;
+
+    const double clkEnd = PTAStat::getClk(true);
+    minHashTime += (clkEnd - clkStart) / TIMEINTERVAL;
+}
+
+u64_t NodeIDAllocator::Clusterer::mixHash(u64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
 std::vector<NodeID> NodeIDAllocator::Clusterer::regionObjects(const Map<NodeID, Set<NodeID>> &graph, size_t numObjects, size_t &numLabels)
 {
     unsigned label = UINT_MAX;
@@ -594,9 +671,8 @@ void NodeIDAllocator::Clusterer::evaluate(const std::vector<NodeID> &nodeMap, co
 
         // Check number of words for original SBV.
         Set<unsigned> words;
-        // TODO: nasty hardcoding.
-        for (const NodeID o : pts) words.insert(o / 128);
-        u64_t originalSbv = words.size() * 2;
+        for (const NodeID o : pts) words.insert(o / SparseBitVectorElement<>::BITS_PER_ELEMENT);
+        u64_t originalSbv = words.size() * SparseBitVectorElement<>::BITWORDS_PER_ELEMENT;
         if (accountForOcc) originalSbv *= occ;
 
         // Check number of words for original BV.
@@ -617,9 +693,8 @@ void NodeIDAllocator::Clusterer::evaluate(const std::vector<NodeID> &nodeMap, co
 
         // Check number of words for new SBV.
         words.clear();
-        // TODO: nasty hardcoding.
-        for (const NodeID o : pts) words.insert(nodeMap[o] / 128);
-        u64_t newSbv = words.size() * 2;
+        for (const NodeID o : pts) words.insert(nodeMap[o] / SparseBitVectorElement<>::BITS_PER_ELEMENT);
+        u64_t newSbv = words.size() * SparseBitVectorElement<>::BITWORDS_PER_ELEMENT;
         if (accountForOcc) newSbv *= occ;
 
         // Check number of words for new BV.
@@ -661,7 +736,9 @@ std::pair<hclust_fast_methods, std::vector<NodeID>> NodeIDAllocator::Clusterer::
     std::pair<hclust_fast_methods, std::vector<NodeID>> bestMapping = candidates[0];
     // Number of bits required for the best candidate.
     size_t bestWords = std::numeric_limits<size_t>::max();
-    if (evalSubtitle != "" || (enum hclust_fast_methods)Options::ClusterMethod() == HCLUST_METHOD_SVF_BEST)
+    // Approximate mappings are always evaluated so that their quality can be told.
+    if (evalSubtitle != "" || (enum hclust_fast_methods)Options::ClusterMethod() == HCLUST_METHOD_SVF_BEST
+            || (enum hclust_fast_methods)Options::ClusterMethod() == HCLUST_METHOD_SVF_MINHASH)
     {
         for (const std::pair<hclust_fast_methods, std::vector<NodeID>> &candidate : candidates)
         {
@@ -702,7 +779,7 @@ void NodeIDAllocator::Clusterer::printStats(std::string subtitle, Map<std::strin
         NewSbvNumWords, NewBvNumWords, NumRegions, NumGtIntRegions,
         NumNonTrivialRegionObjects, LargestRegion, RegioningTime,
         DistanceMatrixTime, FastClusterTime, DendrogramTraversalTime,
-        EvalTime, TotalTime, BestCandidate
+        MinHashTime, EvalTime, TotalTime, BestCandidate
     };
 
     const unsigned fieldWidth = 20;
@@ -6,6 +6,7 @@
 #include "Util/ExtAPI.h"
 #include "MSSA/MemSSA.h"
 #include "WPA/WPAPass.h"
+#include "WPA/Andersen.h"
 #include "AE/Svfexe/AbstractInterpretation.h"
 
 namespace SVF
@@ -51,6 +52,7 @@ const OptionMap<BVDataPTAImpl::PTBackingType> Options::ptDataBacking(
 {
     {BVDataPTAImpl::PTBackingType::Mutable, "mutable", "points-to set per pointer"},
     {BVDataPTAImpl::PTBackingType::Persistent, "persistent", "points-to set ID per pointer, operations hash-consed"},
+    {BVDataPTAImpl::PTBackingType::Hybrid, "hybrid", "persistent, with unused points-to sets reference counted and collected"},
 }
 );
 
@@ -66,6 +68,77 @@ const Option<u32_t> Options::VersioningThreads(
     1
 );
 
+const Option<u32_t> Options::AnderThreads(
+    "ander-threads",
+    "number of threads to use in the copy/gep propagation phase of wave propagation (requires -ptd=mutable)",
+    1
+);
+
+const Option<u32_t> Options::FsThreads(
+    "fs-threads",
+    "number of threads to use in sparse flow-sensitive solving (requires -ptd=mutable)",
+    1
+);
+
+const Option<bool> Options::FsThreadsCheck(
+    "fs-threads-check",
+    "Check that the points-to sets solved with -fs-threads equal those solved serially",
+    false
+);
+
+const Option<u32_t> Options::AliasCacheSize(
+    "alias-cache-size",
+    "maximum number of cached results of batched alias queries (0 to disable)",
+    65536
+);
+
+/// Worklist orders of the -ander-worklist, -fs-worklist and -vfs-worklist options
+static const OptionMap<PolicyWorkList::Policy>::OptionPossibilities WorklistPolicies =
+{
+    {PolicyWorkList::FIFO, "fifo", "first in first out"},
+    {PolicyWorkList::LRF, "lrf", "least recently fired node first"},
+    {PolicyWorkList::Topo, "topo", "lowest topological rank first"},
+    {PolicyWorkList::TwoPhase, "two-phase", "nodes pushed during a phase deferred to the next, phases in topological order"},
+};
+
+const OptionMap<PolicyWorkList::Policy> Options::AnderWorklist(
+    "ander-worklist",
+    "Order in which the Andersen's solvers process their worklist",
+    PolicyWorkList::FIFO,
+    WorklistPolicies
+);
+
+const OptionMap<PolicyWorkList::Policy> Options::FsWorklist(
+    "fs-worklist",
+    "Order in which the flow-sensitive solver processes its worklist",
+    PolicyWorkList::FIFO,
+    WorklistPolicies
+);
+
+const OptionMap<PolicyWorkList::Policy> Options::VfsWorklist(
+    "vfs-worklist",
+    "Order in which the versioned flow-sensitive solver processes its worklist",
+    PolicyWorkList::FIFO,
+    WorklistPolicies
+);
+
+const OptionMap<u32_t> Options::AnderVarSubst(
+    "ander-var-subst",
+    "Offline variable substitution merging pointer-equivalent nodes before Andersen's solving",
+    AndersenBase::NoVarSubst,
+{
+    {AndersenBase::NoVarSubst, "none", "solve the constraint graph as built"},
+    {AndersenBase::HVNSubst, "hvn", "hash-based value numbering"},
+    {AndersenBase::HUSubst, "hu", "hash-based value numbering with unions of points-to labels (more precise)"},
+}
+);
+
+const Option<bool> Options::AnderVarSubstCheck(
+    "ander-var-subst-check",
+    "Check that the points-to sets with -ander-var-subst equal those solved without it",
+    false
+);
+
 const Option<u32_t> Options::AnderTimeLimit(
     "ander-time-limit",
     "time limit for Andersen's analyses (ignored when -fs-time-limit set)",
@@ -79,6 +152,20 @@ const Option<u32_t> Options::CxtBudget(
     10000
 );
 
+// DDAClient.cpp
+const Option<bool> Options::DDABatch(
+    "dda-batch",
+    "Answer DDA queries in topological order of their definitions on the SVFG",
+    false
+);
+
+// DDAVFSolver.h
+const Option<u32_t> Options::DDACacheSize(
+    "dda-cache-size",
+    "Maximum number of points-to sets cached across DDA queries (0 for no limit)",
+    0
+);
+
 // DDAPass.cpp
 const Option<u32_t> Options::MaxPathLen(
     "max-path",
@@ -201,6 +288,12 @@ const Option<bool> Options::DumpVFG(
     false
 );
 
+const Option<bool> Options::CompactGraphs(
+    "compact-graphs",
+    "Freeze the SVFG/ICFG into compact (CSR) edge arrays while they are only traversed (flow-sensitive solving, SABER, WTO construction)",
+    false
+);
+
 
 // Base class of pointer analyses (PointerAnalysis.cpp)
 const Option<bool> Options::TypePrint(
@@ -357,6 +450,7 @@ const OptionMap<PointsTo::Type> Options::PtType(
     {PointsTo::Type::SBV, "sbv", "sparse bit-vector"},
     {PointsTo::Type::CBV, "cbv", "core bit-vector (dynamic bit-vector without leading and trailing 0s)"},
     {PointsTo::Type::BV, "bv", "bit-vector (dynamic bit-vector without trailing 0s)"},
+    {PointsTo::Type::RBV, "rbv", "roaring bit-vector (array, bitmap, or run container per 2^16 chunk)"},
 }
 );
 
@@ -369,9 +463,16 @@ const OptionMap<u32_t> Options::ClusterMethod(
     {HCLUST_METHOD_COMPLETE, "complete", "complete linkage; nearest-neighbour-chain algorithm"},
     {HCLUST_METHOD_AVERAGE,   "average", "unweighted average linkage; nearest-neighbour-chain algorithm"},
     {HCLUST_METHOD_SVF_BEST,     "best", "try all linkage criteria; choose best"},
+    {HCLUST_METHOD_SVF_MINHASH, "minhash", "approximate; order objects by MinHash signatures of their points-to sets, no distance matrix"},
 }
 );
 
+const Option<u32_t> Options::ClusterMinHashes(
+    "cluster-minhashes",
+    "number of hash functions in the MinHash signatures of -cluster-method=minhash",
+    16
+);
+
 const Option<bool> Options::RegionedClustering(
     // Use cluster to "gather" the options closer together, even if it sounds a little worse.
     "cluster-regioned",
@@ -637,10 +738,16 @@ const Option<std::string> Options::WriteAnder(
 
 const Option<std::string> Options::ReadAnder(
     "read-ander",
-    "Read Andersen's analysis results from a text file",
+    "Read Andersen's analysis results from a text or binary file",
     ""
 );
 
+const Option<bool> Options::WriteAnderBinary(
+    "write-ander-binary",
+    "Write -write-ander results in the memory-mappable binary format",
+    false
+);
+
 const Option<bool> Options::DiffPts(
     "diff",
     "Enable differential point-to set",
@@ -691,6 +798,8 @@ OptionMultiple<PointerAnalysis::PTATY> Options::PASelected(
     {PointerAnalysis::Andersen_WPA, "nander", "Standard inclusion-based analysis"},
     {PointerAnalysis::AndersenSCD_WPA, "sander", "Selective cycle detection inclusion-based analysis"},
     {PointerAnalysis::AndersenSFR_WPA, "sfrander", "Stride-based field representation inclusion-based analysis"},
+    {PointerAnalysis::AndersenLCD_WPA, "lander", "Lazy cycle detection inclusion-based analysis"},
+    {PointerAnalysis::AndersenHCD_WPA, "hander", "Hybrid cycle detection inclusion-based analysis"},
     {PointerAnalysis::AndersenWaveDiff_WPA, "ander", "Diff wave propagation inclusion-based analysis"},
     {PointerAnalysis::Steensgaard_WPA, "steens", "Steensgaard's pointer analysis"},
     // Disabled till further work is done.
@@ -802,9 +911,12 @@ const OptionMap<u32_t> Options::HandleRecur(
     }
 }
 );
-// TODO: to implement
-// const Option<bool> Options::UseSparseState(
-//     "use-sparse", "Use sparse abstract state representation (experimental)", false);
+const Option<u32_t> Options::AESummaryLimit(
+    "ae-summary-limit","Maximum number of arguments and reachable memory objects a callee summary is keyed on (0 disables callee summaries)",0);
+const Option<bool> Options::UseSparseState(
+    "use-sparse", "Use sparse abstract state representation: values of single-definition top-level variables are kept at their definitions (disables callee summaries)", false);
+const Option<bool> Options::AEEvictStates(
+    "ae-evict-states", "Drop the abstract state of a node (other than call sites and loop heads) once every node reading it has been handled", false);
 const Option<u32_t> Options::Timeout(
     "timeout", "time out (seconds), set -1 (no timeout), default 14400s",14400);
 const Option<std::string> Options::OutputName(
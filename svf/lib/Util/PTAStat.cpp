@@ -70,6 +70,12 @@ void PTAStat::performStat()
     }
     PTNumStatMap["LocalVarInRecur"] = localVarInRecursion.count();
 
+    if (const BVDataPTAImpl* bvpta = SVFUtil::dyn_cast<BVDataPTAImpl>(pta))
+    {
+        PTNumStatMap["Unions"] = bvpta->getNumOfUnions();
+        PTNumStatMap["ChangedUnions"] = bvpta->getNumOfChangedUnions();
+    }
+
     u32_t vmrss = 0;
     u32_t vmsize = 0;
     SVFUtil::getMemoryUsageKB(&vmrss, &vmsize);
@@ -0,0 +1,696 @@
+//===- RoaringBitVector.cpp -- Compressed bitmap data structure ------------//
+
+/*
+ * RoaringBitVector.cpp
+ *
+ * Compressed bitmap made up of array, bitmap, and run containers, each
+ * holding a 2^16 chunk of the universe (implementation).
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits.h>
+
+#include "Util/SparseBitVector.h"  // For LLVM's countPopulation.
+#include "Util/RoaringBitVector.h"
+#include "Util/SVFUtil.h"
+
+namespace SVF
+{
+
+static const u32_t WordBits = sizeof(RoaringBitVector::Word) * CHAR_BIT;
+
+/// Sets bits [start, last] of words.
+static void setRange(RoaringBitVector::Word *words, u32_t start, u32_t last)
+{
+    typedef RoaringBitVector::Word Word;
+    const u32_t firstWord = start / WordBits;
+    const u32_t lastWord = last / WordBits;
+    const Word firstMask = ~(Word)0 << (start % WordBits);
+    const Word lastMask = ~(Word)0 >> (WordBits - 1 - last % WordBits);
+    if (firstWord == lastWord)
+    {
+        words[firstWord] |= firstMask & lastMask;
+        return;
+    }
+
+    words[firstWord] |= firstMask;
+    for (u32_t w = firstWord + 1; w < lastWord; ++w) words[w] = ~(Word)0;
+    words[lastWord] |= lastMask;
+}
+
+u32_t RoaringBitVector::count(void) const
+{
+    u32_t n = 0;
+    for (const Container &c : containers) n += c.card;
+    return n;
+}
+
+void RoaringBitVector::clear(void)
+{
+    containers.clear();
+    containers.shrink_to_fit();
+}
+
+size_t RoaringBitVector::findContainer(u16_t key) const
+{
+    // Few containers in practice (2^16 elements each): binary search is plenty.
+    size_t lo = 0, hi = containers.size();
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (containers[mid].key < key) lo = mid + 1;
+        else hi = mid;
+    }
+
+    return lo;
+}
+
+bool RoaringBitVector::test(u32_t bit) const
+{
+    size_t i = findContainer(highBits(bit));
+    if (i == containers.size() || containers[i].key != highBits(bit)) return false;
+    return containerTest(containers[i], lowBits(bit));
+}
+
+bool RoaringBitVector::test_and_set(u32_t bit)
+{
+    // TODO: can be faster.
+    if (test(bit)) return false;
+    set(bit);
+    return true;
+}
+
+void RoaringBitVector::set(u32_t bit)
+{
+    const u16_t key = highBits(bit);
+    const u16_t low = lowBits(bit);
+    size_t i = findContainer(key);
+    if (i == containers.size() || containers[i].key != key)
+    {
+        Container c(key);
+        c.vals.push_back(low);
+        c.card = 1;
+        containers.insert(containers.begin() + i, std::move(c));
+        return;
+    }
+
+    Container &c = containers[i];
+    if (c.kind == Container::RunContainer)
+    {
+        if (containerTest(c, low)) return;
+        unpackRuns(c);
+    }
+
+    if (c.kind == Container::ArrayContainer)
+    {
+        std::vector<u16_t>::iterator it = std::lower_bound(c.vals.begin(), c.vals.end(), low);
+        if (it != c.vals.end() && *it == low) return;
+        c.vals.insert(it, low);
+        ++c.card;
+        if (c.card > MaxArraySize)
+        {
+            Word words[BitmapWords];
+            toBitmap(c, words);
+            fromBitmap(c, words, false);
+        }
+    }
+    else
+    {
+        Word &w = c.bits[low / WordBits];
+        const Word mask = (Word)1 << (low % WordBits);
+        if (!(w & mask)) ++c.card;
+        w |= mask;
+    }
+}
+
+void RoaringBitVector::reset(u32_t bit)
+{
+    const u16_t key = highBits(bit);
+    const u16_t low = lowBits(bit);
+    size_t i = findContainer(key);
+    if (i == containers.size() || containers[i].key != key) return;
+
+    Container &c = containers[i];
+    if (!containerTest(c, low)) return;
+    if (c.kind == Container::RunContainer) unpackRuns(c);
+
+    if (c.kind == Container::ArrayContainer)
+    {
+        c.vals.erase(std::lower_bound(c.vals.begin(), c.vals.end(), low));
+    }
+    else
+    {
+        // Shrinking bitmaps are left as is: they are rebuilt by the next set operation.
+        c.bits[low / WordBits] &= ~((Word)1 << (low % WordBits));
+    }
+
+    if (--c.card == 0) containers.erase(containers.begin() + i);
+}
+
+bool RoaringBitVector::contains(const RoaringBitVector &rhs) const
+{
+    size_t i = 0;
+    for (const Container &rc : rhs.containers)
+    {
+        while (i < containers.size() && containers[i].key < rc.key) ++i;
+        if (i == containers.size() || containers[i].key != rc.key) return false;
+
+        const Container &c = containers[i];
+        if (c.card < rc.card) return false;
+        // rc is a subset of c iff rc - c is empty.
+        Container diff(rc);
+        containerOp(diff, c, DifferenceOp);
+        if (diff.card != 0) return false;
+    }
+
+    return true;
+}
+
+bool RoaringBitVector::intersects(const RoaringBitVector &rhs) const
+{
+    size_t i = 0, j = 0;
+    while (i < containers.size() && j < rhs.containers.size())
+    {
+        if (containers[i].key < rhs.containers[j].key) ++i;
+        else if (containers[i].key > rhs.containers[j].key) ++j;
+        else
+        {
+            if (containerIntersects(containers[i], rhs.containers[j])) return true;
+            ++i;
+            ++j;
+        }
+    }
+
+    return false;
+}
+
+bool RoaringBitVector::operator==(const RoaringBitVector &rhs) const
+{
+    if (this == &rhs) return true;
+    if (containers.size() != rhs.containers.size()) return false;
+
+    for (size_t i = 0; i < containers.size(); ++i)
+    {
+        const Container &lc = containers[i];
+        const Container &rc = rhs.containers[i];
+        if (lc.key != rc.key || lc.card != rc.card) return false;
+        if (!containerEquals(lc, rc)) return false;
+    }
+
+    return true;
+}
+
+bool RoaringBitVector::operator|=(const RoaringBitVector &rhs)
+{
+    if (this == &rhs || rhs.empty()) return false;
+    if (empty())
+    {
+        *this = rhs;
+        return true;
+    }
+
+    bool changed = false;
+    std::vector<Container> merged;
+    merged.reserve(containers.size() + rhs.containers.size());
+    size_t i = 0, j = 0;
+    while (i < containers.size() || j < rhs.containers.size())
+    {
+        if (j == rhs.containers.size() || (i < containers.size() && containers[i].key < rhs.containers[j].key))
+        {
+            merged.push_back(std::move(containers[i++]));
+        }
+        else if (i == containers.size() || containers[i].key > rhs.containers[j].key)
+        {
+            merged.push_back(rhs.containers[j++]);
+            changed = true;
+        }
+        else
+        {
+            if (containerOp(containers[i], rhs.containers[j], UnionOp)) changed = true;
+            merged.push_back(std::move(containers[i++]));
+            ++j;
+        }
+    }
+
+    containers = std::move(merged);
+    return changed;
+}
+
+bool RoaringBitVector::operator&=(const RoaringBitVector &rhs)
+{
+    if (this == &rhs) return false;
+
+    bool changed = false;
+    size_t kept = 0;
+    size_t j = 0;
+    for (size_t i = 0; i < containers.size(); ++i)
+    {
+        Container &c = containers[i];
+        while (j < rhs.containers.size() && rhs.containers[j].key < c.key) ++j;
+        if (j == rhs.containers.size() || rhs.containers[j].key != c.key)
+        {
+            // Nothing in rhs's chunk: c goes.
+            changed = true;
+            continue;
+        }
+
+        if (containerOp(c, rhs.containers[j], IntersectOp)) changed = true;
+        if (c.card == 0) continue;
+        if (kept != i) containers[kept] = std::move(c);
+        ++kept;
+    }
+
+    containers.erase(containers.begin() + kept, containers.end());
+    return changed;
+}
+
+bool RoaringBitVector::intersectWithComplement(const RoaringBitVector &rhs)
+{
+    if (this == &rhs)
+    {
+        bool changed = !empty();
+        clear();
+        return changed;
+    }
+
+    bool changed = false;
+    size_t kept = 0;
+    size_t j = 0;
+    for (size_t i = 0; i < containers.size(); ++i)
+    {
+        Container &c = containers[i];
+        while (j < rhs.containers.size() && rhs.containers[j].key < c.key) ++j;
+        if (j < rhs.containers.size() && rhs.containers[j].key == c.key)
+        {
+            if (containerOp(c, rhs.containers[j], DifferenceOp)) changed = true;
+            if (c.card == 0) continue;
+        }
+
+        if (kept != i) containers[kept] = std::move(c);
+        ++kept;
+    }
+
+    containers.erase(containers.begin() + kept, containers.end());
+    return changed;
+}
+
+void RoaringBitVector::intersectWithComplement(const RoaringBitVector &lhs, const RoaringBitVector &rhs)
+{
+    // Built aside as this may be lhs or rhs.
+    std::vector<Container> result;
+    result.reserve(lhs.containers.size());
+    size_t j = 0;
+    for (const Container &c : lhs.containers)
+    {
+        while (j < rhs.containers.size() && rhs.containers[j].key < c.key) ++j;
+        const Container *rc = j < rhs.containers.size() && rhs.containers[j].key == c.key
+                              ? &rhs.containers[j] : nullptr;
+        // Containers which rhs empties are not copied.
+        if (rc && (rc->card == (1u << ChunkBits) || containerEquals(c, *rc))) continue;
+
+        result.push_back(c);
+        if (rc)
+        {
+            containerOp(result.back(), *rc, DifferenceOp);
+            if (result.back().card == 0) result.pop_back();
+        }
+    }
+
+    containers = std::move(result);
+}
+
+size_t RoaringBitVector::hash(void) const
+{
+    // Must not depend on the containers picked as equal sets can be stored
+    // differently, so only use the cardinality, first, and last element of each chunk.
+    size_t h = containers.size();
+    for (const Container &c : containers)
+    {
+        u32_t first, last;
+        if (c.kind == Container::BitmapContainer)
+        {
+            size_t fw = 0, lw = BitmapWords - 1;
+            while (c.bits[fw] == 0) ++fw;
+            while (c.bits[lw] == 0) --lw;
+            first = fw * WordBits + countTrailingZeros(c.bits[fw]);
+            last = lw * WordBits + (WordBits - 1 - countLeadingZeros(c.bits[lw]));
+        }
+        else
+        {
+            first = c.vals.front();
+            last = c.vals.back();
+        }
+
+        const size_t chunk = ((size_t)c.key << 48) ^ ((size_t)c.card << 32) ^ (first << 16) ^ last;
+        h ^= chunk + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+
+    return h;
+}
+
+size_t RoaringBitVector::getMemoryUsage(void) const
+{
+    size_t bytes = containers.capacity() * sizeof(Container);
+    for (const Container &c : containers)
+        bytes += c.vals.capacity() * sizeof(u16_t) + c.bits.capacity() * sizeof(Word);
+    return bytes;
+}
+
+RoaringBitVector::const_iterator RoaringBitVector::begin(void) const
+{
+    return RoaringBitVectorIterator(this);
+}
+
+RoaringBitVector::const_iterator RoaringBitVector::end(void) const
+{
+    return RoaringBitVectorIterator(this, true);
+}
+
+bool RoaringBitVector::containerTest(const Container &c, u16_t low)
+{
+    if (c.kind == Container::ArrayContainer)
+    {
+        return std::binary_search(c.vals.begin(), c.vals.end(), low);
+    }
+    else if (c.kind == Container::BitmapContainer)
+    {
+        return c.bits[low / WordBits] & ((Word)1 << (low % WordBits));
+    }
+
+    // Runs: find the last run starting at or before low.
+    size_t lo = 0, hi = c.vals.size() / 2;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (c.vals[2 * mid] <= low) lo = mid + 1;
+        else hi = mid;
+    }
+
+    return lo != 0 && low <= c.vals[2 * (lo - 1) + 1];
+}
+
+void RoaringBitVector::toBitmap(const Container &c, Word *words)
+{
+    if (c.kind == Container::BitmapContainer)
+    {
+        std::memcpy(words, c.bits.data(), BitmapWords * sizeof(Word));
+        return;
+    }
+
+    std::memset(words, 0, BitmapWords * sizeof(Word));
+    if (c.kind == Container::ArrayContainer)
+    {
+        for (u16_t v : c.vals) words[v / WordBits] |= (Word)1 << (v % WordBits);
+    }
+    else
+    {
+        for (size_t r = 0; r < c.vals.size(); r += 2) setRange(words, c.vals[r], c.vals[r + 1]);
+    }
+}
+
+bool RoaringBitVector::fromBitmap(Container &c, const Word *words, bool allowRuns)
+{
+    // Cardinality and number of runs (bits set whose predecessor is not set).
+    u32_t card = 0;
+    u32_t numRuns = 0;
+    Word carry = 0;
+    for (u32_t w = 0; w < BitmapWords; ++w)
+    {
+        card += countPopulation(words[w]);
+        numRuns += countPopulation(words[w] & ~((words[w] << 1) | carry));
+        carry = words[w] >> (WordBits - 1);
+    }
+
+    c.card = card;
+    c.vals.clear();
+    c.bits.clear();
+    if (card == 0)
+    {
+        c.kind = Container::ArrayContainer;
+        return false;
+    }
+
+    const size_t arrayBytes = card * sizeof(u16_t);
+    const size_t bitmapBytes = BitmapWords * sizeof(Word);
+    const size_t runBytes = 2 * numRuns * sizeof(u16_t);
+    if (allowRuns && runBytes < std::min(arrayBytes, bitmapBytes))
+    {
+        c.kind = Container::RunContainer;
+        c.vals.reserve(2 * numRuns);
+        u32_t start = 0;
+        bool inRun = false;
+        for (u32_t w = 0; w < BitmapWords; ++w)
+        {
+            const Word word = words[w];
+            // Skip the words which can neither start nor end a run.
+            if ((word == 0 && !inRun) || (word == ~(Word)0 && inRun)) continue;
+            for (u32_t b = 0; b < WordBits; ++b)
+            {
+                const bool isSet = word & ((Word)1 << b);
+                if (isSet && !inRun) start = w * WordBits + b;
+                else if (!isSet && inRun)
+                {
+                    c.vals.push_back(start);
+                    c.vals.push_back(w * WordBits + b - 1);
+                }
+                inRun = isSet;
+            }
+        }
+
+        if (inRun)
+        {
+            c.vals.push_back(start);
+            c.vals.push_back((1u << ChunkBits) - 1);
+        }
+    }
+    else if (card <= MaxArraySize)
+    {
+        c.kind = Container::ArrayContainer;
+        c.vals.reserve(card);
+        for (u32_t w = 0; w < BitmapWords; ++w)
+        {
+            for (Word word = words[w]; word != 0; word &= word - 1)
+                c.vals.push_back(w * WordBits + countTrailingZeros(word));
+        }
+    }
+    else
+    {
+        c.kind = Container::BitmapContainer;
+        c.bits.assign(words, words + BitmapWords);
+    }
+
+    return true;
+}
+
+void RoaringBitVector::unpackRuns(Container &c)
+{
+    assert(c.kind == Container::RunContainer && "RBV::unpackRuns: not a run container!");
+    Word words[BitmapWords];
+    toBitmap(c, words);
+    fromBitmap(c, words, false);
+}
+
+bool RoaringBitVector::containerOp(Container &c, const Container &rhs, SetOp op)
+{
+    if (c.kind == Container::ArrayContainer && rhs.kind == Container::ArrayContainer && op == UnionOp)
+    {
+        std::vector<u16_t> merged;
+        merged.reserve(c.vals.size() + rhs.vals.size());
+        std::set_union(c.vals.begin(), c.vals.end(), rhs.vals.begin(), rhs.vals.end(), std::back_inserter(merged));
+        if (merged.size() == c.vals.size()) return false;
+
+        if (merged.size() <= MaxArraySize)
+        {
+            c.vals = std::move(merged);
+            c.card = c.vals.size();
+        }
+        else
+        {
+            Word words[BitmapWords];
+            std::memset(words, 0, sizeof(words));
+            for (u16_t v : merged) words[v / WordBits] |= (Word)1 << (v % WordBits);
+            fromBitmap(c, words);
+        }
+
+        return true;
+    }
+
+    if (c.kind == Container::ArrayContainer && op != UnionOp)
+    {
+        // Filtering a (small) array is cheaper than going through bitmaps.
+        const bool keepIfInRhs = op == IntersectOp;
+        size_t kept = 0;
+        for (u16_t v : c.vals)
+        {
+            if (containerTest(rhs, v) == keepIfInRhs) c.vals[kept++] = v;
+        }
+
+        if (kept == c.vals.size()) return false;
+        c.vals.resize(kept);
+        c.card = kept;
+        return true;
+    }
+
+    // General case: word-wise on the bitmaps of both containers.
+    Word lhsWords[BitmapWords], rhsWords[BitmapWords];
+    const Word *lhsBits = lhsWords;
+    const Word *rhsBits = rhsWords;
+    if (c.kind == Container::BitmapContainer) lhsBits = c.bits.data();
+    else toBitmap(c, lhsWords);
+    if (rhs.kind == Container::BitmapContainer) rhsBits = rhs.bits.data();
+    else toBitmap(rhs, rhsWords);
+
+    Word result[BitmapWords];
+    Word changed = 0;
+    if (op == UnionOp)
+    {
+        for (u32_t w = 0; w < BitmapWords; ++w)
+        {
+            result[w] = lhsBits[w] | rhsBits[w];
+            changed |= result[w] ^ lhsBits[w];
+        }
+    }
+    else if (op == IntersectOp)
+    {
+        for (u32_t w = 0; w < BitmapWords; ++w)
+        {
+            result[w] = lhsBits[w] & rhsBits[w];
+            changed |= result[w] ^ lhsBits[w];
+        }
+    }
+    else
+    {
+        for (u32_t w = 0; w < BitmapWords; ++w)
+        {
+            result[w] = lhsBits[w] & ~rhsBits[w];
+            changed |= result[w] ^ lhsBits[w];
+        }
+    }
+
+    if (!changed) return false;
+    fromBitmap(c, result);
+    return true;
+}
+
+bool RoaringBitVector::containerIntersects(const Container &lhs, const Container &rhs)
+{
+    if (lhs.kind == Container::ArrayContainer || rhs.kind == Container::ArrayContainer)
+    {
+        const Container &array = lhs.kind == Container::ArrayContainer ? lhs : rhs;
+        const Container &other = lhs.kind == Container::ArrayContainer ? rhs : lhs;
+        for (u16_t v : array.vals)
+        {
+            if (containerTest(other, v)) return true;
+        }
+
+        return false;
+    }
+
+    Word lhsWords[BitmapWords], rhsWords[BitmapWords];
+    const Word *lhsBits = lhsWords;
+    const Word *rhsBits = rhsWords;
+    if (lhs.kind == Container::BitmapContainer) lhsBits = lhs.bits.data();
+    else toBitmap(lhs, lhsWords);
+    if (rhs.kind == Container::BitmapContainer) rhsBits = rhs.bits.data();
+    else toBitmap(rhs, rhsWords);
+
+    Word common = 0;
+    for (u32_t w = 0; w < BitmapWords; ++w) common |= lhsBits[w] & rhsBits[w];
+    return common != 0;
+}
+
+bool RoaringBitVector::containerEquals(const Container &lhs, const Container &rhs)
+{
+    if (lhs.kind == rhs.kind)
+    {
+        // Runs are maximal, so equal run containers are identical too.
+        if (lhs.kind == Container::BitmapContainer) return lhs.bits == rhs.bits;
+        return lhs.vals == rhs.vals;
+    }
+
+    Word lhsWords[BitmapWords], rhsWords[BitmapWords];
+    toBitmap(lhs, lhsWords);
+    toBitmap(rhs, rhsWords);
+    return std::memcmp(lhsWords, rhsWords, sizeof(lhsWords)) == 0;
+}
+
+RoaringBitVector::RoaringBitVectorIterator::RoaringBitVectorIterator(const RoaringBitVector *rbv, bool end)
+    : rbv(rbv), containerIdx(end ? rbv->containers.size() : 0), pos(0), low(0)
+{
+    if (!end) enterContainer();
+}
+
+void RoaringBitVector::RoaringBitVectorIterator::enterContainer(void)
+{
+    pos = 0;
+    low = 0;
+    if (atEnd()) return;
+
+    const Container &c = rbv->containers[containerIdx];
+    if (c.kind == Container::BitmapContainer)
+    {
+        // Containers are never empty.
+        u32_t w = 0;
+        while (c.bits[w] == 0) ++w;
+        low = w * WordBits + countTrailingZeros(c.bits[w]);
+    }
+    else low = c.vals[0];
+}
+
+const RoaringBitVector::RoaringBitVectorIterator &RoaringBitVector::RoaringBitVectorIterator::operator++(void)
+{
+    assert(!atEnd() && "RoaringBitVectorIterator::++(pre): incrementing past end!");
+
+    const Container &c = rbv->containers[containerIdx];
+    if (c.kind == Container::ArrayContainer)
+    {
+        if (++pos < c.vals.size())
+        {
+            low = c.vals[pos];
+            return *this;
+        }
+    }
+    else if (c.kind == Container::RunContainer)
+    {
+        if (low < c.vals[2 * pos + 1])
+        {
+            ++low;
+            return *this;
+        }
+
+        if (2 * (++pos) < c.vals.size())
+        {
+            low = c.vals[2 * pos];
+            return *this;
+        }
+    }
+    else if (low + 1 < (1u << ChunkBits))
+    {
+        u32_t w = (low + 1) / WordBits;
+        // Mask out the bits up to and including low.
+        Word word = c.bits[w] & (~(Word)0 << ((low + 1) % WordBits));
+        while (word == 0 && ++w < BitmapWords) word = c.bits[w];
+        if (word != 0)
+        {
+            low = w * WordBits + countTrailingZeros(word);
+            return *this;
+        }
+    }
+
+    ++containerIdx;
+    enterContainer();
+    return *this;
+}
+
+const RoaringBitVector::RoaringBitVectorIterator RoaringBitVector::RoaringBitVectorIterator::operator++(int)
+{
+    assert(!atEnd() && "RoaringBitVectorIterator::++(post): incrementing past end!");
+    RoaringBitVectorIterator old = *this;
+    ++*this;
+    return old;
+}
+
+};  // namespace SVF
@@ -0,0 +1,147 @@
+//===- ThreadPool.cpp -- Work-stealing pool of worker threads ------------------//
+
+/*
+ * ThreadPool.cpp
+ *
+ * A fixed-size pool of worker threads executing index ranges with work stealing (implementation).
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <assert.h>
+
+#include "Util/ThreadPool.h"
+
+using namespace SVF;
+
+ThreadPool::ThreadPool(u32_t n)
+    : numThreads(n == 0 ? 1 : n), ranges(new WorkRange[n == 0 ? 1 : n]),
+      currentBody(nullptr), generation(0), pending(0), stop(false)
+{
+    for (u32_t w = 1; w < numThreads; ++w)
+        threads.emplace_back(&ThreadPool::threadLoop, this, w);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(poolMutex);
+        stop = true;
+    }
+    wakeCV.notify_all();
+    for (std::thread& t : threads) t.join();
+}
+
+void ThreadPool::parallelFor(u32_t n, const LoopBody& body)
+{
+    if (n == 0) return;
+
+    // Nothing to share: avoid waking the background threads.
+    if (numThreads == 1 || n == 1)
+    {
+        for (u32_t i = 0; i < n; ++i) body(i, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(poolMutex);
+        for (u32_t w = 0; w < numThreads; ++w)
+        {
+            std::lock_guard<std::mutex> rangeGuard(ranges[w].lock);
+            ranges[w].begin = (u32_t)((u64_t)n * w / numThreads);
+            ranges[w].end = (u32_t)((u64_t)n * (w + 1) / numThreads);
+        }
+        currentBody = &body;
+        pending = numThreads - 1;
+        ++generation;
+    }
+    wakeCV.notify_all();
+
+    runWorker(0);
+
+    std::unique_lock<std::mutex> lock(poolMutex);
+    doneCV.wait(lock, [this] { return pending == 0; });
+    currentBody = nullptr;
+}
+
+void ThreadPool::runWorker(u32_t worker)
+{
+    const LoopBody& body = *currentBody;
+    u32_t idx;
+    while (popOwn(worker, idx) || steal(worker, idx))
+        body(idx, worker);
+}
+
+bool ThreadPool::popOwn(u32_t worker, u32_t& idx)
+{
+    WorkRange& own = ranges[worker];
+    std::lock_guard<std::mutex> guard(own.lock);
+    if (own.begin >= own.end) return false;
+    idx = own.begin++;
+    return true;
+}
+
+bool ThreadPool::steal(u32_t worker, u32_t& idx)
+{
+    // Ranges only ever shrink (apart from a thief refilling its own, empty, range),
+    // so once every range has been seen empty there is no work left in this loop.
+    while (true)
+    {
+        u32_t victim = numThreads;
+        u32_t victimSize = 0;
+        for (u32_t w = 0; w < numThreads; ++w)
+        {
+            if (w == worker) continue;
+            std::lock_guard<std::mutex> guard(ranges[w].lock);
+            u32_t size = ranges[w].end - ranges[w].begin;
+            if (ranges[w].begin < ranges[w].end && size > victimSize)
+            {
+                victim = w;
+                victimSize = size;
+            }
+        }
+
+        if (victim == numThreads) return false;
+
+        u32_t stolenBegin, stolenEnd;
+        {
+            WorkRange& vr = ranges[victim];
+            std::lock_guard<std::mutex> guard(vr.lock);
+            // The victim may have made progress since we looked.
+            if (vr.begin >= vr.end) continue;
+            u32_t mid = vr.begin + (vr.end - vr.begin) / 2;
+            stolenBegin = mid;
+            stolenEnd = vr.end;
+            vr.end = mid;
+        }
+
+        assert(stolenBegin < stolenEnd && "ThreadPool::steal: stole an empty range?");
+        WorkRange& own = ranges[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        idx = stolenBegin;
+        own.begin = stolenBegin + 1;
+        own.end = stolenEnd;
+        return true;
+    }
+}
+
+void ThreadPool::threadLoop(u32_t worker)
+{
+    u64_t seenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            wakeCV.wait(lock, [this, seenGeneration] { return stop || generation != seenGeneration; });
+            if (stop) return;
+            seenGeneration = generation;
+        }
+
+        runWorker(worker);
+
+        {
+            std::lock_guard<std::mutex> guard(poolMutex);
+            if (--pending == 0) doneCV.notify_one();
+        }
+    }
+}
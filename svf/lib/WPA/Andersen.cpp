@@ -38,6 +38,21 @@ using namespace SVF;
 using namespace SVFUtil;
 using namespace std;
 
+namespace
+{
+/// Hash of a set of offline pointer-equivalence labels
+struct LabelSetHash
+{
+    size_t operator()(const NodeBS& labels) const
+    {
+        size_t h = labels.count();
+        for (u32_t l : labels)
+            h = h * 31 + l;
+        return h;
+    }
+};
+}
+
 
 u32_t AndersenBase::numOfProcessedAddr = 0;
 u32_t AndersenBase::numOfProcessedCopy = 0;
@@ -46,6 +61,10 @@ u32_t AndersenBase::numOfProcessedLoad = 0;
 u32_t AndersenBase::numOfProcessedStore = 0;
 u32_t AndersenBase::numOfSfrs = 0;
 u32_t AndersenBase::numOfFieldExpand = 0;
+u32_t AndersenBase::numOfLCDChecks = 0;
+u32_t AndersenBase::numOfHCDMerges = 0;
+u32_t AndersenBase::numOfSubstNodes = 0;
+u32_t AndersenBase::numOfSubstEdges = 0;
 
 u32_t AndersenBase::numOfSCCDetection = 0;
 double AndersenBase::timeOfSCCDetection = 0;
@@ -57,6 +76,7 @@ u32_t AndersenBase::MaxPointsToSetSize = 0;
 double AndersenBase::timeOfProcessCopyGep = 0;
 double AndersenBase::timeOfProcessLoadStore = 0;
 double AndersenBase::timeOfUpdateCallGraph = 0;
+double AndersenBase::timeOfVarSubst = 0;
 
 /*!
  * Destructor
@@ -105,6 +125,16 @@ void AndersenBase::solveConstraints()
     bool limitTimerSet = SVFUtil::startAnalysisLimitTimer(Options::AnderTimeLimit());
 
     initWorklist();
+    solveUntilFixpoint();
+
+    // Analysis is finished, reset the alarm if we set it.
+    SVFUtil::stopAnalysisLimitTimer(limitTimerSet);
+
+    DBOUT(DGENERAL, outs() << SVFUtil::pasMsg("Finish Solving Constraints\n"));
+}
+
+void AndersenBase::solveUntilFixpoint()
+{
     do
     {
         numOfIteration++;
@@ -118,13 +148,25 @@ void AndersenBase::solveConstraints()
         if (updateCallGraph(getIndirectCallsites()))
             reanalyze = true;
 
+        // Between iterations no intermediate points-to IDs are held outside the
+        // (reference counted) points-to data, so unused sets can be collected.
+        if (Options::ptDataBacking() == PTBackingType::Hybrid && getPtCache().maybeCollectGarbage() > 0)
+            invalidateAliasCache();
     }
     while (reanalyze);
+}
 
-    // Analysis is finished, reset the alarm if we set it.
-    SVFUtil::stopAnalysisLimitTimer(limitTimerSet);
+/*!
+ * Incremental solving is only supported by the inclusion-based solvers
+ */
+void AndersenBase::addConstraints(const ConstraintList&)
+{
+    writeWrnMsg(PTAName() + " does not support incremental solving, constraints not added");
+}
 
-    DBOUT(DGENERAL, outs() << SVFUtil::pasMsg("Finish Solving Constraints\n"));
+void AndersenBase::removeConstraints(const ConstraintList&)
+{
+    writeWrnMsg(PTAName() + " does not support incremental solving, constraints not removed");
 }
 
 /*!
@@ -169,11 +211,16 @@ void AndersenBase:: solveAndwritePtsToFile(const std::string& filename)
 {
     /// Initialization for the Solver
     initialize();
-    if (!filename.empty())
+    if (!filename.empty() && !Options::WriteAnderBinary())
         this->writeObjVarToFile(filename);
     solveConstraints();
     if (!filename.empty())
-        this->writeToFile(filename);
+    {
+        if (Options::WriteAnderBinary())
+            this->writeToBinaryFile(filename);
+        else
+            this->writeToFile(filename);
+    }
     finalize();
 }
 
@@ -419,9 +466,13 @@ void Andersen::initialize()
 {
     resetData();
     AndersenBase::initialize();
+    setWorklistPolicy(Options::AnderWorklist());
 
     if (Options::ClusterAnder()) cluster();
 
+    if (varSubst != NoVarSubst)
+        substituteVars();
+
     /// Initialize worklist
     processAllAddr();
 }
@@ -443,6 +494,9 @@ void Andersen::finalize()
         NodeIDAllocator::Clusterer::printStats("post-main", stats);
     }
 
+    if (varSubst != NoVarSubst && Options::AnderVarSubstCheck())
+        checkVarSubst();
+
     /// sanitize field insensitive obj
     /// TODO: Fields has been collapsed during Andersen::collapseField().
     //	sanitizePts();
@@ -905,6 +959,482 @@ void Andersen::updateNodeRepAndSubs(NodeID nodeId, NodeID newRepId)
     consCG->resetSubs(nodeId);
 }
 
+/*!
+ * Add constraints to the solved constraint graph and propagate their effect.
+ * A new edge propagates the whole points-to set of its source once; later
+ * changes of the source reach it through the diff points-to sets as usual.
+ */
+void Andersen::addConstraints(const ConstraintList& constraints)
+{
+    for (const Constraint& c : constraints)
+    {
+        NodeID src = sccRepNode(c.src);
+        NodeID dst = sccRepNode(c.dst);
+        switch (c.kind)
+        {
+        case ConstraintEdge::Addr:
+            if (AddrCGEdge* addr = consCG->addAddrCGEdge(src, dst))
+                processAddr(addr);
+            break;
+        case ConstraintEdge::Copy:
+            if (src != dst && addCopyEdge(src, dst) && unionPts(dst, getPts(src)))
+                pushIntoWorklist(dst);
+            break;
+        case ConstraintEdge::NormalGep:
+            if (NormalGepCGEdge* gep = consCG->addNormalGepCGEdge(src, dst, c.ap))
+                processGepPts(getPts(src), gep);
+            break;
+        case ConstraintEdge::VariantGep:
+            if (VariantGepCGEdge* gep = consCG->addVariantGepCGEdge(src, dst))
+                processGepPts(getPts(src), gep);
+            break;
+        case ConstraintEdge::Load:
+            if (consCG->addLoadCGEdge(src, dst))
+                pushIntoWorklist(src);
+            break;
+        case ConstraintEdge::Store:
+            if (consCG->addStoreCGEdge(src, dst))
+                pushIntoWorklist(dst);
+            break;
+        }
+    }
+
+    solveUntilFixpoint();
+    clearAliasCache();
+}
+
+/*!
+ * Remove constraints from the solved constraint graph and re-solve what they may
+ * have contributed to. Points-to sets do not record where their elements came
+ * from, so the nodes which may depend on a removed constraint are reset and
+ * recomputed from the constraints around them:
+ *  (1) remove the edges, collecting the nodes whose points-to sets may shrink,
+ *  (2) extend them with every node depending on them,
+ *  (3) drop the copy edges derived from loads/stores into those nodes, and clear
+ *      their points-to sets and propagated (diff) points-to sets,
+ *  (4) re-seed them from their addr edges and their unaffected predecessors, and
+ *      re-process the loads/stores which may derive the dropped edges again,
+ *  (5) solve as usual.
+ * SCC merges, collapsed fields and resolved indirect calls are kept, which is
+ * sound but may be less precise than solving from scratch.
+ */
+void Andersen::removeConstraints(const ConstraintList& constraints)
+{
+    NodeBS roots;
+    for (const Constraint& c : constraints)
+    {
+        ConstraintNode* src = consCG->getConstraintNode(sccRepNode(c.src));
+        ConstraintNode* dst = consCG->getConstraintNode(sccRepNode(c.dst));
+        // Either never added or folded into an SCC.
+        if (!consCG->hasEdge(src, dst, c.kind))
+            continue;
+
+        ConstraintEdge* edge = consCG->getEdge(src, dst, c.kind);
+        switch (c.kind)
+        {
+        case ConstraintEdge::Addr:
+            consCG->removeAddrEdge(SVFUtil::cast<AddrCGEdge>(edge));
+            roots.set(dst->getId());
+            break;
+        case ConstraintEdge::Copy:
+        case ConstraintEdge::NormalGep:
+        case ConstraintEdge::VariantGep:
+            consCG->removeDirectEdge(edge);
+            roots.set(dst->getId());
+            break;
+        case ConstraintEdge::Load:
+            consCG->removeLoadEdge(SVFUtil::cast<LoadCGEdge>(edge));
+            roots.set(dst->getId());
+            break;
+        case ConstraintEdge::Store:
+            consCG->removeStoreEdge(SVFUtil::cast<StoreCGEdge>(edge));
+            for (NodeID o : getPts(dst->getId()))
+                roots.set(sccRepNode(o));
+            break;
+        }
+    }
+
+    NodeBS affected;
+    collectAffectedNodes(roots, affected);
+
+    NodeBS toReprocess;
+    for (NodeID id : affected)
+    {
+        ConstraintNode* node = consCG->getConstraintNode(id);
+        std::vector<ConstraintEdge*> derivedEdges;
+        for (ConstraintEdge* edge : node->getCopyInEdges())
+        {
+            if (isDerivedCopyEdge(edge->getSrcID(), id))
+                derivedEdges.push_back(edge);
+        }
+
+        if (!derivedEdges.empty())
+        {
+            for (ConstraintEdge* load : node->getLoadInEdges())
+                toReprocess.set(load->getSrcID());
+        }
+        for (ConstraintEdge* edge : derivedEdges)
+        {
+            for (ConstraintEdge* store : consCG->getConstraintNode(edge->getSrcID())->getStoreOutEdges())
+                toReprocess.set(store->getDstID());
+            consCG->removeDirectEdge(edge);
+        }
+
+        clearFullPts(id);
+        clearPropaPts(id);
+    }
+
+    for (NodeID id : affected)
+    {
+        ConstraintNode* node = consCG->getConstraintNode(id);
+        for (ConstraintEdge* edge : node->getAddrInEdges())
+            processAddr(SVFUtil::cast<AddrCGEdge>(edge));
+        for (ConstraintEdge* edge : node->getCopyInEdges())
+        {
+            if (!affected.test(edge->getSrcID()) && unionPts(id, getPts(edge->getSrcID())))
+                pushIntoWorklist(id);
+        }
+        for (ConstraintEdge* edge : node->getGepInEdges())
+        {
+            if (!affected.test(edge->getSrcID()))
+                processGepPts(getPts(edge->getSrcID()), SVFUtil::cast<GepCGEdge>(edge));
+        }
+    }
+    for (NodeID id : toReprocess)
+        pushIntoWorklist(id);
+
+    solveUntilFixpoint();
+    clearAliasCache();
+}
+
+/*!
+ * Collect the nodes reachable from roots through copy/gep edges, loads
+ * (from the pointer to the loaded value) and stores (from the pointer to the
+ * objects it points to).
+ */
+void Andersen::collectAffectedNodes(const NodeBS& roots, NodeBS& affected)
+{
+    std::vector<NodeID> nodes;
+    auto visit = [this, &affected, &nodes](NodeID id)
+    {
+        id = sccRepNode(id);
+        if (affected.test_and_set(id))
+            nodes.push_back(id);
+    };
+
+    for (NodeID id : roots)
+        visit(id);
+
+    while (!nodes.empty())
+    {
+        NodeID id = nodes.back();
+        nodes.pop_back();
+
+        ConstraintNode* node = consCG->getConstraintNode(id);
+        for (ConstraintEdge* edge : node->getDirectOutEdges())
+            visit(edge->getDstID());
+        for (ConstraintEdge* edge : node->getLoadOutEdges())
+            visit(edge->getDstID());
+        if (!node->getStoreInEdges().empty())
+        {
+            for (NodeID o : getPts(id))
+                visit(o);
+        }
+    }
+}
+
+bool Andersen::isDerivedCopyEdge(NodeID src, NodeID dst)
+{
+    if (consCG->sccSubNodes(src).count() > 1 || consCG->sccSubNodes(dst).count() > 1)
+        return false;
+    return SVFUtil::isa<ObjVar>(pag->getGNode(src)) || SVFUtil::isa<ObjVar>(pag->getGNode(dst));
+}
+
+/*!
+ * Build the offline constraint graph from the copy, load and store edges.
+ * Only loads into and stores of pointers are added, as the others are never
+ * processed (see processLoad and processStore).
+ */
+void Andersen::buildOfflineGraph(OfflineGraph& og)
+{
+    for (ConstraintGraph::const_iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+    {
+        og.nodeToIdx[it->first] = og.idxToNode.size();
+        og.idxToNode.push_back(it->first);
+    }
+    og.succs.resize(2 * og.idxToNode.size());
+
+    for (const ConstraintEdge* edge : consCG->getDirectCGEdges())
+    {
+        if (SVFUtil::isa<CopyCGEdge>(edge))
+            og.succs[og.varIdx(edge->getSrcID())].push_back(og.varIdx(edge->getDstID()));
+    }
+    for (const ConstraintEdge* edge : consCG->getLoadCGEdges())
+    {
+        if (pag->getGNode(edge->getDstID())->isPointer())
+            og.succs[og.refIdx(edge->getSrcID())].push_back(og.varIdx(edge->getDstID()));
+    }
+    for (const ConstraintEdge* edge : consCG->getStoreCGEdges())
+    {
+        if (pag->getGNode(edge->getSrcID())->isPointer())
+            og.succs[og.varIdx(edge->getSrcID())].push_back(og.refIdx(edge->getDstID()));
+    }
+}
+
+/*!
+ * Iterative Tarjan's algorithm. An SCC is completed after all SCCs reachable
+ * from it, so sccs ends up in reverse topological order.
+ */
+void Andersen::findOfflineSCCs(const OfflineGraph& og, OfflineSCCs& sccs)
+{
+    const u32_t numOfNodes = og.succs.size();
+    const u32_t Unvisited = UINT32_MAX;
+    std::vector<u32_t> dfsNum(numOfNodes, Unvisited);
+    std::vector<u32_t> lowLink(numOfNodes, 0);
+    std::vector<u8_t> onStack(numOfNodes, false);
+    std::vector<u32_t> sccStack;
+    // (node, index of its next successor to visit)
+    std::vector<std::pair<u32_t, u32_t>> visitStack;
+    u32_t index = 0;
+
+    for (u32_t root = 0; root < numOfNodes; ++root)
+    {
+        if (dfsNum[root] != Unvisited)
+            continue;
+
+        visitStack.emplace_back(root, 0);
+        while (!visitStack.empty())
+        {
+            u32_t v = visitStack.back().first;
+            u32_t nextSucc = visitStack.back().second;
+            if (nextSucc == 0)
+            {
+                dfsNum[v] = lowLink[v] = index++;
+                sccStack.push_back(v);
+                onStack[v] = true;
+            }
+
+            if (nextSucc < og.succs[v].size())
+            {
+                visitStack.back().second++;
+                u32_t w = og.succs[v][nextSucc];
+                if (dfsNum[w] == Unvisited)
+                    visitStack.emplace_back(w, 0);
+                else if (onStack[w])
+                    lowLink[v] = std::min(lowLink[v], dfsNum[w]);
+                continue;
+            }
+
+            visitStack.pop_back();
+            if (!visitStack.empty())
+            {
+                u32_t parent = visitStack.back().first;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[v]);
+            }
+
+            if (lowLink[v] == dfsNum[v])
+            {
+                sccs.emplace_back();
+                u32_t w;
+                do
+                {
+                    w = sccStack.back();
+                    sccStack.pop_back();
+                    onStack[w] = false;
+                    sccs.back().push_back(w);
+                }
+                while (w != v);
+            }
+        }
+    }
+}
+
+/*!
+ * Offline variable substitution (Hardekopf and Lin, "Exploiting Pointer and
+ * Location Equivalence to Optimize Pointer Analysis", SAS'07).
+ * Every offline node gets a pointer-equivalence label such that nodes with the
+ * same label always end up with the same points-to set, and non-ref nodes
+ * sharing a non-empty label are merged before solving.
+ * Nodes whose points-to sets are not determined by the offline graph alone get
+ * a fresh label: ref nodes, objects, destinations of gep edges and nodes which
+ * may get copy edges from indirect calls (formal parameters, varargs and
+ * callsite returns). Other nodes are labelled after their predecessors and the
+ * objects whose address they take:
+ *	HVN: by the set of labels of their predecessors,
+ *	HU:  by the union of the label sets of their predecessors.
+ * Only nodes which are both pointers or both non-pointers are merged, as the
+ * solver skips loads into and stores of non-pointers by their rep nodes.
+ */
+void Andersen::substituteVars()
+{
+    double start = stat->getClk();
+
+    auto numOfEdges = [this]()
+    {
+        return consCG->getDirectCGEdges().size() + consCG->getLoadCGEdges().size()
+               + consCG->getStoreCGEdges().size() + consCG->getAddrCGEdges().size();
+    };
+    size_t numOfEdgesBefore = numOfEdges();
+
+    OfflineGraph og;
+    buildOfflineGraph(og);
+    OfflineSCCs sccs;
+    findOfflineSCCs(og, sccs);
+
+    const u32_t numOfflineNodes = og.succs.size();
+    std::vector<u32_t> sccOf(numOfflineNodes);
+    for (u32_t s = 0; s < sccs.size(); ++s)
+    {
+        for (u32_t idx : sccs[s])
+            sccOf[idx] = s;
+    }
+    std::vector<std::vector<u32_t>> preds(numOfflineNodes);
+    for (u32_t v = 0; v < numOfflineNodes; ++v)
+    {
+        for (u32_t w : og.succs[v])
+            preds[w].push_back(v);
+    }
+
+    NodeBS indirectNodes;
+    for (const ConstraintEdge* edge : consCG->getDirectCGEdges())
+    {
+        if (SVFUtil::isa<GepCGEdge>(edge))
+            indirectNodes.set(edge->getDstID());
+    }
+    for (const auto& funArgs : pag->getFunArgsMap())
+    {
+        for (const SVFVar* arg : funArgs.second)
+            indirectNodes.set(arg->getId());
+        if (funArgs.first->isVarArg())
+            indirectNodes.set(pag->getVarargNode(funArgs.first));
+    }
+    for (const auto& csRet : pag->getCallSiteRets())
+        indirectNodes.set(csRet.second->getId());
+
+    const bool unionLabels = varSubst == HUSubst;
+    // Label 0 stands for an empty points-to set.
+    u32_t numOfLabels = 1;
+    Map<NodeID, u32_t> objLabels;
+    Map<NodeBS, u32_t, LabelSetHash> labelSetToLabel;
+    // HU: label --> the set of labels it stands for
+    std::vector<NodeBS> labelSets(1);
+    std::vector<u32_t> sccLabels(sccs.size(), 0);
+
+    for (u32_t s = sccs.size(); s-- > 0;)
+    {
+        NodeBS labelSet;
+        for (u32_t idx : sccs[s])
+        {
+            NodeID id = og.getNode(idx);
+            if (OfflineGraph::isRef(idx) || indirectNodes.test(id) || SVFUtil::isa<ObjVar>(pag->getGNode(id)))
+                labelSet.set(numOfLabels++);
+            else
+            {
+                for (const ConstraintEdge* addr : consCG->getConstraintNode(id)->getAddrInEdges())
+                {
+                    auto objLabel = objLabels.emplace(addr->getSrcID(), numOfLabels);
+                    if (objLabel.second)
+                        numOfLabels++;
+                    labelSet.set(objLabel.first->second);
+                }
+            }
+
+            for (u32_t pred : preds[idx])
+            {
+                u32_t predLabel = sccLabels[sccOf[pred]];
+                if (sccOf[pred] == s || predLabel == 0)
+                    continue;
+                if (unionLabels)
+                    labelSet |= labelSets[predLabel];
+                else
+                    labelSet.set(predLabel);
+            }
+        }
+
+        if (labelSet.empty())
+            continue;
+
+        if (unionLabels)
+        {
+            auto label = labelSetToLabel.emplace(labelSet, labelSets.size());
+            if (label.second)
+                labelSets.push_back(labelSet);
+            sccLabels[s] = label.first->second;
+        }
+        else if (labelSet.count() == 1)
+        {
+            // A single label is passed on as is.
+            sccLabels[s] = labelSet.find_first();
+        }
+        else
+        {
+            auto label = labelSetToLabel.emplace(labelSet, numOfLabels);
+            if (label.second)
+                numOfLabels++;
+            sccLabels[s] = label.first->second;
+        }
+    }
+
+    // label --> rep, for non-pointers and pointers
+    Map<u32_t, NodeID> labelToRep[2];
+    for (u32_t s = 0; s < sccs.size(); ++s)
+    {
+        if (sccLabels[s] == 0)
+            continue;
+
+        for (u32_t idx : sccs[s])
+        {
+            if (OfflineGraph::isRef(idx))
+                continue;
+
+            NodeID id = og.getNode(idx);
+            bool isPtr = pag->getGNode(id)->isPointer();
+            auto rep = labelToRep[isPtr].emplace(sccLabels[s], id);
+            if (rep.second)
+                continue;
+
+            NodeID nodeRepId = sccRepNode(id);
+            NodeID repId = sccRepNode(rep.first->second);
+            if (nodeRepId != repId)
+            {
+                mergeNodeToRep(nodeRepId, repId);
+                numOfSubstNodes++;
+            }
+        }
+    }
+
+    numOfSubstEdges += numOfEdgesBefore - numOfEdges();
+
+    double end = stat->getClk();
+    timeOfVarSubst += (end - start) / TIMEINTERVAL;
+}
+
+/*!
+ * Solve the constraints again without variable substitution and compare the
+ * points-to sets of all SVFIR nodes (-ander-var-subst-check)
+ */
+void Andersen::checkVarSubst()
+{
+    Andersen ref(pag);
+    ref.setVarSubst(NoVarSubst);
+    ref.initialize();
+    ref.solveConstraints();
+
+    u32_t numOfDiffs = 0;
+    for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        NodeID id = it->first;
+        if (getPts(id) != ref.getPts(id))
+        {
+            SVFUtil::errs() << "var subst check: points-to sets of node " << id << " differ\n";
+            numOfDiffs++;
+        }
+    }
+    SVFUtil::outs() << "var subst check: " << pag->getTotalNodeNum() << " nodes, "
+                    << numOfDiffs << " with different points-to sets\n";
+    assert(numOfDiffs == 0 && "variable substitution changed points-to sets!");
+}
+
 void Andersen::cluster(void) const
 {
     assert(Options::MaxFieldLimit() == 0 && "Andersen::cluster: clustering for Andersen's is currently only supported in field-insensitive analysis");
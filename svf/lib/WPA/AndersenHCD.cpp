@@ -0,0 +1,187 @@
+//===- AndersenHCD.cpp -- Hybrid cycle detection Andersen's analysis---------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenHCD.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "WPA/AndersenCD.h"
+#include "MemoryModel/PointsTo.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+using namespace std;
+
+AndersenHCD* AndersenHCD::hcdAndersen = nullptr;
+
+
+/*!
+ * Initialize analysis, collapsing the offline cycles before solving
+ */
+void AndersenHCD::initialize()
+{
+    Andersen::initialize();
+    detectOfflineCycles();
+}
+
+
+/*!
+ * Find the SCCs of the offline constraint graph (see Andersen::OfflineGraph).
+ * Only edges whose online counterparts always induce an inclusion are in the
+ * offline graph, so every offline cycle implies the equivalence of its members.
+ */
+void AndersenHCD::detectOfflineCycles()
+{
+    numOfSCCDetection++;
+    double sccStart = stat->getClk();
+
+    OfflineGraph og;
+    buildOfflineGraph(og);
+    OfflineSCCs offlineSCCs;
+    findOfflineSCCs(og, offlineSCCs);
+
+    double sccEnd = stat->getClk();
+    timeOfSCCDetection += (sccEnd - sccStart) / TIMEINTERVAL;
+
+    double mergeStart = stat->getClk();
+    for (const std::vector<u32_t>& scc : offlineSCCs)
+    {
+        if (scc.size() == 1)
+            continue;
+
+        // Ref nodes only have edges from and to non-ref nodes, so every
+        // non-trivial SCC has a non-ref node.
+        NodeID repNodeId = 0;
+        bool hasRep = false;
+        for (u32_t idx : scc)
+        {
+            if (OfflineGraph::isRef(idx))
+                continue;
+            NodeID nodeId = og.getNode(idx);
+            if (!hasRep)
+            {
+                repNodeId = sccRepNode(nodeId);
+                hasRep = true;
+            }
+            else if (sccRepNode(nodeId) != sccRepNode(repNodeId))
+            {
+                mergeNodeToRep(sccRepNode(nodeId), sccRepNode(repNodeId));
+                numOfHCDMerges++;
+            }
+        }
+        assert(hasRep && "offline SCC made of ref nodes only?");
+
+        repNodeId = sccRepNode(repNodeId);
+        for (u32_t idx : scc)
+        {
+            if (OfflineGraph::isRef(idx))
+                pointeeEquivs[sccRepNode(og.getNode(idx))].set(repNodeId);
+        }
+        pushIntoWorklist(repNodeId);
+    }
+    double mergeEnd = stat->getClk();
+    timeOfSCCMerges += (mergeEnd - mergeStart) / TIMEINTERVAL;
+}
+
+
+/*!
+ * Merge the pointees of a node with offline equivalences before processing it
+ */
+void AndersenHCD::processNode(NodeID nodeId)
+{
+    // sub nodes do not need to be processed
+    if (sccRepNode(nodeId) != nodeId)
+        return;
+
+    mergePointees(nodeId);
+    Andersen::processNode(sccRepNode(nodeId));
+}
+
+
+/*!
+ * For each pointee o of nodeId and each node q equivalent to *nodeId,
+ * merge o into q
+ */
+void AndersenHCD::mergePointees(NodeID nodeId)
+{
+    PointeeEquivMap::const_iterator it = pointeeEquivs.find(nodeId);
+    if (it == pointeeEquivs.end())
+        return;
+
+    double mergeStart = stat->getClk();
+
+    // Both are changed by the merges below.
+    const NodeBS equivs = it->second;
+    const PointsTo pts = getPts(nodeId);
+    for (NodeID equiv : equivs)
+    {
+        bool changed = false;
+        for (NodeID o : pts)
+        {
+            // Loads and stores through constant objects are not processed
+            // (see Andersen::processLoad and Andersen::processStore).
+            if (pag->isConstantObj(o))
+                continue;
+
+            NodeID objRep = sccRepNode(o);
+            NodeID equivRep = sccRepNode(equiv);
+            if (objRep == equivRep)
+                continue;
+
+            mergeNodeToRep(objRep, equivRep);
+            numOfHCDMerges++;
+            changed = true;
+        }
+
+        if (changed)
+        {
+            NodeID equivRep = sccRepNode(equiv);
+            collapsePWCNode(equivRep);
+            pushIntoWorklist(equivRep);
+        }
+    }
+
+    double mergeEnd = stat->getClk();
+    timeOfSCCMerges += (mergeEnd - mergeStart) / TIMEINTERVAL;
+}
+
+
+/*!
+ * Merge a node to its rep node, moving its offline equivalences along
+ */
+void AndersenHCD::mergeNodeToRep(NodeID nodeId, NodeID newRepId)
+{
+    Andersen::mergeNodeToRep(nodeId, newRepId);
+
+    if (nodeId == newRepId)
+        return;
+
+    PointeeEquivMap::iterator it = pointeeEquivs.find(nodeId);
+    if (it != pointeeEquivs.end())
+    {
+        NodeBS equivs = std::move(it->second);
+        pointeeEquivs.erase(it);
+        pointeeEquivs[newRepId] |= equivs;
+    }
+}
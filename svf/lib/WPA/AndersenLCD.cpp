@@ -0,0 +1,121 @@
+//===- AndersenLCD.cpp -- Lazy cycle detection Andersen's analysis-----------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenLCD.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "WPA/AndersenCD.h"
+#include "MemoryModel/PointsTo.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+using namespace std;
+
+AndersenLCD* AndersenLCD::lcdAndersen = nullptr;
+
+
+/*!
+ * Solve the worklist, collapsing the cycles found lazily after each node
+ */
+void AndersenLCD::solveWorklist()
+{
+    while (!isWorklistEmpty())
+    {
+        NodeID nodeId = popFromWorklist();
+        processNode(nodeId);
+        collapseFields();
+
+        // Cycles cannot be merged while the copy edges of nodeId are being
+        // iterated, so the searches are deferred until here.
+        if (!lcdCandidates.empty())
+            detectLazyCycles();
+    }
+}
+
+
+/*!
+ * Process copy edges
+ *	src --copy--> dst,
+ *	union pts(dst) with pts(src),
+ *	and if dst is unchanged while pts(src) == pts(dst), search a cycle from dst
+ */
+bool AndersenLCD::processCopy(NodeID node, const ConstraintEdge* edge)
+{
+    bool changed = Andersen::processCopy(node, edge);
+    if (changed)
+        return true;
+
+    NodeID src = sccRepNode(node);
+    NodeID dst = sccRepNode(edge->getDstID());
+    if (src == dst || checkedEdges.count(std::make_pair(src, dst)))
+        return false;
+
+    const PointsTo& srcPts = getPts(src);
+    if (!srcPts.empty() && srcPts == getPts(dst))
+    {
+        checkedEdges.insert(std::make_pair(src, dst));
+        lcdCandidates.insert(dst);
+        numOfLCDChecks++;
+    }
+    return false;
+}
+
+
+/*!
+ * SCC detection from the lazy cycle candidates
+ */
+void AndersenLCD::detectLazyCycles()
+{
+    numOfSCCDetection++;
+
+    NodeSet candidates;
+    for (NodeID candidate : lcdCandidates)
+        candidates.insert(sccRepNode(candidate));
+    lcdCandidates.clear();
+
+    double sccStart = stat->getClk();
+    getSCCDetector()->find(candidates);
+    rankWorklistNodes();
+    double sccEnd = stat->getClk();
+    timeOfSCCDetection += (sccEnd - sccStart) / TIMEINTERVAL;
+
+    double mergeStart = stat->getClk();
+    mergeSccCycle();
+    double mergeEnd = stat->getClk();
+    timeOfSCCMerges += (mergeEnd - mergeStart) / TIMEINTERVAL;
+
+    // The merged nodes need to propagate their combined points-to sets.
+    NodeStack topoOrder = getSCCDetector()->topoNodeStack();
+    while (!topoOrder.empty())
+    {
+        NodeID repNodeId = topoOrder.top();
+        topoOrder.pop();
+        if (getSCCDetector()->subNodes(repNodeId).count() > 1)
+        {
+            collapsePWCNode(repNodeId);
+            pushIntoWorklist(repNodeId);
+        }
+    }
+}
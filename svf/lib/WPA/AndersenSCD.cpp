@@ -100,6 +100,7 @@ NodeStack& AndersenSCD::SCCDetect()
 
     double sccStart = stat->getClk();
     getSCCDetector()->find(sccCandidates);
+    rankWorklistNodes();
     double sccEnd = stat->getClk();
     timeOfSCCDetection +=  (sccEnd - sccStart)/TIMEINTERVAL;
 
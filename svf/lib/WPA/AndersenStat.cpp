@@ -312,6 +312,7 @@ void AndersenStat::performStat()
     timeStatMap["LoadStoreTime"] =  Andersen::timeOfProcessLoadStore;
     timeStatMap["CopyGepTime"] =  Andersen::timeOfProcessCopyGep;
     timeStatMap["UpdateCGTime"] =  Andersen::timeOfUpdateCallGraph;
+    timeStatMap["VarSubstTime"] =  Andersen::timeOfVarSubst;
 
     PTNumStatMap["TotalPointers"] = pag->getValueNodeNum();
     PTNumStatMap["TotalObjects"] = pag->getObjectNodeNum();
@@ -325,6 +326,10 @@ void AndersenStat::performStat()
 
     PTNumStatMap["NumOfSFRs"] = Andersen::numOfSfrs;
     PTNumStatMap["NumOfFieldExpand"] = Andersen::numOfFieldExpand;
+    PTNumStatMap["NumOfLCDChecks"] = Andersen::numOfLCDChecks;
+    PTNumStatMap["NumOfHCDMerges"] = Andersen::numOfHCDMerges;
+    PTNumStatMap["SubstNodes"] = Andersen::numOfSubstNodes;
+    PTNumStatMap["SubstEdges"] = Andersen::numOfSubstEdges;
 
     PTNumStatMap["Pointers"] = pag->getValueNodeNum();
     PTNumStatMap["MemObjects"] = pag->getObjectNodeNum();
@@ -337,6 +342,7 @@ void AndersenStat::performStat()
     PTNumStatMap["MaxPtsSetSize"] = _MaxPtsSize;
 
     PTNumStatMap["SolveIterations"] = pta->numOfIteration;
+    PTNumStatMap["NodeVisits"] = pta->numOfNodeVisits;
 
     PTNumStatMap["IndCallSites"] = consCG->getIndirectCallsites().size();
     PTNumStatMap["IndEdgeSolved"] = pta->getNumOfResolvedIndCallEdge();
@@ -43,6 +43,17 @@ void AndersenWaveDiff::initialize()
 {
     Andersen::initialize();
     setDetectPWC(true);   // Standard wave propagation always collapses PWCs
+
+    if (Options::AnderThreads() > 1)
+    {
+        // Concurrent unions need a points-to set per pointer (the persistent backing shares
+        // one cache between all sets) and diff points-to (so that the set a node propagates
+        // is never the set another task is unioning into).
+        if (SVFUtil::isa<MutDiffPTDataTy>(getPTDataTy()) && Options::DiffPts())
+            threadPool = std::make_unique<ThreadPool>(Options::AnderThreads());
+        else
+            writeWrnMsg("-ander-threads requires -ptd=mutable and -diff, propagating serially");
+    }
 }
 
 /*!
@@ -55,14 +66,20 @@ void AndersenWaveDiff::solveWorklist()
     NodeStack& nodeStack = SCCDetect();
 
     // Process nodeStack and put the changed nodes into workList.
-    while (!nodeStack.empty())
+    if (threadPool)
+        propagateInParallel(nodeStack);
+    else
     {
-        NodeID nodeId = nodeStack.top();
-        nodeStack.pop();
-        collapsePWCNode(nodeId);
-        // process nodes in nodeStack
-        processNode(nodeId);
-        collapseFields();
+        while (!nodeStack.empty())
+        {
+            NodeID nodeId = nodeStack.top();
+            nodeStack.pop();
+            collapsePWCNode(nodeId);
+            // process nodes in nodeStack
+            ++numOfNodeVisits;
+            processNode(nodeId);
+            collapseFields();
+        }
     }
 
     // New nodes will be inserted into workList during processing.
@@ -91,6 +108,131 @@ void AndersenWaveDiff::processNode(NodeID nodeId)
     timeOfProcessCopyGep += (propEnd - propStart) / TIMEINTERVAL;
 }
 
+/*!
+ * Propagate along copy/gep edges in the order of the serial solver.
+ * Consecutive nodes of the topological order which have no copy edge between them,
+ * no gep edge and are not PWC nodes only union into other nodes' points-to sets,
+ * so their copy edges are processed together on the thread pool. Any other node
+ * may change the constraint graph and is processed as the serial solver does.
+ */
+void AndersenWaveDiff::propagateInParallel(NodeStack& nodeStack)
+{
+    std::vector<NodeID> batch;
+    Set<NodeID> batchDsts;
+    while (!nodeStack.empty())
+    {
+        NodeID nodeId = nodeStack.top();
+        nodeStack.pop();
+        ++numOfNodeVisits;
+
+        bool isRep = sccRepNode(nodeId) == nodeId;
+        bool isPWC = consCG->isPWCNode(nodeId);
+        if (!isRep && !isPWC)
+            continue;
+
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        if (isRep && !isPWC && node->getGepOutEdges().empty())
+        {
+            if (batchDsts.count(nodeId))
+            {
+                propagateBatch(batch);
+                batch.clear();
+                batchDsts.clear();
+            }
+            batch.push_back(nodeId);
+            for (ConstraintEdge* edge : node->getCopyOutEdges())
+                batchDsts.insert(sccRepNode(edge->getDstID()));
+            continue;
+        }
+
+        propagateBatch(batch);
+        batch.clear();
+        batchDsts.clear();
+
+        collapsePWCNode(nodeId);
+        processNode(nodeId);
+        collapseFields();
+    }
+    propagateBatch(batch);
+}
+
+/*!
+ * Process the copy edges of a batch of independent nodes.
+ * The unions into one destination are done by one task in the order of the serial
+ * solver, which then records the reverse points-to and pushes the changed
+ * destinations into the worklist in its order as well.
+ */
+void AndersenWaveDiff::propagateBatch(const std::vector<NodeID>& batch)
+{
+    if (batch.empty())
+        return;
+
+    double propStart = stat->getClk();
+    MutDiffPTDataTy* ptData = SVFUtil::cast<MutDiffPTDataTy>(getPTDataTy());
+
+    std::vector<ConstraintNode*> srcNodes;
+    std::vector<const PointsTo*> srcPts;
+    for (NodeID nodeId : batch)
+    {
+        computeDiffPts(nodeId);
+        const PointsTo& diffPts = getDiffPts(nodeId);
+        if (diffPts.empty())
+            continue;
+        srcNodes.push_back(consCG->getConstraintNode(nodeId));
+        srcPts.push_back(&diffPts);
+    }
+
+    // Group the unions (source index, edge index) by destination, creating the
+    // destination points-to sets up front so that the points-to map is only read
+    // by the tasks.
+    Map<NodeID, u32_t> dstToTask;
+    std::vector<NodeID> taskDsts;
+    std::vector<std::vector<std::pair<u32_t, u32_t>>> tasks;
+    std::vector<std::vector<char>> changed(srcNodes.size());
+    for (u32_t i = 0; i < srcNodes.size(); ++i)
+    {
+        u32_t k = 0;
+        for (ConstraintEdge* edge : srcNodes[i]->getCopyOutEdges())
+        {
+            NodeID dst = sccRepNode(edge->getDstID());
+            auto inserted = dstToTask.emplace(dst, tasks.size());
+            if (inserted.second)
+            {
+                taskDsts.push_back(dst);
+                tasks.emplace_back();
+                ptData->getPts(dst);
+            }
+            tasks[inserted.first->second].emplace_back(i, k++);
+        }
+        changed[i].assign(k, false);
+    }
+
+    threadPool->parallelFor(tasks.size(), [&](u32_t t, u32_t)
+    {
+        for (const auto& item : tasks[t])
+            changed[item.first][item.second] = ptData->unionPtsNoRev(taskDsts[t], *srcPts[item.first]);
+    });
+
+    for (u32_t i = 0; i < srcNodes.size(); ++i)
+    {
+        u32_t k = 0, numChanged = 0;
+        for (ConstraintEdge* edge : srcNodes[i]->getCopyOutEdges())
+        {
+            ++numOfProcessedCopy;
+            ptData->addRevPts(sccRepNode(edge->getDstID()), *srcPts[i]);
+            if (changed[i][k++])
+            {
+                ++numChanged;
+                pushIntoWorklist(edge->getDstID());
+            }
+        }
+        recordUnions(k, numChanged);
+    }
+
+    double propEnd = stat->getClk();
+    timeOfProcessCopyGep += (propEnd - propStart) / TIMEINTERVAL;
+}
+
 /*!
  * Post process node
  */
@@ -37,6 +37,7 @@ using namespace SVF;
 using namespace SVFUtil;
 
 std::unique_ptr<FlowSensitive> FlowSensitive::fspta;
+thread_local FlowSensitive::SCCTask* FlowSensitive::curSCCTask = nullptr;
 
 /*!
  * Initialize analysis
@@ -71,6 +72,20 @@ void FlowSensitive::initialize()
     svfg = memSSA.buildPTROnlySVFG(ander);
 
     setGraph(svfg);
+    setWorklistPolicy(Options::FsWorklist());
+
+    if (Options::FsThreads() > 1 && getAnalysisTy() == FSSPARSE_WPA)
+    {
+        // SCCs of a level share the top-level and data-flow points-to maps, whose entries
+        // must be individual sets (the persistent backing shares one cache between them).
+        if (SVFUtil::isa<MutDFPTDataTy>(getPTDataTy()))
+        {
+            threadPool = std::make_unique<ThreadPool>(Options::FsThreads());
+            dstLocks = std::make_unique<std::mutex[]>(NumDstLocks);
+        }
+        else
+            writeWrnMsg("-fs-threads requires -ptd=mutable, solving serially");
+    }
     //AndersenWaveDiff::releaseAndersenWaveDiff();
 }
 void FlowSensitive::solveConstraints()
@@ -91,7 +106,19 @@ void FlowSensitive::solveConstraints()
         callGraphSCC->find();
 
         initWorklist();
-        solveWorklist();
+
+        // The SVFG is only traversed while solving; it is frozen after the SCC
+        // detection of initWorklist, which walks the edge sets, and thawed again
+        // before updateCallGraph connects new callers and callees.
+        if (Options::CompactGraphs())
+            svfg->freeze();
+
+        if (threadPool)
+            solveInParallel();
+        else
+            solveWorklist();
+
+        svfg->thaw();
     }
     while (updateCallGraph(getIndirectCallsites()));
 
@@ -112,11 +139,16 @@ void FlowSensitive::solveAndwritePtsToFile(const std::string& filename)
 {
     /// Initialization for the Solver
     initialize();
-    if(!filename.empty())
+    if(!filename.empty() && !Options::WriteAnderBinary())
         writeObjVarToFile(filename);
     solveConstraints();
     if(!filename.empty())
-        writeToFile(filename);
+    {
+        if(Options::WriteAnderBinary())
+            writeToBinaryFile(filename);
+        else
+            writeToFile(filename);
+    }
     /// finalize the analysis
     finalize();
 }
@@ -199,6 +231,9 @@ void FlowSensitive::finalize()
         }
     }
 
+    if (threadPool && Options::FsThreadsCheck())
+        checkThreads();
+
     BVDataPTAImpl::finalize();
 }
 
@@ -214,6 +249,243 @@ NodeStack& FlowSensitive::SCCDetect()
     return nodeStack;
 }
 
+/*!
+ * Solve the initial worklist level by level of the SCC DAG of the SVFG,
+ * the SCCs of a level in parallel.
+ * Updating the call graph stays between the rounds of solveConstraints.
+ */
+void FlowSensitive::solveInParallel()
+{
+    prepareConcurrentSolving();
+
+    std::vector<std::vector<NodeID>> levels;
+    NodeBS serialReps;
+    computeSCCLevels(levels, serialReps);
+
+    // Visits are counted when the SCC tasks pop the nodes.
+    NodeBS pending;
+    while (!worklist.empty())
+        pending.set(worklist.pop());
+
+    std::vector<SCCTask> tasks;
+    std::vector<SCCTask*> parallelTasks;
+    for (const std::vector<NodeID>& level : levels)
+    {
+        tasks.clear();
+        tasks.reserve(level.size());
+        for (NodeID rep : level)
+        {
+            SCCTask* task = nullptr;
+            for (NodeID subNode : getSCCDetector()->subNodes(rep))
+            {
+                if (!pending.test(subNode))
+                    continue;
+                pending.reset(subNode);
+                if (task == nullptr)
+                {
+                    tasks.emplace_back();
+                    task = &tasks.back();
+                    task->rep = rep;
+                }
+                task->worklist.push(subNode);
+            }
+        }
+
+        parallelTasks.clear();
+        for (SCCTask& task : tasks)
+        {
+            if (!serialReps.test(task.rep))
+                parallelTasks.push_back(&task);
+        }
+        threadPool->parallelFor(parallelTasks.size(), [&](u32_t i, u32_t)
+        {
+            solveSCC(*parallelTasks[i]);
+        });
+
+        // Gep nodes may add field objects to the SVFIR, nothing else may run meanwhile.
+        u32_t numOfPAGNodes = pag->getTotalNodeNum();
+        for (SCCTask& task : tasks)
+        {
+            if (serialReps.test(task.rep))
+                solveSCC(task);
+        }
+        if (pag->getTotalNodeNum() != numOfPAGNodes)
+            prepareConcurrentSolving();
+
+        for (SCCTask& task : tasks)
+        {
+            numOfNodeVisits += task.visits;
+            for (NodeID id : task.deferred)
+                pending.set(id);
+        }
+    }
+
+    assert(pending.empty() && "nodes pushed to an SCC of a solved level?");
+}
+
+/*!
+ * Level of each SCC: 0 for the SCCs without predecessor, otherwise one more
+ * than the highest level of its predecessors.
+ * SCCs having a gep node are to be solved serially.
+ */
+void FlowSensitive::computeSCCLevels(std::vector<std::vector<NodeID>>& levels, NodeBS& serialReps)
+{
+    SCC* scc = getSCCDetector();
+    Map<NodeID, u32_t> repLevels;
+    NodeStack topoOrder = scc->topoNodeStack();
+    while (!topoOrder.empty())
+    {
+        NodeID rep = topoOrder.top();
+        topoOrder.pop();
+
+        u32_t level = repLevels[rep];
+        if (levels.size() <= level)
+            levels.resize(level + 1);
+        levels[level].push_back(rep);
+
+        for (NodeID subNode : scc->subNodes(rep))
+        {
+            const SVFGNode* node = svfg->getSVFGNode(subNode);
+            if (SVFUtil::isa<GepSVFGNode>(node))
+                serialReps.set(rep);
+
+            auto raiseDstLevel = [&](const SVFGEdge* edge)
+            {
+                NodeID dstRep = scc->repNode(edge->getDstID());
+                if (dstRep == rep)
+                    return;
+                u32_t& dstLevel = repLevels[dstRep];
+                dstLevel = std::max(dstLevel, level + 1);
+            };
+            // Walking the edge sets of a frozen SVFG would restore them.
+            if (node->isFrozen())
+            {
+                for (const SVFGEdge* edge : node->getFrozenOutEdges())
+                    raiseDstLevel(edge);
+            }
+            else
+            {
+                for (const SVFGEdge* edge : node->getOutEdges())
+                    raiseDstLevel(edge);
+            }
+        }
+    }
+}
+
+/*!
+ * Solve the constraints again serially and compare the top-level points-to sets
+ * of all SVFIR nodes and the IN/OUT sets of all SVFG nodes (-fs-threads-check)
+ */
+void FlowSensitive::checkThreads()
+{
+    FlowSensitive ref(pag);
+    ref.initialize();
+    ref.threadPool = nullptr;
+    ref.solveConstraints();
+
+    u32_t numOfDiffs = 0;
+    for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        NodeID id = it->first;
+        if (getPts(id) != ref.getPts(id))
+        {
+            SVFUtil::errs() << "fs threads check: points-to sets of node " << id << " differ\n";
+            numOfDiffs++;
+        }
+    }
+
+    // Parallel solving creates all entries up front (see prepareConcurrentSolving),
+    // so a missing entry stands for an empty set.
+    const PtsMap noPts;
+    auto locPts = [&noPts](const DFInOutMap& dfMap, NodeID loc) -> const PtsMap&
+    {
+        DFInOutMap::const_iterator it = dfMap.find(loc);
+        return it != dfMap.end() ? it->second : noPts;
+    };
+    auto samePts = [](const PtsMap& lhs, const PtsMap& rhs)
+    {
+        for (const auto& entry : lhs)
+        {
+            PtsMap::const_iterator it = rhs.find(entry.first);
+            if (it == rhs.end() ? !entry.second.empty() : it->second != entry.second)
+                return false;
+        }
+        for (const auto& entry : rhs)
+        {
+            if (!entry.second.empty() && lhs.find(entry.first) == lhs.end())
+                return false;
+        }
+        return true;
+    };
+
+    assert(svfg->getTotalNodeNum() == ref.svfg->getTotalNodeNum() && "SVFGs of the two runs differ!");
+    MutDFPTDataTy* dfData = getMutDFPTDataTy();
+    MutDFPTDataTy* refDFData = ref.getMutDFPTDataTy();
+    for (SVFG::iterator it = svfg->begin(), eit = svfg->end(); it != eit; ++it)
+    {
+        NodeID loc = it->first;
+        if (!samePts(locPts(dfData->getDFIn(), loc), locPts(refDFData->getDFIn(), loc))
+                || !samePts(locPts(dfData->getDFOut(), loc), locPts(refDFData->getDFOut(), loc)))
+        {
+            SVFUtil::errs() << "fs threads check: IN/OUT sets of SVFG node " << loc << " differ\n";
+            numOfDiffs++;
+        }
+    }
+
+    SVFUtil::outs() << "fs threads check: " << pag->getTotalNodeNum() << " nodes, "
+                    << svfg->getTotalNodeNum() << " SVFG nodes, "
+                    << numOfDiffs << " with different points-to sets\n";
+    assert(numOfDiffs == 0 && "parallel solving changed points-to sets!");
+}
+
+/*!
+ * Solve an SCC to its local fixpoint
+ */
+void FlowSensitive::solveSCC(SCCTask& task)
+{
+    curSCCTask = &task;
+    while (!task.worklist.empty())
+    {
+        NodeID nodeId = task.worklist.pop();
+        ++task.visits;
+        processNode(nodeId);
+    }
+    curSCCTask = nullptr;
+}
+
+/*!
+ * The points-to maps are hash maps: looking up a missing entry inserts it.
+ * Create all the entries up front so that SCCs solved concurrently never
+ * insert into a map another SCC is reading.
+ */
+void FlowSensitive::prepareConcurrentSolving()
+{
+    MutDFPTDataTy* dfData = getMutDFPTDataTy();
+    for (SVFG::iterator it = svfg->begin(), eit = svfg->end(); it != eit; ++it)
+        dfData->initLoc(it->first);
+
+    for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        getPts(it->first);
+        if (const BaseObjVar* obj = SVFUtil::dyn_cast<BaseObjVar>(it->second))
+            pag->getAllFieldsObjVars(obj);
+    }
+}
+
+/*!
+ * During parallel solving, nodes of the current SCC go into its own worklist
+ * and the others are deferred until their level.
+ */
+void FlowSensitive::pushIntoWorklist(NodeID id)
+{
+    if (curSCCTask == nullptr)
+        WPASVFGFSSolver::pushIntoWorklist(id);
+    else if (getSCCDetector()->repNode(id) == curSCCTask->rep)
+        curSCCTask->worklist.push(id);
+    else
+        curSCCTask->deferred.push_back(id);
+}
+
 /*!
  * Process each SVFG node
  */
@@ -226,6 +498,24 @@ void FlowSensitive::processNode(NodeID nodeId)
     clearAllDFOutVarFlag(node);
 }
 
+/*!
+ * Propagate to the successors of a node
+ */
+void FlowSensitive::propagate(SVFGNode** v)
+{
+    if (!(*v)->isFrozen())
+    {
+        WPASVFGFSSolver::propagate(v);
+        return;
+    }
+
+    for (SVFGEdge* edge : (*v)->getFrozenOutEdges())
+    {
+        if (propFromSrcToDst(edge))
+            pushIntoWorklist(edge->getDstID());
+    }
+}
+
 /*!
  * Process each SVFG node
  */
@@ -310,6 +600,11 @@ bool FlowSensitive::propFromSrcToDst(SVFGEdge* edge)
     double start = stat->getClk();
     bool changed = false;
 
+    // Other SCCs of the level may propagate into the same node.
+    std::unique_lock<std::mutex> dstGuard;
+    if (curSCCTask && getSCCDetector()->repNode(edge->getDstID()) != curSCCTask->rep)
+        dstGuard = std::unique_lock<std::mutex>(dstLocks[edge->getDstID() % NumDstLocks]);
+
     if (DirectSVFGEdge* dirEdge = SVFUtil::dyn_cast<DirectSVFGEdge>(edge))
         changed = propAlongDirectEdge(dirEdge);
     else if (IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge))
@@ -635,15 +930,22 @@ bool FlowSensitive::processStore(const StoreSVFGNode* store)
     /// check if this is a strong updates store
     NodeID singleton;
     bool isSU = isStrongUpdate(store, singleton);
+    {
+        std::unique_lock<std::mutex> suGuard;
+        if (curSCCTask)
+            suGuard = std::unique_lock<std::mutex>(suLock);
+        if (isSU)
+            svfgHasSU.set(store->getId());
+        else
+            svfgHasSU.reset(store->getId());
+    }
     if (isSU)
     {
-        svfgHasSU.set(store->getId());
         if (strongUpdateOutFromIn(store, singleton))
             changed = true;
     }
     else
     {
-        svfgHasSU.reset(store->getId());
         if (weakUpdateOutFromIn(store))
             changed = true;
     }
@@ -165,7 +165,12 @@ void FlowSensitiveStat::performStat()
     PTNumStatMap["CopysNum"] = numOfCopy;
     PTNumStatMap["StoresNum"] = numOfStore;
 
+    // Approximate SVFG edge memory (KB) before and at the end of the last freeze (-compact-graphs)
+    PTNumStatMap["EdgeKBBeforeFreeze"] = fspta->svfg->getEdgeMemBeforeFreeze() / 1024;
+    PTNumStatMap["EdgeKBAfterFreeze"] = fspta->svfg->getEdgeMemAfterFreeze() / 1024;
+
     PTNumStatMap["SolveIterations"] = fspta->numOfIteration;
+    PTNumStatMap["NodeVisits"] = fspta->numOfNodeVisits;
 
     PTNumStatMap["IndEdgeSolved"] = fspta->getNumOfResolvedIndCallEdge();
 
@@ -359,14 +364,20 @@ void FlowSensitiveStat::statPtsSize()
 
 void FlowSensitiveStat::statInOutPtsSize(const DFInOutMap& data, ENUM_INOUT inOrOut)
 {
-    // Get number of nodes which have IN/OUT set
-    _NumOfSVFGNodesHaveInOut[inOrOut] = data.size();
+    _NumOfSVFGNodesHaveInOut[inOrOut] = 0;
 
     u32_t inOutPtsSize = 0;
     DFInOutMap::const_iterator it = data.begin();
     DFInOutMap::const_iterator eit = data.end();
     for (; it != eit; ++it)
     {
+        // Parallel solving creates an (empty) entry for every node beforehand.
+        if (it->second.empty())
+            continue;
+
+        // Get number of nodes which have IN/OUT set
+        _NumOfSVFGNodesHaveInOut[inOrOut]++;
+
         const SVFGNode* node = fspta->svfg->getSVFGNode(it->first);
 
         // Count number of SVFG nodes have IN/OUT set.
@@ -41,6 +41,8 @@ Steensgaard* Steensgaard::steens = nullptr;
 
 void Steensgaard::solveWorklist()
 {
+    // Size the union-find arrays once for (nearly) all nodes instead of growing them.
+    reserveECs(consCG->getTotalNodeNum());
 
     processAllAddr();
 
@@ -79,21 +81,44 @@ void Steensgaard::solveWorklist()
     }
 }
 
+/*!
+ * Merge the EC of node into the EC of rep. The root of the merged tree is
+ * chosen by rank, but the merged EC keeps the ID of rep's EC.
+ */
 void Steensgaard::setEC(NodeID node, NodeID rep)
 {
-    rep = getEC(rep);
-    Set<NodeID>& subNodes = getSubNodes(node);
-    for (NodeID sub : subNodes)
-    {
-        nodeToECMap[sub] = rep;
-        addSubNode(rep, sub);
-    }
-    subNodes.clear();
+    NodeID nodeRoot = ecRoot(node);
+    NodeID repRoot = ecRoot(rep);
+    if (nodeRoot == repRoot)
+        return;
+
+    NodeID label = getEC(repRoot);
+    u8_t nodeRank = ecNodes.lookup(nodeRoot).rank;
+    u8_t repRank = ecNodes.lookup(repRoot).rank;
+    if (nodeRank > repRank)
+        std::swap(nodeRoot, repRoot);
+    else if (nodeRank == repRank)
+        ++ecNodes[repRoot].rank;
+
+    // Splice the two circular member lists.
+    NodeID nodeNext = ecNodes.lookup(nodeRoot).next;
+    NodeID repNext = ecNodes.lookup(repRoot).next;
+    ecNodes[nodeRoot].next = repNext != UINT_MAX ? repNext : repRoot;
+    ecNodes[repRoot].next = nodeNext != UINT_MAX ? nodeNext : nodeRoot;
+    ecNodes[nodeRoot].parent = repRoot;
+    ecNodes[repRoot].label = label;
+}
+
+void Steensgaard::reserveECs(size_t num)
+{
+    ecNodes.reserve(num);
 }
 
 /// merge node into equiv class and merge node's pts into ec's pts
 void Steensgaard::ecUnion(NodeID node, NodeID ec)
 {
+    if (getEC(node) == getEC(ec))
+        return;
     if (unionPts(ec, node))
         pushIntoWorklist(ec);
     setEC(node, ec);
@@ -11,9 +11,8 @@
 #include "WPA/VersionedFlowSensitive.h"
 #include "Util/Options.h"
 #include "MemoryModel/PointsTo.h"
+#include "Util/ThreadPool.h"
 #include <iostream>
-#include <queue>
-#include <thread>
 #include <mutex>
 
 using namespace SVF;
@@ -48,6 +47,7 @@ void VersionedFlowSensitive::initialize()
     // Overwrite the stat FlowSensitive::initialize gave us.
     delete stat;
     stat = new VersionedFlowSensitiveStat(this);
+    setWorklistPolicy(Options::VfsWorklist());
 
     vPtD = getVersionedPTDataTy();
 
@@ -157,267 +157,267 @@ void VersionedFlowSensitive::meldLabel(void)
         if (delta(n) || deltaSource(n) || isStore(n) || isLoad(n)) nodesWhichNeedVersions.push_back(n);
     }
 
-    std::mutex *versionMutexes = new std::mutex[nodesWhichNeedVersions.size()];
+    // Locks striped over nodesWhichNeedVersions, guarding their consume/yield maps.
+    static const u32_t NumVersionLocks = 1024;
+    std::unique_ptr<std::mutex[]> versionLocks = std::make_unique<std::mutex[]>(NumVersionLocks);
 
-    // Map of footprints to the canonical object "owning" the footprint.
-    Map<std::vector<const IndirectSVFGEdge *>, NodeID> footprintOwner;
+    // Map of footprints to the canonical object "owning" the footprint, sharded by
+    // the hash of the footprint so that workers rarely wait on each other.
+    typedef std::vector<const IndirectSVFGEdge *> Footprint;
+    struct FootprintShard
+    {
+        std::mutex lock;
+        Map<Footprint, NodeID> owner;
+    };
+    static const u32_t NumFootprintShards = 64;
+    std::unique_ptr<FootprintShard[]> footprintShards = std::make_unique<FootprintShard[]>(NumFootprintShards);
 
-    std::queue<NodeID> objectQueue;
+    std::vector<NodeID> objects;
     for (const NodeID o : prelabeledObjects)
     {
         // "Touch" maps with o so we don't need to lock on them.
         versionReliance[o];
         stmtReliance[o];
-        objectQueue.push(o);
+        equivalentObject[o] = o;
+        objects.push_back(o);
     }
 
-    std::mutex objectQueueMutex;
-    std::mutex footprintOwnerMutex;
-
-    auto meldVersionWorker = [this, &footprintOwner, &objectQueue,
-                                    &objectQueueMutex, &footprintOwnerMutex, &versionMutexes,
-                                    &prelabeledNodes, &isPrelabeled, &nodesWhichNeedVersions]
-         (const unsigned thread)
+    // Objects are taken from the per-worker ranges of the pool, which steal from each
+    // other once they run out.
+    ThreadPool pool(Options::VersioningThreads());
+    pool.parallelFor(objects.size(), [this, &objects, &footprintShards, &versionLocks,
+                                      &prelabeledNodes, &isPrelabeled, &nodesWhichNeedVersions]
+                     (const u32_t objectIdx, const u32_t)
     {
-        while (true)
+        const NodeID o = objects[objectIdx];
+
+        // 1. Compute the SCCs for the nodes on the graph overlay of o.
+        // For starting nodes, we only need those which did prelabeling for o specifically.
+        // TODO: maybe we should move this to prelabel with a map (o -> starting nodes).
+        std::vector<const SVFGNode *> osStartingNodes;
+        for (std::pair<const SVFGNode *, const PointsTo *> snPts : prelabeledNodes)
         {
-            NodeID o;
+            const SVFGNode *sn = snPts.first;
+            const PointsTo *pts = snPts.second;
+            if (pts != nullptr)
             {
-                std::lock_guard<std::mutex> guard(objectQueueMutex);
-                // No more objects? Done.
-                if (objectQueue.empty()) return;
-                o = objectQueue.front();
-                objectQueue.pop();
+                if (pts->test(o)) osStartingNodes.push_back(sn);
             }
-
-            // 1. Compute the SCCs for the nodes on the graph overlay of o.
-            // For starting nodes, we only need those which did prelabeling for o specifically.
-            // TODO: maybe we should move this to prelabel with a map (o -> starting nodes).
-            std::vector<const SVFGNode *> osStartingNodes;
-            for (std::pair<const SVFGNode *, const PointsTo *> snPts : prelabeledNodes)
+            else if (const MRSVFGNode *mr = SVFUtil::dyn_cast<MRSVFGNode>(sn))
             {
-                const SVFGNode *sn = snPts.first;
-                const PointsTo *pts = snPts.second;
-                if (pts != nullptr)
-                {
-                    if (pts->test(o)) osStartingNodes.push_back(sn);
-                }
-                else if (const MRSVFGNode *mr = SVFUtil::dyn_cast<MRSVFGNode>(sn))
-                {
-                    if (mr->getPointsTo().test(o)) osStartingNodes.push_back(sn);
-                }
-                else
-                {
-                    assert(false && "VFS::meldLabel: unexpected prelabeled node!");
-                }
+                if (mr->getPointsTo().test(o)) osStartingNodes.push_back(sn);
             }
-
-            std::vector<int> partOf;
-            std::vector<const IndirectSVFGEdge *> footprint;
-            unsigned numSCCs = SCC::detectSCCs(this, this->svfg, o, osStartingNodes, partOf, footprint);
-
-            // 2. Skip any further processing of a footprint we have seen before.
+            else
             {
-                std::lock_guard<std::mutex> guard(footprintOwnerMutex);
-                const Map<std::vector<const IndirectSVFGEdge *>, NodeID>::const_iterator canonOwner
-                    = footprintOwner.find(footprint);
-                if (canonOwner == footprintOwner.end())
-                {
-                    this->equivalentObject[o] = o;
-                    footprintOwner[footprint] = o;
-                }
-                else
-                {
-                    this->equivalentObject[o] = canonOwner->second;
-                    // Same version and stmt reliance as the canonical. During solving we cannot just reuse
-                    // the canonical object's reliance because it may change due to on-the-fly call graph
-                    // construction. Something like copy-on-write could be good... probably negligible.
-                    this->versionReliance.at(o) = this->versionReliance.at(canonOwner->second);
-                    this->stmtReliance.at(o) = this->stmtReliance.at(canonOwner->second);
-                    continue;
-                }
+                assert(false && "VFS::meldLabel: unexpected prelabeled node!");
             }
+        }
+
+        std::vector<int> partOf;
+        std::vector<const IndirectSVFGEdge *> footprint;
+        unsigned numSCCs = SCC::detectSCCs(this, this->svfg, o, osStartingNodes, partOf, footprint);
 
-            // 3. a. Initialise the MeldVersion of prelabeled nodes (SCCs).
-            //    b. Initialise a todo list of all the nodes we need to version,
-            //       sorted according to topological order.
-            // We will use a map of sccs to meld versions for what is consumed.
-            std::vector<MeldVersion> sccToMeldVersion(numSCCs);
-            // At stores, what is consumed is different to what is yielded, so we
-            // maintain that separately.
-            Map<NodeID, MeldVersion> storesYieldedMeldVersion;
-            // SVFG nodes of interest -- those part of an SCC from the starting nodes.
-            std::vector<NodeID> todoList;
-            unsigned bit = 0;
-            // To calculate reachable nodes, we can see what nodes n exist where
-            // partOf[n] != -1. Since the SVFG can be large this can be expensive.
-            // Instead, we can gather this from the edges in the footprint and
-            // the starting nodes (incase such nodes have no edges).
-            // TODO: should be able to do this better: too many redundant inserts.
-            Set<NodeID> reachableNodes;
-            for (const SVFGNode *sn : osStartingNodes) reachableNodes.insert(sn->getId());
-            for (const SVFGEdge *se : footprint)
+        // 2. Skip any further processing of a footprint we have seen before.
+        //    The reliances of such objects are copied once all canonical objects are done.
+        {
+            FootprintShard &shard = footprintShards[std::hash<Footprint>()(footprint) % NumFootprintShards];
+            std::lock_guard<std::mutex> guard(shard.lock);
+            const std::pair<Map<Footprint, NodeID>::const_iterator, bool> canonOwner
+                = shard.owner.emplace(footprint, o);
+            if (!canonOwner.second)
             {
-                reachableNodes.insert(se->getSrcNode()->getId());
-                reachableNodes.insert(se->getDstNode()->getId());
+                this->equivalentObject.at(o) = canonOwner.first->second;
+                return;
             }
+        }
 
-            for (const NodeID n : reachableNodes)
-            {
-                if (isPrelabeled[n])
-                {
-                    if (this->isStore(n)) storesYieldedMeldVersion[n].set(bit);
-                    else sccToMeldVersion[partOf[n]].set(bit);
-                    ++bit;
-                }
+        // 3. a. Initialise the MeldVersion of prelabeled nodes (SCCs).
+        //    b. Initialise a todo list of all the nodes we need to version,
+        //       sorted according to topological order.
+        // We will use a map of sccs to meld versions for what is consumed.
+        std::vector<MeldVersion> sccToMeldVersion(numSCCs);
+        // At stores, what is consumed is different to what is yielded, so we
+        // maintain that separately.
+        Map<NodeID, MeldVersion> storesYieldedMeldVersion;
+        // SVFG nodes of interest -- those part of an SCC from the starting nodes.
+        std::vector<NodeID> todoList;
+        unsigned bit = 0;
+        // To calculate reachable nodes, we can see what nodes n exist where
+        // partOf[n] != -1. Since the SVFG can be large this can be expensive.
+        // Instead, we can gather this from the edges in the footprint and
+        // the starting nodes (incase such nodes have no edges).
+        // TODO: should be able to do this better: too many redundant inserts.
+        Set<NodeID> reachableNodes;
+        for (const SVFGNode *sn : osStartingNodes) reachableNodes.insert(sn->getId());
+        for (const SVFGEdge *se : footprint)
+        {
+            reachableNodes.insert(se->getSrcNode()->getId());
+            reachableNodes.insert(se->getDstNode()->getId());
+        }
 
-                todoList.push_back(n);
+        for (const NodeID n : reachableNodes)
+        {
+            if (isPrelabeled[n])
+            {
+                if (this->isStore(n)) storesYieldedMeldVersion[n].set(bit);
+                else sccToMeldVersion[partOf[n]].set(bit);
+                ++bit;
             }
 
-            // Sort topologically so each nodes is only visited once.
-            auto cmp = [&partOf](const NodeID a, const NodeID b)
-            {
-                return partOf[a] > partOf[b];
-            };
-            std::sort(todoList.begin(), todoList.end(), cmp);
-
-            // 4. a. Do meld versioning.
-            //    b. Determine SCC reliances.
-            //    c. Build a footprint for o (all edges which it is found on).
-            //    d. Determine which SCCs belong to stores.
-
-            // sccReliance[x] = { y_1, y_2, ... } if there exists an edge from a node
-            // in SCC x to SCC y_i.
-            std::vector<Set<int>> sccReliance(numSCCs);
-            // Maps SCC to the store it corresponds to or -1 if it doesn't. TODO: unsigned vs signed -- nasty.
-            std::vector<int> storeSCC(numSCCs, -1);
-            for (size_t i = 0; i < todoList.size(); ++i)
+            todoList.push_back(n);
+        }
+
+        // Sort topologically so each nodes is only visited once.
+        auto cmp = [&partOf](const NodeID a, const NodeID b)
+        {
+            return partOf[a] > partOf[b];
+        };
+        std::sort(todoList.begin(), todoList.end(), cmp);
+
+        // 4. a. Do meld versioning.
+        //    b. Determine SCC reliances.
+        //    c. Build a footprint for o (all edges which it is found on).
+        //    d. Determine which SCCs belong to stores.
+
+        // sccReliance[x] = { y_1, y_2, ... } if there exists an edge from a node
+        // in SCC x to SCC y_i.
+        std::vector<Set<int>> sccReliance(numSCCs);
+        // Maps SCC to the store it corresponds to or -1 if it doesn't. TODO: unsigned vs signed -- nasty.
+        std::vector<int> storeSCC(numSCCs, -1);
+        for (size_t i = 0; i < todoList.size(); ++i)
+        {
+            const NodeID n = todoList[i];
+            const SVFGNode *sn = this->svfg->getSVFGNode(n);
+            const bool nIsStore = this->isStore(n);
+
+            int nSCC = partOf[n];
+            if (nIsStore) storeSCC[nSCC] = n;
+
+            // Given n -> m, the yielded version of n will be melded into m.
+            // For stores, that is in storesYieldedMeldVersion, otherwise, consume == yield and
+            // we can just use sccToMeldVersion.
+            const MeldVersion &nMV = nIsStore ? storesYieldedMeldVersion[n] : sccToMeldVersion[nSCC];
+            for (const SVFGEdge *e : sn->getOutEdges())
             {
-                const NodeID n = todoList[i];
-                const SVFGNode *sn = this->svfg->getSVFGNode(n);
-                const bool nIsStore = this->isStore(n);
-
-                int nSCC = partOf[n];
-                if (nIsStore) storeSCC[nSCC] = n;
-
-                // Given n -> m, the yielded version of n will be melded into m.
-                // For stores, that is in storesYieldedMeldVersion, otherwise, consume == yield and
-                // we can just use sccToMeldVersion.
-                const MeldVersion &nMV = nIsStore ? storesYieldedMeldVersion[n] : sccToMeldVersion[nSCC];
-                for (const SVFGEdge *e : sn->getOutEdges())
-                {
-                    const IndirectSVFGEdge *ie = SVFUtil::dyn_cast<IndirectSVFGEdge>(e);
-                    if (!ie) continue;
+                const IndirectSVFGEdge *ie = SVFUtil::dyn_cast<IndirectSVFGEdge>(e);
+                if (!ie) continue;
 
-                    const NodeID m = ie->getDstNode()->getId();
-                    // Ignoreedges which don't involve o.
-                    if (!ie->getPointsTo().test(o)) continue;
+                const NodeID m = ie->getDstNode()->getId();
+                // Ignoreedges which don't involve o.
+                if (!ie->getPointsTo().test(o)) continue;
 
-                    int mSCC = partOf[m];
+                int mSCC = partOf[m];
 
-                    // There is an edge from the SCC n belongs to that m belongs to.
-                    sccReliance[nSCC].insert(mSCC);
+                // There is an edge from the SCC n belongs to that m belongs to.
+                sccReliance[nSCC].insert(mSCC);
 
-                    // Ignore edges to delta nodes (prelabeled consume).
-                    // No point propagating when n's SCC == m's SCC (same meld version there)
-                    // except when it is a store, because we are actually propagating n's yielded
-                    // into m's consumed. Store nodes are in their own SCCs, so it is a self
-                    // loop on a store node.
-                    if (!this->delta(m) && (nSCC != mSCC || nIsStore))
-                    {
-                        sccToMeldVersion[mSCC] |= nMV;
-                    }
+                // Ignore edges to delta nodes (prelabeled consume).
+                // No point propagating when n's SCC == m's SCC (same meld version there)
+                // except when it is a store, because we are actually propagating n's yielded
+                // into m's consumed. Store nodes are in their own SCCs, so it is a self
+                // loop on a store node.
+                if (!this->delta(m) && (nSCC != mSCC || nIsStore))
+                {
+                    sccToMeldVersion[mSCC] |= nMV;
                 }
             }
+        }
 
-            // 5. Transform meld versions belonging to SCCs into versions.
-            Map<MeldVersion, Version> mvv;
-            std::vector<Version> sccToVersion(numSCCs, invalidVersion);
-            Version curVersion = 0;
-            for (u32_t scc = 0; scc < sccToMeldVersion.size(); ++scc)
-            {
-                const MeldVersion &mv = sccToMeldVersion[scc];
-                Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
-                Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
-                sccToVersion[scc] = v;
-            }
+        // 5. Transform meld versions belonging to SCCs into versions.
+        Map<MeldVersion, Version> mvv;
+        std::vector<Version> sccToVersion(numSCCs, invalidVersion);
+        Version curVersion = 0;
+        for (u32_t scc = 0; scc < sccToMeldVersion.size(); ++scc)
+        {
+            const MeldVersion &mv = sccToMeldVersion[scc];
+            Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
+            Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
+            sccToVersion[scc] = v;
+        }
 
-            sccToMeldVersion.clear();
+        sccToMeldVersion.clear();
 
-            // Same for storesYieldedMeldVersion.
-            Map<NodeID, Version> storesYieldedVersion;
-            for (auto const& nmv : storesYieldedMeldVersion)
-            {
-                const NodeID n = nmv.first;
-                const MeldVersion &mv = nmv.second;
+        // Same for storesYieldedMeldVersion.
+        Map<NodeID, Version> storesYieldedVersion;
+        for (auto const& nmv : storesYieldedMeldVersion)
+        {
+            const NodeID n = nmv.first;
+            const MeldVersion &mv = nmv.second;
 
-                Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
-                Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
-                storesYieldedVersion[n] = v;
-            }
+            Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
+            Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
+            storesYieldedVersion[n] = v;
+        }
 
-            storesYieldedMeldVersion.clear();
+        storesYieldedMeldVersion.clear();
 
-            mvv.clear();
+        mvv.clear();
 
-            // 6. From SCC reliance, determine version reliances.
-            Map<Version, std::vector<Version>> &osVersionReliance = this->versionReliance.at(o);
-            for (u32_t scc = 0; scc < numSCCs; ++scc)
-            {
-                if (sccReliance[scc].empty()) continue;
+        // 6. From SCC reliance, determine version reliances.
+        Map<Version, std::vector<Version>> &osVersionReliance = this->versionReliance.at(o);
+        for (u32_t scc = 0; scc < numSCCs; ++scc)
+        {
+            if (sccReliance[scc].empty()) continue;
 
-                // Some consume relies on a yield. When it's a store, we need to pick whether to
-                // use the consume or yield unlike when it is not because they are the same.
-                const Version version
-                    = storeSCC[scc] != -1 ? storesYieldedVersion[storeSCC[scc]] : sccToVersion[scc];
+            // Some consume relies on a yield. When it's a store, we need to pick whether to
+            // use the consume or yield unlike when it is not because they are the same.
+            const Version version
+                = storeSCC[scc] != -1 ? storesYieldedVersion[storeSCC[scc]] : sccToVersion[scc];
 
-                std::vector<Version> &reliantVersions = osVersionReliance[version];
-                for (const int reliantSCC : sccReliance[scc])
+            std::vector<Version> &reliantVersions = osVersionReliance[version];
+            for (const int reliantSCC : sccReliance[scc])
+            {
+                const Version reliantVersion = sccToVersion[reliantSCC];
+                if (version != reliantVersion)
                 {
-                    const Version reliantVersion = sccToVersion[reliantSCC];
-                    if (version != reliantVersion)
-                    {
-                        // sccReliance is a set, no need to worry about duplicates.
-                        reliantVersions.push_back(reliantVersion);
-                    }
+                    // sccReliance is a set, no need to worry about duplicates.
+                    reliantVersions.push_back(reliantVersion);
                 }
             }
+        }
 
-            // 7. a. Save versions for nodes which need them.
-            //    b. Fill in stmtReliance.
-            // TODO: maybe randomize iteration order for less contention? Needs profiling.
-            Map<Version, NodeBS> &osStmtReliance = this->stmtReliance.at(o);
-            for (size_t i = 0; i < nodesWhichNeedVersions.size(); ++i)
-            {
-                const NodeID n = nodesWhichNeedVersions[i];
-                std::mutex &mutex = versionMutexes[i];
+        // 7. a. Save versions for nodes which need them.
+        //    b. Fill in stmtReliance.
+        // Each object starts at a different node so workers do not queue on the same locks.
+        Map<Version, NodeBS> &osStmtReliance = this->stmtReliance.at(o);
+        const size_t numNodes = nodesWhichNeedVersions.size();
+        const size_t firstNode = numNodes == 0 ? 0 : (u64_t)objectIdx * numNodes / objects.size();
+        for (size_t j = 0; j < numNodes; ++j)
+        {
+            const size_t i = (firstNode + j) % numNodes;
+            const NodeID n = nodesWhichNeedVersions[i];
 
-                const int scc = partOf[n];
-                if (scc == -1) continue;
+            const int scc = partOf[n];
+            if (scc == -1) continue;
 
-                std::lock_guard<std::mutex> guard(mutex);
+            std::lock_guard<std::mutex> guard(versionLocks[i % NumVersionLocks]);
 
-                const Version c = sccToVersion[scc];
-                if (c != invalidVersion)
-                {
-                    this->setConsume(n, o, c);
-                    if (this->isStore(n) || this->isLoad(n)) osStmtReliance[c].set(n);
-                }
+            const Version c = sccToVersion[scc];
+            if (c != invalidVersion)
+            {
+                this->setConsume(n, o, c);
+                if (this->isStore(n) || this->isLoad(n)) osStmtReliance[c].set(n);
+            }
 
-                if (this->isStore(n))
-                {
-                    const Map<NodeID, Version>::const_iterator yIt = storesYieldedVersion.find(n);
-                    if (yIt != storesYieldedVersion.end()) this->setYield(n, o, yIt->second);
-                }
+            if (this->isStore(n))
+            {
+                const Map<NodeID, Version>::const_iterator yIt = storesYieldedVersion.find(n);
+                if (yIt != storesYieldedVersion.end()) this->setYield(n, o, yIt->second);
             }
         }
-    };
+    });
 
-    std::vector<std::thread> workers;
-    for (unsigned i = 0; i < Options::VersioningThreads(); ++i) workers.push_back(std::thread(meldVersionWorker, i));
-    for (std::thread &worker : workers) worker.join();
-
-    delete[] versionMutexes;
+    // Same version and stmt reliance as the canonical. During solving we cannot just reuse
+    // the canonical object's reliance because it may change due to on-the-fly call graph
+    // construction. Something like copy-on-write could be good... probably negligible.
+    pool.parallelFor(objects.size(), [this, &objects](const u32_t objectIdx, const u32_t)
+    {
+        const NodeID o = objects[objectIdx];
+        const NodeID canon = this->equivalentObject.at(o);
+        if (canon == o) return;
+        this->versionReliance.at(o) = this->versionReliance.at(canon);
+        this->stmtReliance.at(o) = this->stmtReliance.at(canon);
+    });
 
     double end = stat->getClk(true);
     meldLabelingTime = (end - start) / TIMEINTERVAL;
@@ -563,7 +563,7 @@ void VersionedFlowSensitive::propagateVersion(const NodeID o, const Version v, c
 
     const VersionedVar srcVar = atKey(o, v);
     const VersionedVar dstVar = atKey(o, vp);
-    if (vPtD->unionPts(dstVar, srcVar))
+    if (recordUnion(vPtD->unionPts(dstVar, srcVar)))
     {
         // o:vp has changed.
         // Add the dummy propagation node to tell the solver to propagate it later.
@@ -664,7 +664,7 @@ bool VersionedFlowSensitive::processLoad(const LoadSVFGNode* load)
             if (pag->isConstantObj(o)) continue;
 
             const Version c = getConsume(l, o);
-            if (c != invalidVersion && vPtD->unionPts(p, atKey(o, c)))
+            if (c != invalidVersion && recordUnion(vPtD->unionPts(p, atKey(o, c))))
             {
                 changed = true;
             }
@@ -677,7 +677,7 @@ bool VersionedFlowSensitive::processLoad(const LoadSVFGNode* load)
                 for (NodeID of : fields)
                 {
                     const Version c = getConsume(l, of);
-                    if (c != invalidVersion && vPtD->unionPts(p, atKey(of, c)))
+                    if (c != invalidVersion && recordUnion(vPtD->unionPts(p, atKey(of, c))))
                     {
                         changed = true;
                     }
@@ -718,7 +718,7 @@ bool VersionedFlowSensitive::processStore(const StoreSVFGNode* store)
                 if (pag->isConstantObj(o)) continue;
 
                 const Version y = getYield(l, o);
-                if (y != invalidVersion && vPtD->unionPts(atKey(o, y), q))
+                if (y != invalidVersion && recordUnion(vPtD->unionPts(atKey(o, y), q)))
                 {
                     changed = true;
                     changedObjects.set(o);
@@ -748,7 +748,7 @@ bool VersionedFlowSensitive::processStore(const StoreSVFGNode* store)
         if (isSU && o == singleton) continue;
 
         const Version y = getYield(l, o);
-        if (y != invalidVersion && vPtD->unionPts(atKey(o, y), atKey(o, c)))
+        if (y != invalidVersion && recordUnion(vPtD->unionPts(atKey(o, y), atKey(o, c))))
         {
             changed = true;
             changedObjects.set(o);
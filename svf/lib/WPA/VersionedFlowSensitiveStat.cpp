@@ -117,6 +117,7 @@ void VersionedFlowSensitiveStat::performStat()
     PTNumStatMap["StoresNum"] = numOfStore;
 
     PTNumStatMap["SolveIterations"] = vfspta->numOfIteration;
+    PTNumStatMap["NodeVisits"] = vfspta->numOfNodeVisits;
 
     PTNumStatMap["IndEdgeSolved"] = vfspta->getNumOfResolvedIndCallEdge();
 